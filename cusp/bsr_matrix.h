@@ -0,0 +1,529 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file bsr_matrix.h
+ *  \brief Block compressed sparse row matrix format.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/memory.h>
+
+#include <cusp/detail/format.h>
+#include <cusp/detail/matrix_base.h>
+#include <cusp/detail/type_traits.h>
+
+namespace cusp
+{
+
+/*! \cond */
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3, typename IndexType, typename ValueType, typename MemorySpace> class bsr_matrix_view;
+/*! \endcond */
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Block compressed sparse row (BSR) representation of a sparse matrix
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * A \p bsr_matrix partitions the matrix into dense square blocks of
+ * dimension \c block_size and stores the nonzero blocks in CSR order.
+ * The \c row_offsets and \c column_indices arrays refer to block rows and
+ * block columns respectively, so only one column index is stored per block
+ * rather than per scalar entry. The entries of each block are stored
+ * contiguously in row-major order, i.e. entry <tt>(r,c)</tt> of block \c n
+ * is located at <tt>values[(n * block_size + r) * block_size + c]</tt>.
+ *
+ * \note The number of rows and columns must be divisible by \c block_size.
+ * \note The blocks within the same block row must be sorted by block column index.
+ * \note The matrix should not contain duplicate blocks.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to create a 4-by-4
+ *  \p bsr_matrix on the host with 2-by-2 blocks (3 blocks, 10 nonzeros)
+ *  and then copies the matrix to the device.
+ *
+ *  \code
+ *  // include the bsr_matrix header file
+ *  #include <cusp/bsr_matrix.h>
+ *  #include <cusp/print.h>
+ *
+ *  int main()
+ *  {
+ *    // allocate storage for (4,4) matrix with 10 nonzeros in 3 blocks of size 2
+ *    cusp::bsr_matrix<int,float,cusp::host_memory> A(4,4,10,3,2);
+ *
+ *    // initialize block structure
+ *    A.row_offsets[0] = 0;  // first offset is always zero
+ *    A.row_offsets[1] = 2;
+ *    A.row_offsets[2] = 3;  // last offset is always num_blocks
+ *
+ *    A.column_indices[0] = 0;
+ *    A.column_indices[1] = 1;
+ *    A.column_indices[2] = 1;
+ *
+ *    // initialize block entries (row-major within each block)
+ *    A.values[ 0] = 10; A.values[ 1] = 20; A.values[ 2] = 30; A.values[ 3] = 40;
+ *    A.values[ 4] = 50; A.values[ 5] =  0; A.values[ 6] = 60; A.values[ 7] =  0;
+ *    A.values[ 8] = 70; A.values[ 9] = 80; A.values[10] = 90; A.values[11] = 99;
+ *
+ *    // A now represents the following matrix
+ *    //    [10 20 50  0]
+ *    //    [30 40 60  0]
+ *    //    [ 0  0 70 80]
+ *    //    [ 0  0 90 99]
+ *
+ *    // copy to the device
+ *    cusp::bsr_matrix<int,float,cusp::device_memory> B(A);
+ *
+ *    cusp::print(B);
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+class bsr_matrix : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::bsr_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::bsr_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef typename cusp::array1d<IndexType, MemorySpace> row_offsets_array_type;
+    typedef typename cusp::array1d<IndexType, MemorySpace> column_indices_array_type;
+    typedef typename cusp::array1d<ValueType, MemorySpace> values_array_type;
+
+    typedef typename cusp::bsr_matrix<IndexType, ValueType, MemorySpace> container;
+
+    typedef typename cusp::bsr_matrix_view<typename row_offsets_array_type::view,
+            typename column_indices_array_type::view,
+            typename values_array_type::view,
+            IndexType, ValueType, MemorySpace> view;
+
+    typedef typename cusp::bsr_matrix_view<typename row_offsets_array_type::const_view,
+            typename column_indices_array_type::const_view,
+            typename values_array_type::const_view,
+            IndexType, ValueType, MemorySpace> const_view;
+
+    template<typename MemorySpace2>
+    struct rebind
+    {
+        typedef cusp::bsr_matrix<IndexType, ValueType, MemorySpace2> type;
+    };
+    /*! \endcond */
+
+    /*! Storage for the block row offsets of the BSR data structure.
+     */
+    row_offsets_array_type row_offsets;
+
+    /*! Storage for the block column indices of the BSR data structure.
+     */
+    column_indices_array_type column_indices;
+
+    /*! Storage for the dense blocks of the BSR data structure.
+     */
+    values_array_type values;
+
+    /*! Number of rows (and columns) in each dense block.
+     */
+    size_t block_size;
+
+    /*! Construct an empty \p bsr_matrix.
+     */
+    bsr_matrix(void) : block_size(0) {}
+
+    /*! Construct a \p bsr_matrix with a specific shape, number of nonzero
+     *  entries, number of blocks and block size.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_blocks Number of stored dense blocks.
+     *  \param block_size Number of rows (and columns) in each block.
+     */
+    bsr_matrix(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+               const size_t num_blocks, const size_t block_size);
+
+    /*! Construct a \p bsr_matrix from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  bsr_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    bsr_matrix(const MatrixType& matrix);
+
+    /*! Construct a \p bsr_matrix with a given block size from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  bsr_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     *  \param block_size Number of rows (and columns) in each block.
+     */
+    template <typename MatrixType>
+    bsr_matrix(const MatrixType& matrix, const size_t block_size);
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_blocks Number of stored dense blocks.
+     *  \param block_size Number of rows (and columns) in each block.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_blocks, const size_t block_size);
+
+    /*! Swap the contents of two \p bsr_matrix objects.
+     *
+     *  \param matrix Another \p bsr_matrix with the same IndexType and ValueType.
+     */
+    void swap(bsr_matrix& matrix);
+
+    /*! Assignment from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix to copy into this \p
+     *  bsr_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    bsr_matrix& operator=(const MatrixType& matrix);
+
+}; // class bsr_matrix
+/*! \}
+ */
+
+/*! \addtogroup sparse_matrix_views Sparse Matrix Views
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief View of a \p bsr_matrix
+ *
+ * \tparam ArrayType1 Type of \c row_offsets array view
+ * \tparam ArrayType2 Type of \c column_indices array view
+ * \tparam ArrayType3 Type of \c values array view
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * \note The number of rows and columns must be divisible by \c block_size.
+ * \note The blocks within the same block row must be sorted by block column index.
+ * \note The matrix should not contain duplicate blocks.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to create a 4-by-4
+ *  \p bsr_matrix_view on the host with 2-by-2 blocks.
+ *
+ *  \code
+ *  // include the bsr_matrix header file
+ *  #include <cusp/bsr_matrix.h>
+ *  #include <cusp/print.h>
+ *
+ *  int main()
+ *  {
+ *    typedef cusp::array1d<int,cusp::host_memory> IndexArray;
+ *    typedef cusp::array1d<float,cusp::host_memory> ValueArray;
+ *
+ *    typedef typename IndexArray::view IndexArrayView;
+ *    typedef typename ValueArray::view ValueArrayView;
+ *
+ *    // initialize rows, columns, and values
+ *    IndexArray row_offsets(3);
+ *    IndexArray column_indices(2);
+ *    ValueArray values(8);
+ *
+ *    row_offsets[0] = 0; row_offsets[1] = 1; row_offsets[2] = 2;
+ *    column_indices[0] = 0; column_indices[1] = 1;
+ *
+ *    values[0] = 10; values[1] = 20; values[2] = 30; values[3] = 40;
+ *    values[4] = 50; values[5] = 60; values[6] = 70; values[7] = 80;
+ *
+ *    // create a view of the (4,4) matrix with 8 nonzeros in 2-by-2 blocks
+ *    cusp::bsr_matrix_view<IndexArrayView,IndexArrayView,ValueArrayView>
+ *        A(4, 4, 8, 2,
+ *          cusp::make_array1d_view(row_offsets),
+ *          cusp::make_array1d_view(column_indices),
+ *          cusp::make_array1d_view(values));
+ *
+ *    // A now represents the following matrix
+ *    //    [10 20  0  0]
+ *    //    [30 40  0  0]
+ *    //    [ 0  0 50 60]
+ *    //    [ 0  0 70 80]
+ *
+ *    // print the constructed bsr_matrix
+ *    cusp::print(A);
+ *
+ *    // change first entry in values array
+ *    values[0] = -1;
+ *
+ *    // print the updated matrix view
+ *    cusp::print(A);
+ *  }
+ *  \endcode
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename IndexType   = typename ArrayType1::value_type,
+          typename ValueType   = typename ArrayType3::value_type,
+          typename MemorySpace = typename cusp::minimum_space<
+                                    typename ArrayType1::memory_space,
+                                    typename ArrayType2::memory_space,
+                                    typename ArrayType3::memory_space>::type >
+class bsr_matrix_view : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::bsr_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::bsr_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef ArrayType1 row_offsets_array_type;
+    typedef ArrayType2 column_indices_array_type;
+    typedef ArrayType3 values_array_type;
+
+    typedef typename cusp::bsr_matrix<IndexType, ValueType, MemorySpace> container;
+    typedef typename cusp::bsr_matrix_view<ArrayType1, ArrayType2, ArrayType3, IndexType, ValueType, MemorySpace> view;
+    typedef typename cusp::bsr_matrix_view<ArrayType1, ArrayType2, ArrayType3, IndexType, ValueType, MemorySpace> const_view;
+    /*! \endcond */
+
+    /**
+     * View of the block row offsets of the BSR data structure.
+     */
+    row_offsets_array_type row_offsets;
+
+    /**
+     * View of the block column indices of the BSR data structure.
+     */
+    column_indices_array_type column_indices;
+
+    /**
+     * View of the dense blocks of the BSR data structure.
+     */
+    values_array_type values;
+
+    /**
+     * Number of rows (and columns) in each dense block.
+     */
+    size_t block_size;
+
+    /**
+     * Construct an empty \p bsr_matrix_view.
+     */
+    bsr_matrix_view(void)
+        : Parent(), block_size(0) {}
+
+    /*! Construct a \p bsr_matrix_view with a specific shape, number of nonzero
+     *  entries and block size from existing arrays denoting the block row
+     *  offsets, block column indices, and block values.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param block_size Number of rows (and columns) in each block.
+     *  \param row_offsets Array containing the block row offsets.
+     *  \param column_indices Array containing the block column indices.
+     *  \param values Array containing the block values.
+     */
+    bsr_matrix_view(const size_t num_rows,
+                    const size_t num_cols,
+                    const size_t num_entries,
+                    const size_t block_size,
+                    ArrayType1 row_offsets,
+                    ArrayType2 column_indices,
+                    ArrayType3 values)
+        : Parent(num_rows, num_cols, num_entries),
+          row_offsets(row_offsets),
+          column_indices(column_indices),
+          values(values),
+          block_size(block_size) {}
+
+    /*! Construct a \p bsr_matrix_view from a existing \p bsr_matrix.
+     *
+     *  \param matrix \p bsr_matrix used to create view.
+     */
+    bsr_matrix_view(bsr_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          row_offsets(matrix.row_offsets),
+          column_indices(matrix.column_indices),
+          values(matrix.values),
+          block_size(matrix.block_size) {}
+
+    /*! Construct a \p bsr_matrix_view from a existing const \p bsr_matrix.
+     *
+     *  \param matrix \p bsr_matrix used to create view.
+     */
+    bsr_matrix_view(const bsr_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          row_offsets(matrix.row_offsets),
+          column_indices(matrix.column_indices),
+          values(matrix.values),
+          block_size(matrix.block_size) {}
+
+    /*! Construct a \p bsr_matrix_view from a existing \p bsr_matrix_view.
+     *
+     *  \param matrix \p bsr_matrix_view used to create view.
+     */
+    bsr_matrix_view(bsr_matrix_view& matrix)
+        : Parent(matrix),
+          row_offsets(matrix.row_offsets),
+          column_indices(matrix.column_indices),
+          values(matrix.values),
+          block_size(matrix.block_size) {}
+
+    /*! Construct a \p bsr_matrix_view from a existing const \p bsr_matrix_view.
+     *
+     *  \param matrix \p bsr_matrix_view used to create view.
+     */
+    bsr_matrix_view(const bsr_matrix_view& matrix)
+        : Parent(matrix),
+          row_offsets(matrix.row_offsets),
+          column_indices(matrix.column_indices),
+          values(matrix.values),
+          block_size(matrix.block_size) {}
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_blocks Number of stored dense blocks.
+     *  \param block_size Number of rows (and columns) in each block.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_blocks, const size_t block_size);
+}; // class bsr_matrix_view
+
+/**
+ *  This is a convenience function for generating a \p bsr_matrix_view
+ *  using individual arrays
+ *  \tparam ArrayType1 row offsets array type
+ *  \tparam ArrayType2 column indices array type
+ *  \tparam ArrayType3 values array type
+ *
+ *  \param num_rows Number of rows.
+ *  \param num_cols Number of columns.
+ *  \param num_entries Number of nonzero matrix entries.
+ *  \param block_size Number of rows (and columns) in each block.
+ *  \param row_offsets Array containing the block row offsets.
+ *  \param column_indices Array containing the block column indices.
+ *  \param values Array containing the block values.
+ *
+ *  \return \p bsr_matrix_view constructed using input arrays
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3>
+bsr_matrix_view<ArrayType1,ArrayType2,ArrayType3>
+make_bsr_matrix_view(size_t num_rows,
+                     size_t num_cols,
+                     size_t num_entries,
+                     size_t block_size,
+                     ArrayType1 row_offsets,
+                     ArrayType2 column_indices,
+                     ArrayType3 values)
+{
+    bsr_matrix_view<ArrayType1,ArrayType2,ArrayType3>
+           view(num_rows, num_cols, num_entries, block_size, row_offsets, column_indices, values);
+
+    return view;
+}
+
+/**
+ *  This is a convenience function for generating a \p bsr_matrix_view
+ *  using an existing \p bsr_matrix_view.
+ *
+ *  \param m Exemplar \p bsr_matrix_view matrix to copy.
+ *
+ *  \return \p bsr_matrix_view constructed using input matrix.
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename IndexType,
+          typename ValueType,
+          typename MemorySpace>
+bsr_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>
+make_bsr_matrix_view(const bsr_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>& m)
+{
+    return bsr_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>(m);
+}
+
+/**
+ *  This is a convenience function for generating a \p bsr_matrix_view
+ *  using an existing \p bsr_matrix.
+ *
+ *  \param m Exemplar \p bsr_matrix matrix to copy.
+ *
+ *  \return \p bsr_matrix_view constructed using input matrix.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename bsr_matrix<IndexType,ValueType,MemorySpace>::view
+make_bsr_matrix_view(bsr_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_bsr_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries, m.block_size,
+            make_array1d_view(m.row_offsets),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.values));
+}
+
+/**
+ *  This is a convenience function for generating a const \p bsr_matrix_view
+ *  using an existing \p bsr_matrix.
+ *
+ *  \param m Exemplar \p bsr_matrix matrix to copy.
+ *
+ *  \return \p bsr_matrix_view constructed using input matrix.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename bsr_matrix<IndexType,ValueType,MemorySpace>::const_view
+make_bsr_matrix_view(const bsr_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_bsr_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries, m.block_size,
+            make_array1d_view(m.row_offsets),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.values));
+}
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/bsr_matrix.inl>
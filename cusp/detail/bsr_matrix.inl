@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/format_utils.h>
+
+namespace cusp
+{
+
+// Forward definitions
+template <typename T1, typename T2> void convert(const T1&, T2&);
+
+//////////////////
+// Constructors //
+//////////////////
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+bsr_matrix<IndexType,ValueType,MemorySpace>
+::bsr_matrix(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+             const size_t num_blocks, const size_t block_size)
+    : Parent(num_rows, num_cols, num_entries),
+      block_size(block_size)
+{
+    const size_t num_block_rows = block_size == 0 ? 0 : num_rows / block_size;
+
+    row_offsets.resize(num_block_rows + 1);
+    column_indices.resize(num_blocks);
+    values.resize(num_blocks * block_size * block_size);
+}
+
+// construct from a different matrix
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename MatrixType>
+bsr_matrix<IndexType,ValueType,MemorySpace>
+::bsr_matrix(const MatrixType& matrix)
+    : block_size(0)
+{
+    cusp::convert(matrix, *this);
+}
+
+// construct from a different matrix using a specific block size
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename MatrixType>
+bsr_matrix<IndexType,ValueType,MemorySpace>
+::bsr_matrix(const MatrixType& matrix, const size_t block_size)
+    : block_size(block_size)
+{
+    cusp::convert(matrix, *this);
+}
+
+//////////////////////
+// Member Functions //
+//////////////////////
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+void
+bsr_matrix<IndexType,ValueType,MemorySpace>
+::resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+         const size_t num_blocks, const size_t block_size)
+{
+    const size_t num_block_rows = block_size == 0 ? 0 : num_rows / block_size;
+
+    Parent::resize(num_rows, num_cols, num_entries);
+    this->block_size = block_size;
+    row_offsets.resize(num_block_rows + 1);
+    column_indices.resize(num_blocks);
+    values.resize(num_blocks * block_size * block_size);
+}
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+void
+bsr_matrix<IndexType,ValueType,MemorySpace>
+::swap(bsr_matrix& matrix)
+{
+    Parent::swap(matrix);
+    row_offsets.swap(matrix.row_offsets);
+    column_indices.swap(matrix.column_indices);
+    values.swap(matrix.values);
+    thrust::swap(block_size, matrix.block_size);
+}
+
+// assignment from another matrix
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename MatrixType>
+bsr_matrix<IndexType,ValueType,MemorySpace>&
+bsr_matrix<IndexType,ValueType,MemorySpace>
+::operator=(const MatrixType& matrix)
+{
+    cusp::convert(matrix, *this);
+
+    return *this;
+}
+
+///////////////////////////
+// View Member Functions //
+///////////////////////////
+
+template <typename ArrayType1,typename ArrayType2,typename ArrayType3,
+          typename IndexType, typename ValueType, typename MemorySpace>
+void
+bsr_matrix_view<ArrayType1,ArrayType2,ArrayType3,IndexType,ValueType,MemorySpace>
+::resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+         const size_t num_blocks, const size_t block_size)
+{
+    const size_t num_block_rows = block_size == 0 ? 0 : num_rows / block_size;
+
+    Parent::resize(num_rows, num_cols, num_entries);
+    this->block_size = block_size;
+    row_offsets.resize(num_block_rows + 1);
+    column_indices.resize(num_blocks);
+    values.resize(num_blocks * block_size * block_size);
+}
+
+} // end namespace cusp
+
+#include <cusp/convert.h>
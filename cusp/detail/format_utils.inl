@@ -121,6 +121,56 @@ size_t count_diagonals(const size_t num_rows,
     return cusp::count_diagonals(select_system(system1,system2), num_rows, num_cols, row_indices, column_indices);
 }
 
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+size_t compute_bandwidth(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                         const ArrayType1& row_indices,
+                         const ArrayType2& column_indices)
+{
+    using cusp::system::detail::generic::compute_bandwidth;
+
+    return compute_bandwidth(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), row_indices, column_indices);
+}
+
+template <typename ArrayType1, typename ArrayType2>
+size_t compute_bandwidth(const ArrayType1& row_indices,
+                         const ArrayType2& column_indices)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename ArrayType1::memory_space System1;
+    typedef typename ArrayType2::memory_space System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::compute_bandwidth(select_system(system1,system2), row_indices, column_indices);
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+size_t compute_profile(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                       const ArrayType1& row_indices,
+                       const ArrayType2& column_indices)
+{
+    using cusp::system::detail::generic::compute_profile;
+
+    return compute_profile(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), row_indices, column_indices);
+}
+
+template <typename ArrayType1, typename ArrayType2>
+size_t compute_profile(const ArrayType1& row_indices,
+                       const ArrayType2& column_indices)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename ArrayType1::memory_space System1;
+    typedef typename ArrayType2::memory_space System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::compute_profile(select_system(system1,system2), row_indices, column_indices);
+}
+
 template <typename DerivedPolicy, typename ArrayType>
 size_t compute_max_entries_per_row(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
                                    const ArrayType& row_offsets)
@@ -111,6 +111,38 @@ struct occupied_diagonal_functor
     }
 };
 
+template <typename IndexType>
+struct entry_bandwidth_functor
+{
+    typedef IndexType result_type;
+
+    template <typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        const IndexType i = thrust::get<0>(t);
+        const IndexType j = thrust::get<1>(t);
+
+        return i < j ? j - i : i - j;
+    }
+};
+
+template <typename IndexType>
+struct entry_profile_functor
+{
+    typedef IndexType result_type;
+
+    template <typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        const IndexType i = thrust::get<0>(t);
+        const IndexType j = thrust::get<1>(t);
+
+        return i > j ? i - j : IndexType(0);
+    }
+};
+
 struct speed_threshold_functor
 {
     size_t num_rows;
@@ -181,7 +181,14 @@ bool monitor<ValueType>
 ::finished(thrust::execution_policy<DerivedPolicy> &exec,
            const Vector& r)
 {
-    r_norm = cusp::blas::nrm2(exec, r);
+    return finished_norm(cusp::blas::nrm2(exec, r));
+}
+
+template <typename ValueType>
+bool monitor<ValueType>
+::finished_norm(const Real norm)
+{
+    r_norm = norm;
     residuals.push_back(r_norm);
 
     if(verbose)
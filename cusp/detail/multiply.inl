@@ -150,6 +150,208 @@ void generalized_spgemm(const LinearOperator&  A,
     return cusp::generalized_spgemm(select_system(system1,system2,system3), A, B, C, initialize, combine, reduce);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_symbolic(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                     const MatrixType1& A,
+                     const MatrixType2& B,
+                     MatrixType3& C)
+{
+    using cusp::system::detail::generic::spgemm_symbolic;
+
+    return spgemm_symbolic(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, B, C);
+}
+
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_symbolic(const MatrixType1& A,
+                     const MatrixType2& B,
+                     MatrixType3& C)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType1::memory_space System1;
+    typedef typename MatrixType2::memory_space System2;
+    typedef typename MatrixType3::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    return cusp::spgemm_symbolic(select_system(system1,system2,system3), A, B, C);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_numeric(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C)
+{
+    using cusp::system::detail::generic::spgemm_numeric;
+
+    return spgemm_numeric(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, B, C);
+}
+
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_numeric(const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType1::memory_space System1;
+    typedef typename MatrixType2::memory_space System2;
+    typedef typename MatrixType3::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    return cusp::spgemm_numeric(select_system(system1,system2,system3), A, B, C);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spgemm_numeric(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C,
+                    UnaryFunction   initialize,
+                    BinaryFunction1 combine,
+                    BinaryFunction2 reduce)
+{
+    using cusp::system::detail::generic::spgemm_numeric;
+
+    return spgemm_numeric(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, B, C, initialize, combine, reduce);
+}
+
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spgemm_numeric(const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C,
+                    UnaryFunction   initialize,
+                    BinaryFunction1 combine,
+                    BinaryFunction2 reduce)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType1::memory_space System1;
+    typedef typename MatrixType2::memory_space System2;
+    typedef typename MatrixType3::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    return cusp::spgemm_numeric(select_system(system1,system2,system3), A, B, C, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4>
+void masked_spgemm(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C)
+{
+    using cusp::system::detail::generic::masked_spgemm;
+
+    return masked_spgemm(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, B, M, C);
+}
+
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4>
+void masked_spgemm(const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType1::memory_space System1;
+    typedef typename MatrixType2::memory_space System2;
+    typedef typename MatrixType4::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    return cusp::masked_spgemm(select_system(system1,system2,system3), A, B, M, C);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void masked_spgemm(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    using cusp::system::detail::generic::masked_spgemm;
+
+    return masked_spgemm(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, B, M, C, initialize, combine, reduce);
+}
+
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void masked_spgemm(const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType1::memory_space System1;
+    typedef typename MatrixType2::memory_space System2;
+    typedef typename MatrixType4::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    return cusp::masked_spgemm(select_system(system1,system2,system3), A, B, M, C, initialize, combine, reduce);
+}
+
 template <typename DerivedPolicy,
           typename LinearOperator,
           typename Vector1,
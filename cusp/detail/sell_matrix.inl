@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/format_utils.h>
+
+namespace cusp
+{
+
+// Forward definitions
+template <typename T1, typename T2> void convert(const T1&, T2&);
+
+//////////////////
+// Constructors //
+//////////////////
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+sell_matrix<IndexType,ValueType,MemorySpace>
+::sell_matrix(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+              const size_t num_slots, const size_t chunk_size, const size_t sigma)
+    : Parent(num_rows, num_cols, num_entries),
+      chunk_size(chunk_size),
+      sigma(sigma)
+{
+    const size_t num_chunks = chunk_size == 0 ? 0 : (num_rows + chunk_size - 1) / chunk_size;
+
+    chunk_offsets.resize(num_chunks + 1);
+    row_permutation.resize(num_rows);
+    column_indices.resize(num_slots);
+    values.resize(num_slots);
+}
+
+// construct from a different matrix
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename MatrixType>
+sell_matrix<IndexType,ValueType,MemorySpace>
+::sell_matrix(const MatrixType& matrix)
+    : chunk_size(0),
+      sigma(0)
+{
+    cusp::convert(matrix, *this);
+}
+
+// construct from a different matrix using a specific chunk size and sorting window
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename MatrixType>
+sell_matrix<IndexType,ValueType,MemorySpace>
+::sell_matrix(const MatrixType& matrix, const size_t chunk_size, const size_t sigma)
+    : chunk_size(chunk_size),
+      sigma(sigma)
+{
+    cusp::convert(matrix, *this);
+}
+
+//////////////////////
+// Member Functions //
+//////////////////////
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+void
+sell_matrix<IndexType,ValueType,MemorySpace>
+::resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+         const size_t num_slots, const size_t chunk_size, const size_t sigma)
+{
+    const size_t num_chunks = chunk_size == 0 ? 0 : (num_rows + chunk_size - 1) / chunk_size;
+
+    Parent::resize(num_rows, num_cols, num_entries);
+    this->chunk_size = chunk_size;
+    this->sigma = sigma;
+    chunk_offsets.resize(num_chunks + 1);
+    row_permutation.resize(num_rows);
+    column_indices.resize(num_slots);
+    values.resize(num_slots);
+}
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+void
+sell_matrix<IndexType,ValueType,MemorySpace>
+::swap(sell_matrix& matrix)
+{
+    Parent::swap(matrix);
+    chunk_offsets.swap(matrix.chunk_offsets);
+    row_permutation.swap(matrix.row_permutation);
+    column_indices.swap(matrix.column_indices);
+    values.swap(matrix.values);
+    thrust::swap(chunk_size, matrix.chunk_size);
+    thrust::swap(sigma, matrix.sigma);
+}
+
+// assignment from another matrix
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename MatrixType>
+sell_matrix<IndexType,ValueType,MemorySpace>&
+sell_matrix<IndexType,ValueType,MemorySpace>
+::operator=(const MatrixType& matrix)
+{
+    cusp::convert(matrix, *this);
+
+    return *this;
+}
+
+///////////////////////////
+// View Member Functions //
+///////////////////////////
+
+template <typename ArrayType1,typename ArrayType2,typename ArrayType3,typename ArrayType4,
+          typename IndexType, typename ValueType, typename MemorySpace>
+void
+sell_matrix_view<ArrayType1,ArrayType2,ArrayType3,ArrayType4,IndexType,ValueType,MemorySpace>
+::resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+         const size_t num_slots, const size_t chunk_size, const size_t sigma)
+{
+    const size_t num_chunks = chunk_size == 0 ? 0 : (num_rows + chunk_size - 1) / chunk_size;
+
+    Parent::resize(num_rows, num_cols, num_entries);
+    this->chunk_size = chunk_size;
+    this->sigma = sigma;
+    chunk_offsets.resize(num_chunks + 1);
+    row_permutation.resize(num_rows);
+    column_indices.resize(num_slots);
+    values.resize(num_slots);
+}
+
+} // end namespace cusp
+
+#include <cusp/convert.h>
@@ -43,6 +43,8 @@ template <typename, typename, typename> class dia_matrix;
 template <typename, typename, typename> class csr_matrix;
 template <typename, typename, typename> class ell_matrix;
 template <typename, typename, typename> class hyb_matrix;
+template <typename, typename, typename> class bsr_matrix;
+template <typename, typename, typename> class sell_matrix;
 
 namespace detail
 {
@@ -60,6 +62,8 @@ template<typename MatrixType> struct is_csr     : is_matrix_type<MatrixType,cusp
 template<typename MatrixType> struct is_dia     : is_matrix_type<MatrixType,cusp::dia_format> {};
 template<typename MatrixType> struct is_ell     : is_matrix_type<MatrixType,cusp::ell_format> {};
 template<typename MatrixType> struct is_hyb     : is_matrix_type<MatrixType,cusp::hyb_format> {};
+template<typename MatrixType> struct is_bsr     : is_matrix_type<MatrixType,cusp::bsr_format> {};
+template<typename MatrixType> struct is_sell    : is_matrix_type<MatrixType,cusp::sell_format> {};
 
 template<typename IndexType, typename ValueType, typename MemorySpace, typename FormatTag> struct matrix_type {};
 
@@ -105,6 +109,18 @@ struct matrix_type<IndexType,ValueType,MemorySpace,cusp::hyb_format>
     typedef cusp::hyb_matrix<IndexType,ValueType,MemorySpace> type;
 };
 
+template<typename IndexType, typename ValueType, typename MemorySpace>
+struct matrix_type<IndexType,ValueType,MemorySpace,cusp::bsr_format>
+{
+    typedef cusp::bsr_matrix<IndexType,ValueType,MemorySpace> type;
+};
+
+template<typename IndexType, typename ValueType, typename MemorySpace>
+struct matrix_type<IndexType,ValueType,MemorySpace,cusp::sell_format>
+{
+    typedef cusp::sell_matrix<IndexType,ValueType,MemorySpace> type;
+};
+
 template<typename MatrixType, typename Format = typename MatrixType::format>
 struct get_index_type
 {
@@ -144,6 +160,12 @@ struct as_ell_type : as_matrix_type<MatrixType,MemorySpace,ell_format> {};
 template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
 struct as_hyb_type : as_matrix_type<MatrixType,MemorySpace,hyb_format> {};
 
+template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
+struct as_bsr_type : as_matrix_type<MatrixType,MemorySpace,bsr_format> {};
+
+template<typename MatrixType,typename MemorySpace=typename MatrixType::memory_space>
+struct as_sell_type : as_matrix_type<MatrixType,MemorySpace,sell_format> {};
+
 template<typename RowArray, typename ColumnArray, typename ValueArray>
 struct coo_view_type<RowArray,ColumnArray,ValueArray,cusp::csr_format>
 {
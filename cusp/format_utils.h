@@ -237,6 +237,101 @@ size_t count_diagonals(const size_t num_rows,
                        const ArrayType1& row_indices,
                        const ArrayType2& column_indices);
 
+/* \cond */
+template <typename DerivedPolicy,
+          typename ArrayType1,
+          typename ArrayType2>
+size_t compute_bandwidth(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                         const ArrayType1& row_indices,
+                         const ArrayType2& column_indices);
+/* \endcond */
+
+/**
+ * \brief Compute the bandwidth of the input matrix
+ *
+ * The bandwidth is the largest distance |i - j| of any entry A(i,j) from
+ * the main diagonal.
+ *
+ * \tparam ArrayType1 Type of input row indices
+ * \tparam ArrayType2 Type of input column indices
+ *
+ * \param row_indices row indices of input matrix
+ * \param column_indices column indices of input matrix
+ * \return bandwidth of the matrix
+ *
+ * \par Example
+ * \code
+ * #include <cusp/coo_matrix.h>
+ * #incldue <cusp/gallery/poisson.h>
+ *
+ * #include <cusp/format_utils.h>
+ *
+ * #include <iostream>
+ *
+ * int main()
+ * {
+ *   // initialize 5x5 poisson matrix
+ *   cusp::coo_matrix<int,float,cusp::host_memory> A;
+ *   cusp::gallery::poisson5pt(A, 5, 5);
+ *
+ *   // compute the bandwidth of A
+ *   std::cout << compute_bandwidth(A.row_indices, A.column_indices) << std::endl;
+ * }
+ * \endcode
+ */
+template <typename ArrayType1,
+          typename ArrayType2>
+size_t compute_bandwidth(const ArrayType1& row_indices,
+                         const ArrayType2& column_indices);
+
+/* \cond */
+template <typename DerivedPolicy,
+          typename ArrayType1,
+          typename ArrayType2>
+size_t compute_profile(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                       const ArrayType1& row_indices,
+                       const ArrayType2& column_indices);
+/* \endcond */
+
+/**
+ * \brief Compute the profile (envelope size) of the input matrix
+ *
+ * The profile is the sum over all rows i of i - f(i), where f(i) is the
+ * column of the first entry in row i, or i if the row has no entries left
+ * of the diagonal. The row indices must be sorted.
+ *
+ * \tparam ArrayType1 Type of input row indices
+ * \tparam ArrayType2 Type of input column indices
+ *
+ * \param row_indices sorted row indices of input matrix
+ * \param column_indices column indices of input matrix
+ * \return profile of the matrix
+ *
+ * \par Example
+ * \code
+ * #include <cusp/coo_matrix.h>
+ * #incldue <cusp/gallery/poisson.h>
+ *
+ * #include <cusp/format_utils.h>
+ *
+ * #include <iostream>
+ *
+ * int main()
+ * {
+ *   // initialize 5x5 poisson matrix
+ *   cusp::coo_matrix<int,float,cusp::host_memory> A;
+ *   cusp::gallery::poisson5pt(A, 5, 5);
+ *
+ *   // compute the profile of A
+ *   std::cout << compute_profile(A.row_indices, A.column_indices) << std::endl;
+ * }
+ * \endcode
+ */
+template <typename ArrayType1,
+          typename ArrayType2>
+size_t compute_profile(const ArrayType1& row_indices,
+                       const ArrayType2& column_indices);
+
 /* \cond */
 template <typename DerivedPolicy,
           typename ArrayType>
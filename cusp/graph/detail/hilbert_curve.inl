@@ -58,6 +58,34 @@ void hilbert_curve(const Array2dType& G,
     cusp::graph::hilbert_curve(select_system(system1,system2), G, num_parts, parts);
 }
 
+template <typename DerivedPolicy,
+          typename Array2dType,
+          typename PermutationType>
+void hilbert_curve_permutation(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                               const Array2dType& coord,
+                               PermutationType& P)
+{
+    using cusp::system::detail::generic::hilbert_curve_permutation;
+
+    hilbert_curve_permutation(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), coord, P);
+}
+
+template<typename Array2dType,
+         typename PermutationType>
+void hilbert_curve_permutation(const Array2dType& coord,
+                               PermutationType& P)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename Array2dType::memory_space    System1;
+    typedef typename PermutationType::memory_space System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::graph::hilbert_curve_permutation(select_system(system1,system2), coord, P);
+}
+
 } // end namespace graph
 } // end namespace cusp
 
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/detail/config.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+#include <cusp/array1d.h>
+#include <cusp/exception.h>
+#include <cusp/monitor.h>
+#include <cusp/graph/pagerank.h>
+
+#include <cusp/system/detail/adl/graph/pagerank.h>
+#include <cusp/system/detail/generic/graph/pagerank.h>
+
+namespace cusp
+{
+namespace graph
+{
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename Monitor>
+void pagerank(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+              const MatrixType& G,
+              ArrayType& ranks,
+              Monitor& monitor,
+              const double damping)
+{
+    using cusp::system::detail::generic::pagerank;
+
+    pagerank(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, ranks, monitor, damping);
+}
+
+template<typename MatrixType,
+         typename ArrayType,
+         typename Monitor>
+void pagerank(const MatrixType& G,
+              ArrayType& ranks,
+              Monitor& monitor,
+              const double damping)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::graph::pagerank(select_system(system1,system2), G, ranks, monitor, damping);
+}
+
+template<typename MatrixType,
+         typename ArrayType>
+void pagerank(const MatrixType& G,
+              ArrayType& ranks)
+{
+    typedef typename ArrayType::value_type   ValueType;
+    typedef typename ArrayType::memory_space MemorySpace;
+
+    cusp::array1d<ValueType,MemorySpace> uniform(G.num_rows, ValueType(1) / ValueType(G.num_rows));
+    cusp::monitor<ValueType> monitor(uniform, 100, 1e-6);
+
+    cusp::graph::pagerank(G, ranks, monitor);
+}
+
+} // end namespace graph
+} // end namespace cusp
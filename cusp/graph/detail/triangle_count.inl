@@ -0,0 +1,54 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/detail/config.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+#include <cusp/exception.h>
+#include <cusp/graph/triangle_count.h>
+
+#include <cusp/system/detail/adl/graph/triangle_count.h>
+#include <cusp/system/detail/generic/graph/triangle_count.h>
+
+namespace cusp
+{
+namespace graph
+{
+
+template <typename DerivedPolicy,
+          typename MatrixType>
+size_t triangle_count(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G)
+{
+    using cusp::system::detail::generic::triangle_count;
+
+    return triangle_count(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G);
+}
+
+template<typename MatrixType>
+size_t triangle_count(const MatrixType& G)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System;
+
+    System system;
+
+    return cusp::graph::triangle_count(select_system(system), G);
+}
+
+} // end namespace graph
+} // end namespace cusp
@@ -56,6 +56,36 @@ size_t vertex_coloring(const MatrixType& G,
     return cusp::graph::vertex_coloring(select_system(system1,system2), G, colors);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             ArrayType& colors,
+                       const bool balance)
+{
+    using cusp::system::detail::generic::vertex_coloring;
+
+    return vertex_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, colors, balance);
+}
+
+template<typename MatrixType,
+         typename ArrayType>
+size_t vertex_coloring(const MatrixType& G,
+                             ArrayType& colors,
+                       const bool balance)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::vertex_coloring(select_system(system1,system2), G, colors, balance);
+}
+
 } // end namespace graph
 } // end namespace cusp
 
@@ -108,6 +108,73 @@ template <class Array2dType,
 void hilbert_curve(const Array2dType& coord,
                    const size_t num_parts,
                          ArrayType& parts);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename Array2dType,
+          typename PermutationType>
+void hilbert_curve_permutation(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                               const Array2dType& coord,
+                                     PermutationType& P);
+/*! \endcond */
+
+/**
+ * \brief Order points along a Hilbert curve
+ *
+ * \param coord Set of points in 2 or 3-D space
+ * \param P The permutation matrix that orders the points along the curve
+ *
+ * \tparam Array2dType Type of input coordinates array
+ * \tparam PermutationType Type of permutation matrix
+ *
+ * \par Overview
+ * Sorts a set of points in 2 or 3 dimensional space along a Hilbert space
+ * filling curve and stores the position of every point along the curve in
+ * P. Symmetrically permuting a matrix whose rows correspond to the points
+ * places rows of nearby points close together, which improves the locality
+ * of sparse matrix-vector products.
+ *
+ * \see http://en.wikipedia.org/wiki/Hilbert_curve
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array2d.h>
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/permutation_matrix.h>
+ * #include <cusp/gallery/grid.h>
+ *
+ * //include Hilbert curve header file
+ * #include <cusp/graph/hilbert_curve.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::grid2d(G, 4, 4);
+ *
+ *    // Allocate array of coordinates in 2D
+ *    cusp::array2d<float,cusp::device_memory> coords(G.num_rows, 2);
+ *
+ *    // Generate random coordinates
+ *    cusp::copy(cusp::random_array<float>(coords.num_entries, rand()), coords.values);
+ *
+ *    // Allocate permutation matrix P
+ *    cusp::permutation_matrix<int,cusp::device_memory> P(G.num_rows);
+ *
+ *    // Order the points along the Hilbert curve
+ *    cusp::graph::hilbert_curve_permutation(coords, P);
+ *
+ *    // Reorder the graph to match the point ordering
+ *    P.symmetric_permute(G);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <class Array2dType,
+          class PermutationType>
+void hilbert_curve_permutation(const Array2dType& coord,
+                                     PermutationType& P);
 /*! \}
  */
 
@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file pagerank.h
+ *  \brief Compute the PageRank of the vertices of a graph
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType,
+          typename Monitor>
+void pagerank(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+              const MatrixType& G,
+                    ArrayType& ranks,
+                    Monitor& monitor,
+              const double damping);
+/*! \endcond */
+
+/**
+ * \brief Computes the PageRank of every vertex of a graph
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of ranks array
+ * \tparam Monitor Type of monitor
+ *
+ * \param G A matrix that represents the graph, every entry G(i,j) is an
+ * edge from vertex i to vertex j
+ * \param ranks Array containing the rank of every vertex
+ * \param monitor Monitors the change of the ranks between iterations
+ * \param damping Probability of following an edge instead of jumping to a
+ * random vertex
+ *
+ * \par Overview
+ * Runs the power iteration on the Google matrix until the monitor is
+ * satisfied with the 2-norm of the change of the ranks. Every iteration is
+ * a generalized sparse matrix-vector product with the transpose of G.
+ * Vertices without outgoing edges distribute their rank uniformly over all
+ * vertices. The values of G are ignored and the ranks sum to one.
+ *
+ * \see http://en.wikipedia.org/wiki/PageRank
+ *
+ * \par Example
+ *
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/monitor.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/grid.h>
+ *
+ * //include pagerank header file
+ * #include <cusp/graph/pagerank.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::grid2d(G, 4, 4);
+ *
+ *    cusp::array1d<float,cusp::device_memory> ranks(G.num_rows);
+ *
+ *    // stop once the ranks change by less than 1e-6 relative to a uniform
+ *    // distribution or after 100 iterations
+ *    cusp::array1d<float,cusp::device_memory> uniform(G.num_rows, 1.0f / G.num_rows);
+ *    cusp::monitor<float> monitor(uniform, 100, 1e-6);
+ *
+ *    // Compute the PageRank on the device
+ *    cusp::graph::pagerank(G, ranks, monitor);
+ *
+ *    // Print the rank of every vertex
+ *    cusp::print(ranks);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template<typename MatrixType,
+         typename ArrayType,
+         typename Monitor>
+void pagerank(const MatrixType& G,
+                    ArrayType& ranks,
+                    Monitor& monitor,
+              const double damping = 0.85);
+
+/**
+ * \brief Computes the PageRank of every vertex of a graph
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of ranks array
+ *
+ * \param G A matrix that represents the graph, every entry G(i,j) is an
+ * edge from vertex i to vertex j
+ * \param ranks Array containing the rank of every vertex
+ *
+ * \par Overview
+ * Uses a damping factor of 0.85 and stops once the ranks change by less
+ * than 1e-6 relative to a uniform distribution or after 100 iterations.
+ */
+template<typename MatrixType,
+         typename ArrayType>
+void pagerank(const MatrixType& G,
+                    ArrayType& ranks);
+/*! \}
+ */
+
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/pagerank.inl>
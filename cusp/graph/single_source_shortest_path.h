@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file single_source_shortest_path.h
+ *  \brief Single-source shortest paths of a weighted graph
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+void single_source_shortest_path(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances);
+/*! \endcond */
+
+/**
+ * \brief Computes the length of the shortest path from a source vertex to
+ * every vertex of a weighted graph
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of distances array
+ *
+ * \param G A matrix that represents the graph, every entry G(i,j) is an
+ * edge from vertex i to vertex j whose weight is the value of the entry
+ * \param src The source vertex
+ * \param distances Array containing the length of the shortest path from
+ * src to every vertex, or std::numeric_limits<value_type>::max() if the
+ * vertex is unreachable
+ *
+ * \par Overview
+ * Relaxes the distances with generalized sparse matrix-vector products
+ * over the (min,+) semiring until no distance changes (Bellman-Ford).
+ * Negative weights are allowed as long as the graph has no negative
+ * cycle.
+ *
+ * \see http://en.wikipedia.org/wiki/Bellman-Ford_algorithm
+ *
+ * \par Example
+ *
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * #include <thrust/fill.h>
+ *
+ * //include shortest path header file
+ * #include <cusp/graph/single_source_shortest_path.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid with unit weights on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::poisson5pt(G, 4, 4);
+ *    thrust::fill(G.values.begin(), G.values.end(), 1.0f);
+ *
+ *    cusp::array1d<float,cusp::device_memory> distances(G.num_rows);
+ *
+ *    // Compute the shortest paths from vertex 0 on the device
+ *    cusp::graph::single_source_shortest_path(G, 0, distances);
+ *
+ *    // Print the distance of every vertex
+ *    cusp::print(distances);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template<typename MatrixType,
+         typename ArrayType>
+void single_source_shortest_path(const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances);
+/*! \}
+ */
+
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/single_source_shortest_path.inl>
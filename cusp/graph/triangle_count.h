@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file triangle_count.h
+ *  \brief Count the triangles of a graph
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType>
+size_t triangle_count(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G);
+/*! \endcond */
+
+/**
+ * \brief Counts the triangles of an undirected graph
+ *
+ * \tparam MatrixType Type of input matrix
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \return The number of triangles in the graph
+ *
+ * \par Overview
+ * Let L be the strictly lower triangular part of G. Every triangle
+ * i > j > k contributes one to entry (i,j) of L * L^T, so the number of
+ * triangles is the sum of the product masked by the pattern of L. Only
+ * the products inside the mask are computed. Entries on the diagonal are
+ * ignored.
+ *
+ * \see http://en.wikipedia.org/wiki/Triangle_graph
+ *
+ * \par Example
+ *
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * //include triangle count header file
+ * #include <cusp/graph/triangle_count.h>
+ *
+ * #include <iostream>
+ *
+ * int main()
+ * {
+ *    // Build a 2D 9-point grid on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::poisson9pt(G, 4, 4);
+ *
+ *    // Count the triangles on the device
+ *    size_t num_triangles = cusp::graph::triangle_count(G);
+ *
+ *    std::cout << "Found " << num_triangles << " triangles in the graph." << std::endl;
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template<typename MatrixType>
+size_t triangle_count(const MatrixType& G);
+/*! \}
+ */
+
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/triangle_count.inl>
@@ -43,6 +43,14 @@ template <typename DerivedPolicy,
 size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
                        const MatrixType& G,
                              ArrayType& colors);
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             ArrayType& colors,
+                       const bool balance);
 /*! \endcond */
 
 /**
@@ -89,6 +97,31 @@ template<typename MatrixType,
          typename ArrayType>
 size_t vertex_coloring(const MatrixType& G,
                              ArrayType& colors);
+
+/**
+ * \brief Performs a vertex coloring a graph with optionally balanced color
+ * classes.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of colors array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param colors Contains to the color associated with each vertex
+ * computed during the coloring routine
+ * \param balance Boolean value indicating whether vertices should be moved
+ * from large color classes into small ones after coloring, \c true, or not,
+ * \c false. Balanced classes expose the same amount of parallelism in
+ * every color of a multicolor sweep.
+ *
+ * \return The number of colors used
+ *
+ *  \see http://en.wikipedia.org/wiki/Graph_coloring
+ */
+template<typename MatrixType,
+         typename ArrayType>
+size_t vertex_coloring(const MatrixType& G,
+                             ArrayType& colors,
+                       const bool balance);
 /*! \}
  */
 
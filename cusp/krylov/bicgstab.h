@@ -22,6 +22,8 @@
 
 #include <cusp/detail/config.h>
 
+#include <cusp/array1d.h>
+
 #include <cusp/detail/execution_policy.h>
 
 namespace cusp
@@ -137,6 +139,132 @@ void bicgstab(const LinearOperator& A,
               const VectorType2& b,
                     Monitor& monitor,
                     Preconditioner& M);
+
+/**
+ * \brief BiCGstab solver owning its workspace
+ *
+ * \tparam ValueType value_type of the workspace
+ * \tparam MemorySpace memory space of the workspace
+ *
+ * \par Overview
+ * Performs the same iterations as \p bicgstab, but the work vectors are members
+ * of the solver. They are allocated by \p setup, or by the first call to
+ * \p solve, and reused by every later \p solve on a matrix of the same
+ * size, so repeated solves do not allocate workspace.
+ *
+ * \par Example
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/bicgstab.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int, float, cusp::device_memory> A;
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      cusp::array1d<float, cusp::device_memory> x(A.num_rows);
+ *      cusp::array1d<float, cusp::device_memory> b(A.num_rows, 1);
+ *
+ *      // allocate the workspace once
+ *      cusp::krylov::bicgstab_solver<float, cusp::device_memory> solver(A);
+ *
+ *      for (int i = 0; i < 1000; i++)
+ *      {
+ *          cusp::blas::fill(x, 0);
+ *          cusp::monitor<float> monitor(b, 100, 1e-6);
+ *
+ *          // solve the linear system A x = b without allocating workspace
+ *          solver.solve(A, x, b, monitor);
+ *      }
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p bicgstab
+ */
+template <typename ValueType, typename MemorySpace>
+class bicgstab_solver
+{
+public:
+
+    /*! Construct an empty \p bicgstab_solver.
+     */
+    bicgstab_solver(void) {}
+
+    /*! Construct a \p bicgstab_solver with workspace for \p A.
+     *
+     * \param A matrix of the linear systems
+     */
+    template <typename MatrixType>
+    bicgstab_solver(const MatrixType& A);
+
+    /*! Allocate the workspace for \p A, does nothing if the workspace
+     * already has the size of \p A.
+     *
+     * \param A matrix of the linear systems
+     */
+    template <typename MatrixType>
+    void setup(const MatrixType& A);
+
+    /* \cond */
+    template <typename DerivedPolicy,
+              typename LinearOperator,
+              typename VectorType1,
+              typename VectorType2,
+              typename Monitor,
+              typename Preconditioner>
+    void solve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+               const LinearOperator& A,
+                     VectorType1& x,
+               const VectorType2& b,
+                     Monitor& monitor,
+                     Preconditioner& M);
+
+    template <typename LinearOperator,
+              typename VectorType1,
+              typename VectorType2,
+              typename Monitor>
+    void solve(const LinearOperator& A,
+                     VectorType1& x,
+               const VectorType2& b,
+                     Monitor& monitor);
+    /* \endcond */
+
+    /*! Solve A x = b with preconditioner \p M, see \p bicgstab.
+     *
+     * \param A matrix of the linear system
+     * \param x approximate solution of the linear system
+     * \param b right-hand side of the linear system
+     * \param monitor monitors iteration and determines stopping conditions
+     * \param M preconditioner for A
+     */
+    template <typename LinearOperator,
+              typename VectorType1,
+              typename VectorType2,
+              typename Monitor,
+              typename Preconditioner>
+    void solve(const LinearOperator& A,
+                     VectorType1& x,
+               const VectorType2& b,
+                     Monitor& monitor,
+                     Preconditioner& M);
+
+private:
+
+    /* \cond */
+    cusp::array1d<ValueType,MemorySpace> p;
+    cusp::array1d<ValueType,MemorySpace> r;
+    cusp::array1d<ValueType,MemorySpace> r_star;
+    cusp::array1d<ValueType,MemorySpace> s;
+    cusp::array1d<ValueType,MemorySpace> Mp;
+    cusp::array1d<ValueType,MemorySpace> AMp;
+    cusp::array1d<ValueType,MemorySpace> Ms;
+    cusp::array1d<ValueType,MemorySpace> AMs;
+    /* \endcond */
+};
 /*! \}
  */
 
@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file block_cg.h
+ *  \brief Block Conjugate Gradient (CG) method for multiple right-hand sides
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/detail/execution_policy.h>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors,
+          typename Preconditioner>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B,
+                    Monitors& monitors,
+                    Preconditioner& M);
+
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors>
+void block_cg(const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B,
+                    Monitors& monitors);
+
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2>
+void block_cg(const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B);
+/* \endcond */
+
+/**
+ * \brief Conjugate Gradient method for a block of right-hand sides
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam Array2d1 X input \p array2d type
+ * \tparam Array2d2 B output \p array2d type
+ * \tparam Monitors is a random access container of \p monitor
+ * \tparam Preconditioner is a matrix or subclass of \p linear_operator
+ *
+ * \param A matrix of the linear system
+ * \param X approximate solutions of the linear systems, one per column
+ * \param B right-hand sides of the linear systems, one per column
+ * \param monitors one monitor per column of \p B, \p monitors[j]
+ * monitors iteration and determines stopping conditions of column j
+ * \param M preconditioner for A
+ *
+ * \par Overview
+ * Solves the symmetric, positive-definite linear systems A X(:,j) = B(:,j)
+ * for all columns j of \p B with preconditioner \p M.
+ *
+ * Every column follows the recurrences of \p cg, but the products with
+ * \p A are computed for all columns at once, so \p A is read from
+ * memory once per iteration instead of once per right-hand side. A column
+ * is deflated as soon as its monitor is finished: its solution is written
+ * to \p X and the remaining iterations only process the unfinished
+ * columns. The preconditioner is applied to one column at a time.
+ *
+ * \note \p A and \p M must be symmetric and positive-definite.
+ * \note every monitor is checked with \p finished_norm.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to use \p block_cg to
+ *  solve a 10x10 Poisson problem for 8 right-hand sides.
+ *
+ *  \code
+ *  #include <cusp/array2d.h>
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/block_cg.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  #include <vector>
+ *
+ *  int main(void)
+ *  {
+ *      // create an empty sparse matrix structure (CSR format)
+ *      cusp::csr_matrix<int, float, cusp::host_memory> A;
+ *
+ *      // initialize matrix
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      // allocate storage for solutions (X) and right hand sides (B)
+ *      cusp::array2d<float, cusp::host_memory> X(A.num_rows, 8, 0);
+ *      cusp::array2d<float, cusp::host_memory> B(A.num_rows, 8, 1);
+ *
+ *      // set stopping criteria of every column:
+ *      //  iteration_limit    = 100
+ *      //  relative_tolerance = 1e-6
+ *      std::vector< cusp::monitor<float> > monitors;
+ *
+ *      for (size_t j = 0; j < B.num_cols; j++)
+ *          monitors.push_back(cusp::monitor<float>(B.column(j), 100, 1e-6));
+ *
+ *      // set preconditioner (identity)
+ *      cusp::identity_operator<float, cusp::host_memory> M(A.num_rows, A.num_rows);
+ *
+ *      // solve the linear systems A X = B
+ *      cusp::krylov::block_cg(A, X, B, monitors, M);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p cg
+ *  \see \p monitor
+ *
+ */
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors,
+          typename Preconditioner>
+void block_cg(const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B,
+                    Monitors& monitors,
+                    Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/block_cg.inl>
@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file ca_cg.h
+ *  \brief Communication-avoiding Conjugate Gradient (CA-CG) method
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/detail/execution_policy.h>
+
+#include <cusp/krylov/s_step_basis.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+           const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s,
+           const s_step_basis basis,
+                 Monitor& monitor,
+                 Preconditioner& M);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void ca_cg(const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s,
+                 Monitor& monitor);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void ca_cg(const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s);
+/* \endcond */
+
+/**
+ * \brief Communication-avoiding Conjugate Gradient method
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam VectorType1 x input vector type
+ * \tparam VectorType2 b output vector type
+ * \tparam Monitor is a \p monitor
+ * \tparam Preconditioner is a matrix or subclass of \p linear_operator
+ *
+ * \param A matrix of the linear system
+ * \param x approximate solution of the linear system
+ * \param b right-hand side of the linear system
+ * \param s number of iterations between two reductions
+ * \param basis polynomial basis of the s-step Krylov spaces
+ * \param monitor monitors iteration and determines stopping conditions
+ * \param M preconditioner for A
+ *
+ * \par Overview
+ * Solves the symmetric, positive-definite linear system A x = b
+ * with preconditioner \p M using the s-step, communication-avoiding
+ * variant of the Conjugate Gradient method described by Carson, Knight
+ * and Demmel.
+ *
+ * Every outer iteration generates the bases of the Krylov spaces of the
+ * search direction and of the preconditioned residual without any
+ * reduction, computes their Gram matrix in one blocked pass over the
+ * bases and then performs \p s iterations of CG on small coordinate
+ * vectors. All vectors are updated by a second pass over the bases. This
+ * replaces the 2 \p s inner products and 3 \p s vector updates of \p cg
+ * by one reduction and two passes over 4 \p s + 2 vectors, at the price
+ * of 2 \p s applications of \p A and \p M per \p s iterations and
+ * O(\p s^2) flops per row for the Gram matrix. The method pays off where
+ * global reductions dominate the iteration time; on a single host core
+ * \p cg is faster.
+ * The first outer iteration uses a normalized monomial basis, whose
+ * Lanczos matrix provides the spectral estimate for the \p basis of all
+ * later iterations.
+ *
+ * \note \p A and \p M must be symmetric and positive-definite.
+ * \note Only real value types are supported.
+ * \note \p monitor is checked with \p finished_norm using the true
+ * residual norm once per outer iteration. The inner iterations stop
+ * early on the residual norm estimated from the Gram matrix.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to use \p ca_cg to
+ *  solve a 10x10 Poisson problem.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/ca_cg.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // create an empty sparse matrix structure (CSR format)
+ *      cusp::csr_matrix<int, double, cusp::host_memory> A;
+ *
+ *      // initialize matrix
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      // allocate storage for solution (x) and right hand side (b)
+ *      cusp::array1d<double, cusp::host_memory> x(A.num_rows, 0);
+ *      cusp::array1d<double, cusp::host_memory> b(A.num_rows, 1);
+ *
+ *      // set stopping criteria:
+ *      //  iteration_limit    = 100
+ *      //  relative_tolerance = 1e-6
+ *      //  absolute_tolerance = 0
+ *      //  verbose            = true
+ *      cusp::monitor<double> monitor(b, 100, 1e-6, 0, true);
+ *
+ *      // set preconditioner (identity)
+ *      cusp::identity_operator<double, cusp::host_memory> M(A.num_rows, A.num_rows);
+ *
+ *      // solve the linear system A x = b with 4 iterations per reduction
+ *      cusp::krylov::ca_cg(A, x, b, 4, cusp::krylov::chebyshev_basis, monitor, M);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p cg
+ *  \see \p s_step_basis
+ *  \see \p monitor
+ *
+ */
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_cg(const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s,
+           const s_step_basis basis,
+                 Monitor& monitor,
+                 Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/ca_cg.inl>
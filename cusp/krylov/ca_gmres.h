@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file ca_gmres.h
+ *  \brief Communication-avoiding Generalized Minimum Residual (CA-GMRES) method
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/detail/execution_policy.h>
+
+#include <cusp/krylov/s_step_basis.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s,
+              const s_step_basis basis,
+                    Monitor& monitor,
+                    Preconditioner& M);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void ca_gmres(const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s,
+                    Monitor& monitor);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void ca_gmres(const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s);
+/* \endcond */
+
+/**
+ * \brief Communication-avoiding GMRES method
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam VectorType1 x input vector type
+ * \tparam VectorType2 b output vector type
+ * \tparam Monitor is a \p monitor
+ * \tparam Preconditioner is a matrix or subclass of \p linear_operator
+ *
+ * \param A matrix of the linear system
+ * \param x approximate solution of the linear system
+ * \param b right-hand side of the linear system
+ * \param restart maximum number of basis vectors before restarting
+ * \param s number of basis vectors generated between two reductions
+ * \param basis polynomial basis of the s-step Krylov spaces
+ * \param monitor monitors iteration and determines stopping conditions
+ * \param M preconditioner for A
+ *
+ * \par Overview
+ * Solves the linear system A x = b with preconditioner \p M using the
+ * s-step, communication-avoiding variant of the restarted Generalized
+ * Minimum Residual method described by Hoemmen.
+ *
+ * The Krylov basis grows by blocks of \p s vectors generated by \p s
+ * consecutive applications of M*A. The projections of a block on the
+ * previous basis and its Gram matrix are computed in one blocked pass
+ * over the basis, so a block costs one reduction instead of the O(s^2)
+ * inner products of modified Gram-Schmidt, and every basis vector is read
+ * once per block instead of once per new vector. The Gram matrix still
+ * costs O(\p s \p restart) flops per row. The first block of every solve uses a
+ * normalized monomial basis, whose Hessenberg matrix provides the
+ * spectral estimate for the \p basis of all later blocks.
+ *
+ * \note Only real value types are supported.
+ * \note As in \p gmres, \p monitor is checked against the norm of the
+ * preconditioned residual. A block whose vectors become linearly
+ * dependent is truncated, so the number of iterations per block can be
+ * less than \p s.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to use \p ca_gmres to
+ *  solve a 10x10 Poisson problem.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/ca_gmres.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // create an empty sparse matrix structure (CSR format)
+ *      cusp::csr_matrix<int, double, cusp::host_memory> A;
+ *
+ *      // initialize matrix
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      // allocate storage for solution (x) and right hand side (b)
+ *      cusp::array1d<double, cusp::host_memory> x(A.num_rows, 0);
+ *      cusp::array1d<double, cusp::host_memory> b(A.num_rows, 1);
+ *
+ *      // set stopping criteria:
+ *      //  iteration_limit    = 100
+ *      //  relative_tolerance = 1e-6
+ *      //  absolute_tolerance = 0
+ *      //  verbose            = true
+ *      cusp::monitor<double> monitor(b, 100, 1e-6, 0, true);
+ *
+ *      // set preconditioner (identity)
+ *      cusp::identity_operator<double, cusp::host_memory> M(A.num_rows, A.num_rows);
+ *
+ *      // solve the linear system A x = b with blocks of 5 vectors
+ *      cusp::krylov::ca_gmres(A, x, b, 50, 5, cusp::krylov::newton_basis, monitor, M);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p gmres
+ *  \see \p s_step_basis
+ *  \see \p monitor
+ *
+ */
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_gmres(const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s,
+              const s_step_basis basis,
+                    Monitor& monitor,
+                    Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/ca_gmres.inl>
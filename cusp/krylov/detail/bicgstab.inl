@@ -33,35 +33,33 @@ namespace krylov
 namespace bicg_detail
 {
 
+// BiCGstab iterations using the caller's workspace of size N
 template <typename DerivedPolicy,
           typename LinearOperator,
           typename VectorType1,
           typename VectorType2,
           typename Monitor,
-          typename Preconditioner>
-void bicgstab(thrust::execution_policy<DerivedPolicy> &exec,
-              const LinearOperator& A,
-                    VectorType1& x,
-              const VectorType2& b,
-                    Monitor& monitor,
-                    Preconditioner& M)
+          typename Preconditioner,
+          typename WorkspaceType>
+void bicgstab_solve(thrust::execution_policy<DerivedPolicy> &exec,
+                    const LinearOperator& A,
+                          VectorType1& x,
+                    const VectorType2& b,
+                          Monitor& monitor,
+                          Preconditioner& M,
+                          WorkspaceType& p,
+                          WorkspaceType& r,
+                          WorkspaceType& r_star,
+                          WorkspaceType& s,
+                          WorkspaceType& Mp,
+                          WorkspaceType& AMp,
+                          WorkspaceType& Ms,
+                          WorkspaceType& AMs)
 {
     typedef typename LinearOperator::value_type           ValueType;
 
     assert(A.num_rows == A.num_cols);        // sanity check
 
-    const size_t N = A.num_rows;
-
-    // allocate workspace
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>   p(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>   r(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy> r_star(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>   s(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>  Mp(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy> AMp(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>  Ms(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy> AMs(exec, N);
-
     // r <- Ax
     cusp::multiply(exec, A, x, r);
 
@@ -123,6 +121,36 @@ void bicgstab(thrust::execution_policy<DerivedPolicy> &exec,
     }
 }
 
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void bicgstab(thrust::execution_policy<DerivedPolicy> &exec,
+              const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+                    Monitor& monitor,
+                    Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type           ValueType;
+
+    const size_t N = A.num_rows;
+
+    // allocate workspace
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>   p(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>   r(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> r_star(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>   s(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>  Mp(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> AMp(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>  Ms(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> AMs(exec, N);
+
+    bicgstab_solve(exec, A, x, b, monitor, M, p, r, r_star, s, Mp, AMp, Ms, AMs);
+}
+
 } // end bicg_detail namespace
 
 template <typename DerivedPolicy,
@@ -196,6 +224,94 @@ void bicgstab(const LinearOperator& A,
     return cusp::krylov::bicgstab(A, x, b, monitor);
 }
 
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+bicgstab_solver<ValueType,MemorySpace>
+::bicgstab_solver(const MatrixType& A)
+{
+    setup(A);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void bicgstab_solver<ValueType,MemorySpace>
+::setup(const MatrixType& A)
+{
+    const size_t N = A.num_rows;
+
+    p.resize(N);
+    r.resize(N);
+    r_star.resize(N);
+    s.resize(N);
+    Mp.resize(N);
+    AMp.resize(N);
+    Ms.resize(N);
+    AMs.resize(N);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void bicgstab_solver<ValueType,MemorySpace>
+::solve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+        const LinearOperator& A,
+              VectorType1& x,
+        const VectorType2& b,
+              Monitor& monitor,
+              Preconditioner& M)
+{
+    using cusp::krylov::bicg_detail::bicgstab_solve;
+
+    // resizing is a no-op once the workspace matches A
+    setup(A);
+
+    bicgstab_solve(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, b, monitor, M,
+                   p, r, r_star, s, Mp, AMp, Ms, AMs);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void bicgstab_solver<ValueType,MemorySpace>
+::solve(const LinearOperator& A,
+              VectorType1& x,
+        const VectorType2& b,
+              Monitor& monitor,
+              Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType1::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    solve(select_system(system1,system2), A, x, b, monitor, M);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void bicgstab_solver<ValueType,MemorySpace>
+::solve(const LinearOperator& A,
+              VectorType1& x,
+        const VectorType2& b,
+              Monitor& monitor)
+{
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    solve(A, x, b, monitor, M);
+}
+
 } // end namespace krylov
 } // end namespace cusp
-
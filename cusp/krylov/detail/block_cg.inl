@@ -0,0 +1,277 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/linear_operator.h>
+#include <cusp/multiply.h>
+#include <cusp/monitor.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/krylov/detail/block_utils.h>
+
+#include <thrust/copy.h>
+
+#include <cmath>
+#include <vector>
+
+namespace cusp
+{
+namespace krylov
+{
+namespace block_cg_detail
+{
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors,
+          typename Preconditioner>
+void block_cg(thrust::execution_policy<DerivedPolicy> &exec,
+              const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B,
+                    Monitors& monitors,
+                    Preconditioner& M)
+{
+    using namespace cusp::krylov::block_detail;
+
+    typedef typename LinearOperator::value_type           ValueType;
+    typedef typename cusp::norm_type<ValueType>::type     NormType;
+
+    typedef cusp::detail::temporary_array<ValueType, DerivedPolicy>   Workspace;
+    typedef cusp::array1d_view<typename Workspace::iterator>          ColumnView;
+    typedef cusp::array2d_view<ColumnView, cusp::column_major>        BlockView;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+    assert(B.num_rows == A.num_rows && X.num_rows == A.num_rows && X.num_cols == B.num_cols);
+
+    const size_t N = A.num_rows;
+    const size_t S = B.num_cols;
+
+    if (S == 0)
+        return;
+
+    // allocate column-major workspace for all right-hand sides, the columns
+    // [0, K) are the columns still being iterated and column c of the
+    // workspace belongs to column columns[c] of X and B
+    Workspace Xw(exec, N * S);
+    Workspace Y(exec, N * S);
+    Workspace Z(exec, N * S);
+    Workspace R(exec, N * S);
+    Workspace P(exec, N * S);
+
+    // per-column scalars
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> coef(exec, S);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> dots(exec, S);
+    cusp::detail::temporary_array<NormType,  DerivedPolicy> norms(exec, S);
+
+    // HOST WORKSPACE
+    cusp::array1d<ValueType, cusp::host_memory> alpha(S);
+    cusp::array1d<ValueType, cusp::host_memory> beta(S);
+    cusp::array1d<ValueType, cusp::host_memory> rz(S);
+    cusp::array1d<ValueType, cusp::host_memory> rz_old(S);
+    cusp::array1d<NormType,  cusp::host_memory> rr(S);
+    std::vector<size_t> columns(S);
+
+    for (size_t c = 0; c < S; c++)
+    {
+        columns[c] = c;
+
+        cusp::blas::copy(exec, X.column(c), column(Xw, N, c));
+        cusp::blas::copy(exec, B.column(c), column(R, N, c));
+    }
+
+    size_t K = S;
+
+    // Y <- A*X, A is read once for all columns
+    BlockView Y_block = block(Y, N, K);
+    cusp::multiply(exec, A, block(Xw, N, K), Y_block);
+
+    // R <- B - A*X
+    ColumnView R_all = cusp::make_array1d_view(R.begin(), R.begin() + N * K);
+    cusp::blas::axpy(exec, Y_block.values, R_all, ValueType(-1));
+
+    // Z <- M*R, the preconditioner is applied to every column
+    for (size_t c = 0; c < K; c++)
+    {
+        ColumnView z_c = column(Z, N, c);
+        cusp::multiply(exec, M, column(R, N, c), z_c);
+    }
+
+    // P <- Z
+    thrust::copy(exec, Z.begin(), Z.begin() + N * K, P.begin());
+
+    // rz <- <R(:,c), Z(:,c)>, rr <- ||R(:,c)||^2
+    column_dotc_nrm2(exec, N, K, R, Z, dots, norms);
+    thrust::copy(dots.begin(),  dots.begin()  + K, rz.begin());
+    thrust::copy(norms.begin(), norms.begin() + K, rr.begin());
+
+    while (true)
+    {
+        // deflate the finished columns: the solution is stored and the
+        // last active column takes its place
+        for (size_t c = K; c-- > 0;)
+        {
+            if (!monitors[columns[c]].finished_norm(std::sqrt(rr[c])))
+                continue;
+
+            cusp::blas::copy(exec, column(Xw, N, c), X.column(columns[c]));
+
+            K--;
+
+            move_column(exec, N, Xw, K, c);
+            move_column(exec, N, R,  K, c);
+            move_column(exec, N, P,  K, c);
+
+            columns[c] = columns[K];
+            rz[c]      = rz[K];
+        }
+
+        if (K == 0)
+            break;
+
+        // Y <- A*P, A is read once for all active columns
+        BlockView Y_active = block(Y, N, K);
+        cusp::multiply(exec, A, block(P, N, K), Y_active);
+
+        // alpha <- <r,z>/<y,p>
+        column_dotc(exec, N, K, Y, P, dots);
+        thrust::copy(dots.begin(), dots.begin() + K, alpha.begin());
+
+        for (size_t c = 0; c < K; c++)
+            alpha[c] = rz[c] / alpha[c];
+
+        // X <- X + alpha * P
+        thrust::copy(alpha.begin(), alpha.begin() + K, coef.begin());
+        column_axpy(exec, N, K, P, Xw, coef);
+
+        // R <- R - alpha * Y
+        for (size_t c = 0; c < K; c++)
+            alpha[c] = -alpha[c];
+
+        thrust::copy(alpha.begin(), alpha.begin() + K, coef.begin());
+        column_axpy(exec, N, K, Y, R, coef);
+
+        // Z <- M*R
+        for (size_t c = 0; c < K; c++)
+        {
+            ColumnView z_c = column(Z, N, c);
+            cusp::multiply(exec, M, column(R, N, c), z_c);
+        }
+
+        // rz <- <R(:,c), Z(:,c)>, rr <- ||R(:,c)||^2 in a single pass
+        thrust::copy(rz.begin(), rz.begin() + K, rz_old.begin());
+
+        column_dotc_nrm2(exec, N, K, R, Z, dots, norms);
+        thrust::copy(dots.begin(),  dots.begin()  + K, rz.begin());
+        thrust::copy(norms.begin(), norms.begin() + K, rr.begin());
+
+        // beta <- <r_{i+1},z_{i+1}>/<r,z>
+        for (size_t c = 0; c < K; c++)
+            beta[c] = rz[c] / rz_old[c];
+
+        // P <- Z + beta * P
+        thrust::copy(beta.begin(), beta.begin() + K, coef.begin());
+        column_xpby(exec, N, K, Z, P, coef);
+
+        for (size_t c = 0; c < K; c++)
+            ++monitors[columns[c]];
+    }
+}
+
+} // end block_cg_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors,
+          typename Preconditioner>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B,
+                    Monitors& monitors,
+                    Preconditioner& M)
+{
+    using cusp::krylov::block_cg_detail::block_cg;
+
+    return block_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, X, B, monitors, M);
+}
+
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors,
+          typename Preconditioner>
+void block_cg(const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B,
+                    Monitors& monitors,
+                    Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d2::memory_space       System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::block_cg(select_system(system1,system2), A, X, B, monitors, M);
+}
+
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors>
+void block_cg(const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B,
+                    Monitors& monitors)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::block_cg(A, X, B, monitors, M);
+}
+
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2>
+void block_cg(const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    std::vector< cusp::monitor<ValueType> > monitors;
+
+    for (size_t c = 0; c < B.num_cols; c++)
+        monitors.push_back(cusp::monitor<ValueType>(B.column(c)));
+
+    return cusp::krylov::block_cg(A, X, B, monitors);
+}
+
+} // end namespace krylov
+} // end namespace cusp
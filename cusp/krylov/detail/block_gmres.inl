@@ -0,0 +1,396 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/linear_operator.h>
+#include <cusp/multiply.h>
+#include <cusp/monitor.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/krylov/gmres.h>
+#include <cusp/krylov/detail/block_utils.h>
+
+#include <thrust/copy.h>
+
+#include <cmath>
+#include <vector>
+
+namespace cusp
+{
+namespace krylov
+{
+namespace block_gmres_detail
+{
+
+// Solves the upper triangular system H(0:i,0:i) y = s(0:i) in place and
+// adds V(:,0:i) y to the column x.
+template <typename DerivedPolicy,
+          typename Array2d,
+          typename Array1,
+          typename Array2,
+          typename Array3>
+void update_solution(thrust::execution_policy<DerivedPolicy> &exec,
+                     const Array2d& H,
+                           Array1& s,
+                           Array2& V,
+                     const size_t N,
+                     const size_t block_size,
+                     const size_t c,
+                           Array3& x,
+                     const int i)
+{
+    using cusp::krylov::block_detail::column;
+
+    for (int j = i; j >= 0; j--) {
+        s[j] /= H(j, j);
+        // S(0:j) = s(0:j) - s[j] H(0:j,j)
+        for (int k = j - 1; k >= 0; k--) {
+            s[k] -= H(k, j) * s[j];
+        }
+    }
+
+    // x = V(0:i)*s(0:i) + x, column c of every block V(j)
+    for (int j = 0; j <= i; j++)
+        cusp::blas::axpy(exec, column(V, N, j * block_size + c), x, s[j]);
+}
+
+// Stores the solution of the active column c in X and removes c from the
+// active columns. The last active column takes its place in the blocks
+// Xw, Bw and the first num_blocks Arnoldi blocks of V.
+template <typename DerivedPolicy,
+          typename Array2d,
+          typename Array,
+          typename IndexArray>
+void deflate_column(thrust::execution_policy<DerivedPolicy> &exec,
+                          Array2d& X,
+                          Array& Xw,
+                          Array& Bw,
+                          Array& V,
+                    const size_t N,
+                    const size_t block_size,
+                    const int num_blocks,
+                          IndexArray& columns,
+                    const size_t c,
+                          size_t& num_active)
+{
+    using cusp::krylov::block_detail::column;
+    using cusp::krylov::block_detail::move_column;
+
+    cusp::blas::copy(exec, column(Xw, N, c), X.column(columns[c]));
+
+    const size_t last = --num_active;
+
+    move_column(exec, N, Xw, last, c);
+    move_column(exec, N, Bw, last, c);
+
+    for (int j = 0; j < num_blocks; j++)
+        move_column(exec, N, V, j * block_size + last, j * block_size + c);
+
+    columns[c] = columns[last];
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors,
+          typename Preconditioner>
+void block_gmres(thrust::execution_policy<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       Array2d1& X,
+                 const Array2d2& B,
+                 const size_t restart,
+                       Monitors& monitors,
+                       Preconditioner& M)
+{
+    using namespace cusp::krylov::block_detail;
+    using cusp::krylov::gmres_detail::PlaneRotation;
+
+    typedef typename LinearOperator::value_type           ValueType;
+    typedef typename cusp::norm_type<ValueType>::type     NormType;
+
+    typedef cusp::detail::temporary_array<ValueType, DerivedPolicy>   Workspace;
+    typedef cusp::array1d_view<typename Workspace::iterator>          ColumnView;
+    typedef cusp::array2d_view<ColumnView, cusp::column_major>        BlockView;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+    assert(B.num_rows == A.num_rows && X.num_rows == A.num_rows && X.num_cols == B.num_cols);
+
+    const size_t N = A.num_rows;
+    const size_t S = B.num_cols;
+    const int    R = restart;
+
+    if (S == 0)
+        return;
+
+    // allocate column-major workspace for all right-hand sides, the columns
+    // [0, K) are the columns still being iterated and column c of the
+    // workspace belongs to column columns[c] of X and B
+    Workspace Xw(exec, N * S);
+    Workspace Bw(exec, N * S);
+    Workspace W(exec, N * S);
+    // Arnoldi blocks, column c of block j is the j-th basis vector of
+    // column c and starts at (j * S + c) * N
+    Workspace V(exec, N * S * (R + 1));
+
+    // per-column scalars
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> coef(exec, S);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> dots(exec, S);
+    cusp::detail::temporary_array<NormType,  DerivedPolicy> norms(exec, S);
+
+    // HOST WORKSPACE, indexed by the column of B
+    std::vector< cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> > H(S);  // Hessenberg matrices
+    std::vector< cusp::array1d<ValueType, cusp::host_memory> > s(S);
+    std::vector< cusp::array1d<ValueType, cusp::host_memory> > cs(S);
+    std::vector< cusp::array1d<ValueType, cusp::host_memory> > sn(S);
+    cusp::array1d<ValueType, cusp::host_memory> h(S);
+    cusp::array1d<NormType,  cusp::host_memory> h_norms(S);
+    std::vector<size_t> columns(S);
+
+    for (size_t c = 0; c < S; c++)
+    {
+        H[c].resize(R + 1, R);
+        s[c].resize(R + 1);
+        cs[c].resize(R);
+        sn[c].resize(R);
+
+        columns[c] = c;
+
+        cusp::blas::copy(exec, X.column(c), column(Xw, N, c));
+        cusp::blas::copy(exec, B.column(c), column(Bw, N, c));
+    }
+
+    size_t K = S;
+
+    while (K > 0)
+    {
+        // compute initial residuals and their norms
+        BlockView W_block = block(W, N, K);
+        cusp::multiply(exec, A, block(Xw, N, K), W_block);                // W = A*X
+        ColumnView B_active = cusp::make_array1d_view(Bw.begin(), Bw.begin() + N * K);
+        cusp::blas::axpy(exec, B_active, W_block.values, ValueType(-1));  // W = W - B
+
+        for (size_t c = 0; c < K; c++)
+        {
+            ColumnView v_c = column(V, N, c);
+            cusp::multiply(exec, M, column(W, N, c), v_c);          // V(0) = M*W
+        }
+
+        column_nrm2(exec, N, K, V, norms);
+        thrust::copy(norms.begin(), norms.begin() + K, h_norms.begin());
+
+        for (size_t c = K; c-- > 0;)
+        {
+            const size_t j = columns[c];
+            const NormType beta = std::sqrt(h_norms[c]);
+
+            cusp::blas::fill(s[j], ValueType(0.0));
+            s[j][0] = beta;
+
+            if (monitors[j].finished_norm(cusp::abs(s[j][0])))
+            {
+                deflate_column(exec, X, Xw, Bw, V, N, S, 1, columns, c, K);
+                h[c] = h[K];
+            }
+            else
+            {
+                h[c] = ValueType(-1.0 / beta);
+            }
+        }
+
+        if (K == 0)
+            break;
+
+        // V(0) = -V(0)/beta
+        thrust::copy(h.begin(), h.begin() + K, coef.begin());
+        column_scal(exec, N, K, V, coef);
+
+        int i = -1;
+
+        do
+        {
+            ++i;
+
+            for (size_t c = 0; c < K; c++)
+                ++monitors[columns[c]];
+
+            typename Workspace::iterator V_i    = V.begin() + i * S * N;
+            typename Workspace::iterator V_next = V.begin() + (i + 1) * S * N;
+
+            // W = A*V(i), A is read once for all active columns
+            BlockView V_block = cusp::make_array2d_view(N, K, N, cusp::make_array1d_view(V_i, V_i + N * K), cusp::column_major());
+            BlockView W_active = block(W, N, K);
+            cusp::multiply(exec, A, V_block, W_active);
+
+            // V(i+1) = M*W = M*A*V(i)
+            for (size_t c = 0; c < K; c++)
+            {
+                ColumnView v_c = cusp::make_array1d_view(V_next + c * N, V_next + (c + 1) * N);
+                cusp::multiply(exec, M, column(W, N, c), v_c);
+            }
+
+            ColumnView V_next_view = cusp::make_array1d_view(V_next, V_next + N * K);
+
+            for (int k = 0; k <= i; k++)
+            {
+                ColumnView V_k = cusp::make_array1d_view(V.begin() + k * S * N, V.begin() + k * S * N + N * K);
+
+                //  H(k,i) = <V(i+1),V(k)>
+                column_dotc(exec, N, K, V_k, V_next_view, dots);
+                thrust::copy(dots.begin(), dots.begin() + K, h.begin());
+
+                for (size_t c = 0; c < K; c++)
+                {
+                    H[columns[c]](k, i) = h[c];
+                    h[c] = -h[c];
+                }
+
+                // V(i+1) -= H(k, i) * V(k)
+                thrust::copy(h.begin(), h.begin() + K, coef.begin());
+                column_axpy(exec, N, K, V_k, V_next_view, coef);
+            }
+
+            column_nrm2(exec, N, K, V_next_view, norms);
+            thrust::copy(norms.begin(), norms.begin() + K, h_norms.begin());
+
+            // V(i+1) = V(i+1) / H(i+1, i), a zero norm means the column
+            // has converged and its basis vector is never used
+            for (size_t c = 0; c < K; c++)
+            {
+                const NormType h_next = std::sqrt(h_norms[c]);
+
+                H[columns[c]](i + 1, i) = h_next;
+                h[c] = h_next == NormType(0) ? ValueType(0) : ValueType(1.0 / h_next);
+            }
+
+            thrust::copy(h.begin(), h.begin() + K, coef.begin());
+            column_scal(exec, N, K, V_next_view, coef);
+
+            // check the convergence of every column, finished columns are
+            // updated and deflated
+            for (size_t c = K; c-- > 0;)
+            {
+                const size_t j = columns[c];
+
+                PlaneRotation(H[j], cs[j], sn[j], s[j], i);
+
+                if (monitors[j].finished_norm(cusp::abs(s[j][i + 1])))
+                {
+                    ColumnView x_c = column(Xw, N, c);
+                    update_solution(exec, H[j], s[j], V, N, S, c, x_c, i);
+
+                    deflate_column(exec, X, Xw, Bw, V, N, S, i + 2, columns, c, K);
+                }
+            }
+        }
+        while (K > 0 && i + 1 < R);
+
+        // update the solutions of the columns still being iterated
+        for (size_t c = 0; c < K; c++)
+        {
+            ColumnView x_c = column(Xw, N, c);
+            update_solution(exec, H[columns[c]], s[columns[c]], V, N, S, c, x_c, i);
+        }
+    }
+}
+
+} // end block_gmres_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors,
+          typename Preconditioner>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       Array2d1& X,
+                 const Array2d2& B,
+                 const size_t restart,
+                       Monitors& monitors,
+                       Preconditioner& M)
+{
+    using cusp::krylov::block_gmres_detail::block_gmres;
+
+    return block_gmres(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, X, B, restart, monitors, M);
+}
+
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors,
+          typename Preconditioner>
+void block_gmres(const LinearOperator& A,
+                       Array2d1& X,
+                 const Array2d2& B,
+                 const size_t restart,
+                       Monitors& monitors,
+                       Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d1::memory_space       System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::block_gmres(select_system(system1,system2), A, X, B, restart, monitors, M);
+}
+
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitors>
+void block_gmres(const LinearOperator& A,
+                       Array2d1& X,
+                 const Array2d2& B,
+                 const size_t restart,
+                       Monitors& monitors)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::block_gmres(A, X, B, restart, monitors, M);
+}
+
+template <typename LinearOperator,
+          typename Array2d1,
+          typename Array2d2>
+void block_gmres(const LinearOperator& A,
+                       Array2d1& X,
+                 const Array2d2& B,
+                 const size_t restart)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    std::vector< cusp::monitor<ValueType> > monitors;
+
+    for (size_t c = 0; c < B.num_cols; c++)
+        monitors.push_back(cusp::monitor<ValueType>(B.column(c)));
+
+    return cusp::krylov::block_gmres(A, X, B, restart, monitors);
+}
+
+} // end namespace krylov
+} // end namespace cusp
@@ -0,0 +1,251 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/functional.h>
+
+#include <cusp/blas/blas.h>
+
+#include <thrust/copy.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+/*
+ * Helpers shared by the block Krylov solvers. A block of num_cols vectors
+ * of length num_rows is stored column-major in a flat array, so column c
+ * occupies [c * num_rows, (c + 1) * num_rows). Every helper performs one
+ * pass over the block with a separate scalar for every column, and only
+ * the leading num_cols columns (the columns still being iterated) are
+ * touched.
+ */
+
+namespace cusp
+{
+namespace krylov
+{
+namespace block_detail
+{
+
+typedef thrust::transform_iterator< cusp::divide_value<size_t>, thrust::counting_iterator<size_t> > ColumnIndexIterator;
+
+// maps entry n of a column-major block to its column n / num_rows
+inline ColumnIndexIterator column_index_begin(const size_t num_rows)
+{
+    return ColumnIndexIterator(thrust::counting_iterator<size_t>(0), cusp::divide_value<size_t>(num_rows));
+}
+
+// view of column c of a column-major block
+template <typename Array>
+typename cusp::array1d_view<typename Array::iterator>
+column(Array& X, const size_t num_rows, const size_t c)
+{
+    return cusp::make_array1d_view(X.begin() + c * num_rows, X.begin() + (c + 1) * num_rows);
+}
+
+// view of the leading num_cols columns of a column-major block as array2d
+template <typename Array>
+cusp::array2d_view<typename cusp::array1d_view<typename Array::iterator>, cusp::column_major>
+block(Array& X, const size_t num_rows, const size_t num_cols)
+{
+    return cusp::make_array2d_view(num_rows, num_cols, num_rows,
+                                   cusp::make_array1d_view(X.begin(), X.begin() + num_rows * num_cols),
+                                   cusp::column_major());
+}
+
+template <typename ValueType>
+struct KERNEL_DOTC
+{
+    template <typename Tuple>
+    __host__ __device__
+    ValueType operator()(const Tuple& t) const
+    {
+        return cusp::conj(ValueType(thrust::get<0>(t))) * ValueType(thrust::get<1>(t));
+    }
+};
+
+template <typename ValueType>
+struct KERNEL_DOTC_NRM2
+{
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef thrust::tuple<ValueType,NormType>         ResultType;
+
+    template <typename Tuple>
+    __host__ __device__
+    ResultType operator()(const Tuple& t) const
+    {
+        const ValueType x = thrust::get<0>(t);
+        const ValueType y = thrust::get<1>(t);
+
+        return ResultType(cusp::conj(x) * y, cusp::abs_squared_functor<ValueType>()(x));
+    }
+};
+
+template <typename ValueType>
+struct KERNEL_DOTC_NRM2_SUM
+{
+    typedef typename KERNEL_DOTC_NRM2<ValueType>::ResultType ResultType;
+
+    __host__ __device__
+    ResultType operator()(const ResultType& a, const ResultType& b) const
+    {
+        return ResultType(thrust::get<0>(a) + thrust::get<0>(b),
+                          thrust::get<1>(a) + thrust::get<1>(b));
+    }
+};
+
+// y <- y + alpha * x for the tuple (x, y, alpha)
+struct KERNEL_AXPY
+{
+    template <typename Tuple>
+    __host__ __device__
+    void operator()(Tuple t)
+    {
+        thrust::get<1>(t) += thrust::get<2>(t) * thrust::get<0>(t);
+    }
+};
+
+// y <- x + beta * y for the tuple (x, y, beta)
+struct KERNEL_XPBY
+{
+    template <typename Tuple>
+    __host__ __device__
+    void operator()(Tuple t)
+    {
+        thrust::get<1>(t) = thrust::get<0>(t) + thrust::get<2>(t) * thrust::get<1>(t);
+    }
+};
+
+// dots[c] <- <X(:,c), Y(:,c)>
+template <typename DerivedPolicy, typename Array1, typename Array2, typename Array3>
+void column_dotc(thrust::execution_policy<DerivedPolicy>& exec,
+                 const size_t num_rows, const size_t num_cols,
+                 const Array1& X, const Array2& Y, Array3& dots)
+{
+    typedef typename Array3::value_type ValueType;
+
+    thrust::reduce_by_key(exec,
+                          column_index_begin(num_rows),
+                          column_index_begin(num_rows) + num_rows * num_cols,
+                          thrust::make_transform_iterator(thrust::make_zip_iterator(thrust::make_tuple(X.begin(), Y.begin())),
+                                                          KERNEL_DOTC<ValueType>()),
+                          thrust::make_discard_iterator(),
+                          dots.begin());
+}
+
+// dots[c] <- <X(:,c), Y(:,c)> and norms[c] <- ||X(:,c)||^2 in a single pass
+template <typename DerivedPolicy, typename Array1, typename Array2, typename Array3, typename Array4>
+void column_dotc_nrm2(thrust::execution_policy<DerivedPolicy>& exec,
+                      const size_t num_rows, const size_t num_cols,
+                      const Array1& X, const Array2& Y, Array3& dots, Array4& norms)
+{
+    typedef typename Array3::value_type ValueType;
+
+    thrust::reduce_by_key(exec,
+                          column_index_begin(num_rows),
+                          column_index_begin(num_rows) + num_rows * num_cols,
+                          thrust::make_transform_iterator(thrust::make_zip_iterator(thrust::make_tuple(X.begin(), Y.begin())),
+                                                          KERNEL_DOTC_NRM2<ValueType>()),
+                          thrust::make_discard_iterator(),
+                          thrust::make_zip_iterator(thrust::make_tuple(dots.begin(), norms.begin())),
+                          thrust::equal_to<size_t>(),
+                          KERNEL_DOTC_NRM2_SUM<ValueType>());
+}
+
+// norms[c] <- ||X(:,c)||^2
+template <typename DerivedPolicy, typename Array1, typename Array2>
+void column_nrm2(thrust::execution_policy<DerivedPolicy>& exec,
+                 const size_t num_rows, const size_t num_cols,
+                 const Array1& X, Array2& norms)
+{
+    typedef typename Array1::value_type ValueType;
+
+    thrust::reduce_by_key(exec,
+                          column_index_begin(num_rows),
+                          column_index_begin(num_rows) + num_rows * num_cols,
+                          thrust::make_transform_iterator(X.begin(), cusp::abs_squared_functor<ValueType>()),
+                          thrust::make_discard_iterator(),
+                          norms.begin());
+}
+
+// Y(:,c) <- Y(:,c) + alpha[c] * X(:,c)
+template <typename DerivedPolicy, typename Array1, typename Array2, typename Array3>
+void column_axpy(thrust::execution_policy<DerivedPolicy>& exec,
+                 const size_t num_rows, const size_t num_cols,
+                 const Array1& X, Array2& Y, const Array3& alpha)
+{
+    thrust::for_each(exec,
+                     thrust::make_zip_iterator(thrust::make_tuple(X.begin(), Y.begin(),
+                                               thrust::make_permutation_iterator(alpha.begin(), column_index_begin(num_rows)))),
+                     thrust::make_zip_iterator(thrust::make_tuple(X.begin(), Y.begin(),
+                                               thrust::make_permutation_iterator(alpha.begin(), column_index_begin(num_rows)))) + num_rows * num_cols,
+                     KERNEL_AXPY());
+}
+
+// Y(:,c) <- X(:,c) + beta[c] * Y(:,c)
+template <typename DerivedPolicy, typename Array1, typename Array2, typename Array3>
+void column_xpby(thrust::execution_policy<DerivedPolicy>& exec,
+                 const size_t num_rows, const size_t num_cols,
+                 const Array1& X, Array2& Y, const Array3& beta)
+{
+    thrust::for_each(exec,
+                     thrust::make_zip_iterator(thrust::make_tuple(X.begin(), Y.begin(),
+                                               thrust::make_permutation_iterator(beta.begin(), column_index_begin(num_rows)))),
+                     thrust::make_zip_iterator(thrust::make_tuple(X.begin(), Y.begin(),
+                                               thrust::make_permutation_iterator(beta.begin(), column_index_begin(num_rows)))) + num_rows * num_cols,
+                     KERNEL_XPBY());
+}
+
+// X(:,c) <- alpha[c] * X(:,c)
+template <typename DerivedPolicy, typename Array1, typename Array2>
+void column_scal(thrust::execution_policy<DerivedPolicy>& exec,
+                 const size_t num_rows, const size_t num_cols,
+                 Array1& X, const Array2& alpha)
+{
+    thrust::transform(exec,
+                      X.begin(), X.begin() + num_rows * num_cols,
+                      thrust::make_permutation_iterator(alpha.begin(), column_index_begin(num_rows)),
+                      X.begin(),
+                      thrust::multiplies<typename Array1::value_type>());
+}
+
+// Deflation: moves column src of the block X to column dst
+template <typename DerivedPolicy, typename Array>
+void move_column(thrust::execution_policy<DerivedPolicy>& exec,
+                 const size_t num_rows, Array& X,
+                 const size_t src, const size_t dst)
+{
+    if(src != dst)
+        thrust::copy(exec, X.begin() + src * num_rows, X.begin() + (src + 1) * num_rows, X.begin() + dst * num_rows);
+}
+
+} // end block_detail namespace
+} // end namespace krylov
+} // end namespace cusp
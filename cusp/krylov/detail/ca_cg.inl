@@ -0,0 +1,470 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/exception.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/krylov/detail/block_utils.h>
+#include <cusp/krylov/detail/s_step_utils.h>
+
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+
+#include <algorithm>
+#include <cmath>
+
+/*
+ * Communication-avoiding Conjugate Gradient as described in
+ *
+ *     Avoiding communication in nonsymmetric Lanczos-based Krylov
+ *     subspace methods
+ *     E. Carson, N. Knight and J. Demmel
+ *     SIAM J. Sci. Comput. 35 (2013)
+ *
+ * Every outer iteration builds the bases of the s-step Krylov spaces of
+ * p and z, computes their Gram matrix in one pass over the bases and
+ * performs s iterations of CG on the coordinates of the vectors in these
+ * bases. A second pass over the bases updates all vectors. The
+ * preconditioned variant keeps the bases of M*A and of A*M, which differ
+ * by an application of M, so the Gram matrix is symmetric.
+ */
+
+namespace cusp
+{
+namespace krylov
+{
+namespace ca_cg_detail
+{
+
+// Y(first + i) = rho_i(M*A) v and Y(m + first + i) = rho_i(A*M) vt for
+// i = 0..count with vt = M^{-1} v. The recurrence runs on vt, so every
+// vector costs one application of A and one of M.
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Preconditioner,
+          typename WorkspaceType,
+          typename VectorType1,
+          typename VectorType2,
+          typename HostArray>
+void matrix_powers(thrust::execution_policy<DerivedPolicy> &exec,
+                   const LinearOperator& A,
+                         Preconditioner& M,
+                         WorkspaceType& Y,
+                   const size_t N,
+                   const size_t m,
+                   const size_t first,
+                   const size_t count,
+                   const VectorType1& v,
+                   const VectorType2& vt,
+                   const HostArray& theta,
+                         HostArray& sigma,
+                   const HostArray& mu,
+                   const bool estimate)
+{
+    using cusp::krylov::block_detail::column;
+
+    typedef typename WorkspaceType::value_type                         ValueType;
+    typedef typename cusp::array1d_view<typename WorkspaceType::iterator> ColumnView;
+
+    blas::copy(exec, v,  column(Y, N, first));
+    blas::copy(exec, vt, column(Y, N, m + first));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ColumnView src  = column(Y, N, first + i);
+        ColumnView dual = column(Y, N, m + first + i + 1);
+        ColumnView dst  = column(Y, N, first + i + 1);
+
+        // A*M*vt_i
+        cusp::multiply(exec, A, src, dual);
+
+        if (estimate)
+        {
+            sigma[i] = blas::nrm2(exec, dual);
+
+            if (sigma[i] == ValueType(0))
+                sigma[i] = ValueType(1);
+        }
+        else
+        {
+            blas::axpy(exec, column(Y, N, m + first + i), dual, -theta[i]);
+
+            if (i > 0)
+                blas::axpy(exec, column(Y, N, m + first + i - 1), dual, -mu[i]);
+        }
+
+        blas::scal(exec, dual, ValueType(1) / sigma[i]);
+
+        cusp::multiply(exec, M, dual, dst);
+    }
+}
+
+// u^T G(:, offset:offset+n) v
+template <typename HostMatrix, typename HostArray>
+typename HostArray::value_type
+quadratic_form(const HostMatrix& G,
+               const HostArray& u,
+               const HostArray& v,
+               const size_t n,
+               const size_t offset)
+{
+    typedef typename HostArray::value_type ValueType;
+
+    ValueType sum = 0;
+
+    for (size_t j = 0; j < n; j++)
+    {
+        ValueType Gv = 0;
+
+        for (size_t i = 0; i < n; i++)
+            Gv += u[i] * G(i, offset + j);
+
+        sum += Gv * v[j];
+    }
+
+    return sum;
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_cg(thrust::execution_policy<DerivedPolicy> &exec,
+           const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s,
+           const s_step_basis basis,
+                 Monitor& monitor,
+                 Preconditioner& M)
+{
+    using cusp::krylov::block_detail::column;
+    using cusp::krylov::s_step_detail::basis_coefficients;
+    using cusp::krylov::s_step_detail::block_combine;
+    using cusp::krylov::s_step_detail::block_gram;
+    using cusp::krylov::s_step_detail::gershgorin_interval;
+    using cusp::krylov::s_step_detail::gram_chunks;
+
+    typedef typename LinearOperator::value_type                                 ValueType;
+    typedef typename cusp::norm_type<ValueType>::type                           NormType;
+    typedef typename cusp::minimum_space<
+    typename LinearOperator::memory_space, typename VectorType1::memory_space,
+             typename Preconditioner::memory_space>::type                       MemorySpace;
+    typedef cusp::detail::temporary_array<ValueType, DerivedPolicy>             Workspace;
+    typedef typename cusp::array1d_view<typename Workspace::iterator>           ColumnView;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major>           SmallMatrix;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major>     HostMatrix;
+    typedef cusp::array1d<ValueType, cusp::host_memory>                         HostArray;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+
+    if (s == 0)
+        throw cusp::invalid_input_exception("s must be positive");
+
+    const size_t N = A.num_rows;
+    // the basis of p has s + 1 vectors and the basis of z has s vectors
+    const size_t m = 2 * s + 1;
+
+    // allocate workspace
+    // bases of M*A in columns [0, m) and of A*M in columns [m, 2m)
+    Workspace Y(exec, N * 2 * m);
+    // dx, z, p, r and pt, written together by the update of every outer
+    // iteration
+    Workspace T(exec, N * 5);
+    // partial Gram matrices of block_gram
+    Workspace partial(exec, gram_chunks(N) * m * 2 * m);
+
+    ColumnView dx = column(T, N, 0);
+    ColumnView z  = column(T, N, 1);
+    ColumnView p  = column(T, N, 2);
+    ColumnView r  = column(T, N, 3);
+    ColumnView pt = column(T, N, 4);     // M^{-1} p
+
+    SmallMatrix Gd(m, 2 * m);
+    SmallMatrix Kd(2 * m, 5);
+
+    // HOST WORKSPACE
+    HostMatrix G(m, 2 * m);     // Y_AM^T [Y_MA Y_AM]
+    HostMatrix B(m, m);         // change of basis, M*A Y_MA = Y_MA B
+    HostMatrix K(2 * m, 5);
+    HostMatrix L(s, s);         // Lanczos matrix of the first outer iteration
+    HostArray xc(m);
+    HostArray zc(m);
+    HostArray pc(m);
+    HostArray Bp(m);
+    HostArray theta(s);
+    HostArray sigma_p(s);
+    HostArray sigma_z(s);
+    HostArray mu(s);
+    HostArray alpha(s);
+    HostArray beta(s);
+
+    // spectral estimate of M*A for the bases, taken from the Lanczos
+    // matrix of the first outer iteration
+    bool have_interval = false;
+    NormType lambda_min = 0;
+    NormType lambda_max = 0;
+
+    // r <- b - A*x, z <- M*r, p <- z, pt <- r, dx holds A*x until the
+    // first update overwrites it
+    cusp::multiply(exec, A, x, dx);
+    blas::axpby(exec, b, dx, r, ValueType(1), ValueType(-1));
+    cusp::multiply(exec, M, r, z);
+    blas::copy(exec, z, p);
+    blas::copy(exec, r, pt);
+
+    NormType norm = blas::nrm2(exec, r);
+
+    while (!monitor.finished_norm(norm))
+    {
+        // until the spectrum is estimated every vector is normalized,
+        // which costs one reduction per vector
+        const bool estimate = !have_interval;
+
+        if (estimate)
+        {
+            thrust::fill(theta.begin(), theta.end(), ValueType(0));
+            thrust::fill(mu.begin(), mu.end(), ValueType(0));
+        }
+        else
+        {
+            basis_coefficients(basis, s, lambda_min, lambda_max, theta, sigma_p, mu);
+            sigma_z = sigma_p;
+        }
+
+        matrix_powers(exec, A, M, Y, N, m, 0,     s,     p, pt, theta, sigma_p, mu, estimate);
+        matrix_powers(exec, A, M, Y, N, m, s + 1, s - 1, z, r,  theta, sigma_z, mu, estimate);
+
+        // [G G2] = Y_AM^T [Y_MA Y_AM] in one pass over Y, G gives the
+        // M^{-1} inner products of the coordinates and G2 the residual norm
+        block_gram(exec, N, Y, m, m, Y, 0, 2 * m, partial, Gd);
+
+        thrust::copy(Gd.values.begin(), Gd.values.end(), G.values.begin());
+
+        thrust::fill(B.values.begin(), B.values.end(), ValueType(0));
+
+        for (size_t i = 0; i < s; i++)
+        {
+            B(i, i)     = theta[i];
+            B(i + 1, i) = sigma_p[i];
+
+            if (i > 0)
+                B(i - 1, i) = mu[i];
+        }
+
+        for (size_t i = 0, o = s + 1; i + 1 < s; i++)
+        {
+            B(o + i, o + i)     = theta[i];
+            B(o + i + 1, o + i) = sigma_z[i];
+
+            if (i > 0)
+                B(o + i - 1, o + i) = mu[i];
+        }
+
+        // coordinates of x - x_0, z and p
+        thrust::fill(xc.begin(), xc.end(), ValueType(0));
+        thrust::fill(zc.begin(), zc.end(), ValueType(0));
+        thrust::fill(pc.begin(), pc.end(), ValueType(0));
+        pc[0]     = ValueType(1);
+        zc[s + 1] = ValueType(1);
+
+        ValueType rz = quadratic_form(G, zc, zc, m, 0);
+        size_t steps = 0;
+
+        for (size_t j = 0; j < s; j++)
+        {
+            for (size_t i = 0; i < m; i++)
+            {
+                Bp[i] = ValueType(0);
+
+                for (size_t l = 0; l < m; l++)
+                    Bp[i] += B(i, l) * pc[l];
+            }
+
+            const ValueType pAp = quadratic_form(G, pc, Bp, m, 0);
+
+            if (pAp == ValueType(0))
+                break;
+
+            alpha[j] = rz / pAp;
+
+            for (size_t i = 0; i < m; i++)
+            {
+                xc[i] += alpha[j] * pc[i];
+                zc[i] -= alpha[j] * Bp[i];
+            }
+
+            const ValueType rz_old = rz;
+            rz = quadratic_form(G, zc, zc, m, 0);
+            beta[j] = rz / rz_old;
+
+            for (size_t i = 0; i < m; i++)
+                pc[i] = zc[i] + beta[j] * pc[i];
+
+            steps = j + 1;
+
+            ++monitor;
+
+            // ||r|| from G2, only used to stop the inner iterations early
+            const NormType estimated_norm = std::sqrt(std::max(NormType(0), NormType(quadratic_form(G, zc, zc, m, m))));
+
+            if (estimated_norm <= monitor.tolerance() || monitor.iteration_count() >= monitor.iteration_limit())
+                break;
+        }
+
+        // no progress is possible
+        if (steps == 0)
+            break;
+
+        // [dx z p r pt] = [Y_MA Y_AM] K in one pass over Y, the old vectors
+        // are only read through their copies in Y
+        thrust::fill(K.values.begin(), K.values.end(), ValueType(0));
+
+        for (size_t i = 0; i < m; i++)
+        {
+            K(i, 0)     = xc[i];
+            K(i, 1)     = zc[i];
+            K(i, 2)     = pc[i];
+            K(m + i, 3) = zc[i];
+            K(m + i, 4) = pc[i];
+        }
+
+        thrust::copy(K.values.begin(), K.values.end(), Kd.values.begin());
+
+        block_combine(exec, N, Y, 0, 2 * m, Kd, T, 0, 5);
+
+        blas::axpy(exec, dx, x, ValueType(1));
+
+        if (estimate)
+        {
+            // Lanczos matrix of M*A from the CG coefficients
+            thrust::fill(L.values.begin(), L.values.end(), ValueType(0));
+
+            for (size_t j = 0; j < steps; j++)
+            {
+                L(j, j) = ValueType(1) / alpha[j];
+
+                if (j > 0)
+                    L(j, j) += beta[j - 1] / alpha[j - 1];
+
+                if (j + 1 < steps)
+                    L(j, j + 1) = L(j + 1, j) = std::sqrt(beta[j]) / alpha[j];
+            }
+
+            gershgorin_interval(L, steps, lambda_min, lambda_max);
+
+            // M*A is positive-definite
+            lambda_min = std::max(lambda_min, NormType(0));
+            have_interval = true;
+        }
+
+        norm = blas::nrm2(exec, r);
+    }
+}
+
+} // end ca_cg_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+           const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s,
+           const s_step_basis basis,
+                 Monitor& monitor,
+                 Preconditioner& M)
+{
+    using cusp::krylov::ca_cg_detail::ca_cg;
+
+    return ca_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                 A, x, b, s, basis, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_cg(const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s,
+           const s_step_basis basis,
+                 Monitor& monitor,
+                 Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType2::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::ca_cg(select_system(system1,system2), A, x, b, s, basis, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void ca_cg(const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s,
+                 Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::ca_cg(A, x, b, s, newton_basis, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void ca_cg(const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    return cusp::krylov::ca_cg(A, x, b, s, monitor);
+}
+
+} // end namespace krylov
+} // end namespace cusp
@@ -0,0 +1,480 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/exception.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/krylov/gmres.h>
+#include <cusp/krylov/detail/block_utils.h>
+#include <cusp/krylov/detail/s_step_utils.h>
+
+#include <thrust/copy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*
+ * Communication-avoiding GMRES as described in
+ *
+ *     Communication-avoiding Krylov subspace methods
+ *     M. Hoemmen, PhD thesis, UC Berkeley (2010)
+ *
+ * Every restart cycle grows the Krylov basis by blocks of s vectors. A
+ * block is generated by s applications of M*A without any reduction, its
+ * projection on the previous basis and its Gram matrix come from one pass
+ * over the basis, and the block is orthonormalized by a Cholesky
+ * factorization of that Gram matrix and a second pass. The columns of the
+ * Hessenberg matrix follow from the change of basis matrix of the
+ * polynomial basis.
+ */
+
+namespace cusp
+{
+namespace krylov
+{
+namespace ca_gmres_detail
+{
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_gmres(thrust::execution_policy<DerivedPolicy> &exec,
+              const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s,
+              const s_step_basis basis,
+                    Monitor& monitor,
+                    Preconditioner& M)
+{
+    using cusp::krylov::block_detail::column;
+    using cusp::krylov::gmres_detail::PlaneRotation;
+    using cusp::krylov::s_step_detail::basis_coefficients;
+    using cusp::krylov::s_step_detail::block_combine;
+    using cusp::krylov::s_step_detail::block_gram;
+    using cusp::krylov::s_step_detail::cholesky_upper;
+    using cusp::krylov::s_step_detail::gershgorin_interval;
+    using cusp::krylov::s_step_detail::gram_chunks;
+    using cusp::krylov::s_step_detail::invert_upper;
+
+    typedef typename LinearOperator::value_type                                 ValueType;
+    typedef typename cusp::norm_type<ValueType>::type                           NormType;
+    typedef typename cusp::minimum_space<
+    typename LinearOperator::memory_space, typename VectorType1::memory_space,
+             typename Preconditioner::memory_space>::type                       MemorySpace;
+    typedef cusp::detail::temporary_array<ValueType, DerivedPolicy>             Workspace;
+    typedef typename cusp::array1d_view<typename Workspace::iterator>           ColumnView;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major>           SmallMatrix;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major>     HostMatrix;
+    typedef cusp::array1d<ValueType, cusp::host_memory>                         HostArray;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+
+    if (restart == 0 || s == 0)
+        throw cusp::invalid_input_exception("restart and s must be positive");
+
+    const size_t N = A.num_rows;
+    const size_t R = restart;
+    const size_t S = std::min(s, restart);
+
+    // a new basis vector whose component orthogonal to the previous ones
+    // has a relative squared norm below this is numerically dependent
+    const NormType breakdown_tolerance = std::sqrt(std::numeric_limits<NormType>::epsilon());
+
+    // allocate workspace
+    Workspace w(exec, N);
+    // Krylov basis
+    Workspace V(exec, N * (R + 1));
+    // new basis vectors and update of x
+    Workspace T(exec, N * S);
+    // partial Gram matrices of block_gram
+    Workspace partial(exec, gram_chunks(N) * (R + 1) * S);
+
+    // Gram matrix and update coefficients in the memory space of the basis
+    SmallMatrix Gd(R + 1, S);
+    SmallMatrix Kd(R + 1, S);
+
+    // HOST WORKSPACE
+    HostMatrix G(R + 1, S);         // [Q W]^T W
+    HostMatrix K(R + 1, S);         // coefficients of the new basis vectors
+    HostMatrix Gw(S, S);            // Gram matrix of W orthogonalized against Q
+    HostMatrix Rb(S, S);            // Cholesky factor of Gw
+    HostMatrix Rinv(S, S);
+    HostMatrix Rh(R + 1, S + 1);    // [q_last W] in the new basis
+    HostMatrix Y(R + 1, S);
+    HostMatrix H(R + 1, R);         // Hessenberg matrix
+    HostMatrix Hr(R + 1, R);        // Hessenberg matrix reduced by plane rotations
+    HostArray g(R + 1);
+    HostArray cs(R);
+    HostArray sn(R);
+    HostArray theta(S);
+    HostArray sigma(S);
+    HostArray mu(S);
+
+    // spectral estimate of M*A for the basis, taken from the first block
+    bool have_interval = false;
+    NormType lambda_min = 0;
+    NormType lambda_max = 0;
+
+    while (true)
+    {
+        // V(0) = M*(b - A*x)
+        ColumnView v0 = column(V, N, 0);
+
+        cusp::multiply(exec, A, x, w);
+        blas::axpby(exec, b, w, w, ValueType(1), ValueType(-1));
+        cusp::multiply(exec, M, w, v0);
+
+        const NormType beta = blas::nrm2(exec, v0);
+
+        if (monitor.finished_norm(beta))
+            break;
+
+        blas::scal(exec, v0, ValueType(1) / beta);
+
+        thrust::fill(g.begin(), g.end(), ValueType(0));
+        thrust::fill(H.values.begin(), H.values.end(), ValueType(0));
+        thrust::fill(Hr.values.begin(), Hr.values.end(), ValueType(0));
+        g[0] = beta;
+
+        size_t n = 1;   // number of basis vectors
+        size_t k = 0;   // number of Hessenberg columns
+        bool done = false;
+
+        while (!done && k < R)
+        {
+            size_t sb = std::min(S, R - k);
+
+            // until the spectrum is estimated every vector is normalized,
+            // which costs one reduction per vector
+            const bool estimate = !have_interval;
+
+            if (estimate)
+            {
+                thrust::fill(theta.begin(), theta.end(), ValueType(0));
+                thrust::fill(mu.begin(), mu.end(), ValueType(0));
+            }
+            else
+            {
+                basis_coefficients(basis, sb, lambda_min, lambda_max, theta, sigma, mu);
+            }
+
+            // matrix powers, W(i+1) = (M*A*W(i) - theta_i W(i) - mu_i W(i-1)) / sigma_i
+            // with W(0) the last basis vector
+            for (size_t i = 0; i < sb; i++)
+            {
+                ColumnView src = column(V, N, n - 1 + i);
+                ColumnView dst = column(V, N, n + i);
+
+                cusp::multiply(exec, A, src, w);
+                cusp::multiply(exec, M, w, dst);
+
+                if (estimate)
+                {
+                    sigma[i] = blas::nrm2(exec, dst);
+
+                    if (sigma[i] == ValueType(0))
+                    {
+                        sb = i;
+                        break;
+                    }
+                }
+                else
+                {
+                    blas::axpy(exec, src, dst, -theta[i]);
+
+                    if (i > 0)
+                        blas::axpy(exec, column(V, N, n - 2 + i), dst, -mu[i]);
+                }
+
+                blas::scal(exec, dst, ValueType(1) / sigma[i]);
+            }
+
+            if (sb == 0)
+                break;
+
+            // G = [Q W]^T W in one pass over [Q W]
+            block_gram(exec, N, V, 0, n + sb, V, n, sb, partial, Gd);
+
+            thrust::copy(Gd.values.begin(), Gd.values.end(), G.values.begin());
+
+            // Gram matrix of W - Q C with C = Q^T W
+            for (size_t j = 0; j < sb; j++)
+            {
+                for (size_t i = 0; i < sb; i++)
+                {
+                    ValueType v = G(n + i, j);
+
+                    for (size_t l = 0; l < n; l++)
+                        v -= G(l, i) * G(l, j);
+
+                    Gw(i, j) = v;
+                }
+            }
+
+            const size_t p = cholesky_upper(Gw, Rb, sb, breakdown_tolerance);
+
+            // W(0) lies in the span of Q, the Krylov space is invariant and
+            // only the Hessenberg column of the last basis vector is new
+            const bool invariant = (p == 0);
+            const size_t num_new = invariant ? 1 : p;
+
+            if (!invariant)
+            {
+                // Q_new = (W - Q C) Rb^{-1} = [Q W] K in one pass over [Q W]
+                invert_upper(Rb, Rinv, p);
+
+                for (size_t j = 0; j < p; j++)
+                {
+                    for (size_t l = 0; l < n; l++)
+                    {
+                        ValueType v = 0;
+
+                        for (size_t i = 0; i <= j; i++)
+                            v += G(l, i) * Rinv(i, j);
+
+                        K(l, j) = -v;
+                    }
+
+                    for (size_t i = 0; i < p; i++)
+                        K(n + i, j) = i <= j ? Rinv(i, j) : ValueType(0);
+                }
+
+                thrust::copy(K.values.begin(), K.values.end(), Kd.values.begin());
+
+                block_combine(exec, N, V, 0, n + p, Kd, T, 0, p);
+
+                thrust::copy(exec, T.begin(), T.begin() + N * p, V.begin() + N * n);
+            }
+
+            // [q_last W] = [Q Q_new] Rh
+            const size_t rows = n + num_new;
+
+            for (size_t j = 0; j <= num_new; j++)
+            {
+                for (size_t l = 0; l < rows; l++)
+                {
+                    if (j == 0)
+                        Rh(l, j) = l == n - 1 ? ValueType(1) : ValueType(0);
+                    else if (l < n)
+                        Rh(l, j) = G(l, j - 1);
+                    else if (l - n < p && l - n < j)
+                        Rh(l, j) = Rb(l - n, j - 1);
+                    else
+                        Rh(l, j) = ValueType(0);
+                }
+            }
+
+            // M*A [q_last W(0:num_new-1)] = [q_last W] B with the tridiagonal
+            // change of basis B, the new Hessenberg columns X solve
+            // X U = Rh B - H Z where [Z; U] are the columns of Rh on the old
+            // and on the new Arnoldi vectors
+            for (size_t j = 0; j < num_new; j++)
+            {
+                for (size_t l = 0; l < rows; l++)
+                {
+                    ValueType v = Rh(l, j) * theta[j] + Rh(l, j + 1) * sigma[j];
+
+                    if (j > 0)
+                        v += Rh(l, j - 1) * mu[j];
+
+                    if (l < n)
+                        for (size_t m = 0; m + 1 < n; m++)
+                            v -= H(l, m) * Rh(m, j);
+
+                    Y(l, j) = v;
+                }
+            }
+
+            for (size_t j = 0; j < num_new; j++)
+            {
+                for (size_t l = 0; l < rows; l++)
+                {
+                    ValueType v = Y(l, j);
+
+                    for (size_t i = 0; i < j; i++)
+                        v -= H(l, k + i) * Rh(n - 1 + i, j);
+
+                    H(l, k + j) = v / Rh(n - 1 + j, j);
+                }
+            }
+
+            // reduce the new columns and check the residual of each
+            for (size_t j = 0; j < num_new; j++)
+            {
+                const size_t c = k + j;
+
+                for (size_t l = 0; l <= R; l++)
+                {
+                    if (l > c + 1)
+                        H(l, c) = ValueType(0);
+
+                    Hr(l, c) = H(l, c);
+                }
+
+                PlaneRotation(Hr, cs, sn, g, c);
+
+                ++monitor;
+
+                if (monitor.finished_norm(cusp::abs(g[c + 1])))
+                {
+                    k = c + 1;
+                    done = true;
+                    break;
+                }
+            }
+
+            if (done)
+                break;
+
+            k += num_new;
+            n += p;
+
+            if (estimate)
+            {
+                gershgorin_interval(H, k, lambda_min, lambda_max);
+                have_interval = true;
+            }
+
+            if (invariant)
+                done = true;
+        }
+
+        // the operator annihilates the residual, no progress is possible
+        if (k == 0)
+            break;
+
+        // solve upper triangular system in place
+        for (size_t j = k; j-- > 0;)
+        {
+            g[j] /= Hr(j, j);
+
+            for (size_t i = 0; i < j; i++)
+                g[i] -= Hr(i, j) * g[j];
+        }
+
+        // x = x + V(0:k) g(0:k) in one pass over V
+        for (size_t j = 0; j < k; j++)
+            K(j, 0) = g[j];
+
+        thrust::copy(K.values.begin(), K.values.end(), Kd.values.begin());
+
+        block_combine(exec, N, V, 0, k, Kd, T, 0, 1);
+
+        blas::axpy(exec, column(T, N, 0), x, ValueType(1));
+    }
+}
+
+} // end ca_gmres_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s,
+              const s_step_basis basis,
+                    Monitor& monitor,
+                    Preconditioner& M)
+{
+    using cusp::krylov::ca_gmres_detail::ca_gmres;
+
+    return ca_gmres(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                    A, x, b, restart, s, basis, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void ca_gmres(const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s,
+              const s_step_basis basis,
+                    Monitor& monitor,
+                    Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType1::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::ca_gmres(select_system(system1,system2), A, x, b, restart, s, basis, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void ca_gmres(const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s,
+                    Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::ca_gmres(A, x, b, restart, s, newton_basis, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void ca_gmres(const LinearOperator& A,
+                    VectorType1& x,
+              const VectorType2& b,
+              const size_t restart,
+              const size_t s)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    return cusp::krylov::ca_gmres(A, x, b, restart, s, monitor);
+}
+
+} // end namespace krylov
+} // end namespace cusp
@@ -16,6 +16,7 @@
 
 #include <cusp/array1d.h>
 #include <cusp/complex.h>
+#include <cusp/exception.h>
 #include <cusp/linear_operator.h>
 #include <cusp/monitor.h>
 #include <cusp/multiply.h>
@@ -90,50 +91,47 @@ void PlaneRotation(LinearOperator &H,
     ApplyPlaneRotation(s[i], s[i + 1], cs[i], sn[i]);
 }
 
+// GMRES iterations using the caller's workspace, w, V0 and sDev have size
+// N, N and restart + 1, V is N x (restart + 1) and the host arrays H, s,
+// cs, sn and resid have the sizes allocated by gmres below
 template <typename DerivedPolicy,
           typename LinearOperator,
           typename VectorType1,
           typename VectorType2,
           typename Monitor,
-          typename Preconditioner>
-void gmres(thrust::execution_policy<DerivedPolicy> &exec,
-           const LinearOperator &A,
-                 VectorType1 &x,
-           const VectorType2 &b,
-           const size_t restart,
-                 Monitor &monitor,
-                 Preconditioner &M)
+          typename Preconditioner,
+          typename WorkspaceType1,
+          typename WorkspaceType2,
+          typename WorkspaceType3,
+          typename HostArray2d,
+          typename HostArray1d>
+void gmres_solve(thrust::execution_policy<DerivedPolicy> &exec,
+                 const LinearOperator &A,
+                       VectorType1 &x,
+                 const VectorType2 &b,
+                 const size_t restart,
+                       Monitor &monitor,
+                       Preconditioner &M,
+                       WorkspaceType1 &w,
+                       WorkspaceType1 &V0,
+                       WorkspaceType2 &V,
+                       WorkspaceType3 &sDev,
+                       HostArray2d &H,
+                       HostArray1d &s,
+                       HostArray1d &cs,
+                       HostArray1d &sn,
+                       HostArray1d &resid)
 {
     typedef typename LinearOperator::value_type ValueType;
     typedef typename cusp::norm_type<ValueType>::type NormType;
-    typedef typename cusp::minimum_space<
-    typename LinearOperator::memory_space, typename VectorType1::memory_space,
-             typename Preconditioner::memory_space>::type MemorySpace;
 
     assert(A.num_rows == A.num_cols);  // sanity check
 
-    const size_t N = A.num_rows;
     const int R = restart;
     int i, j, k;
     NormType beta = 0;
 
-    // allocate workspace
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>   w(exec, N);
-    // Arnoldi matrix pos 0
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>   V0(exec, N);
-    // Arnoldi matrix
-    cusp::array2d<ValueType, MemorySpace, cusp::column_major> V(N, R + 1, ValueType(0.0));
-
-    // duplicate copy of s on GPU
-    cusp::detail::temporary_array<ValueType, DerivedPolicy> sDev(exec, R + 1);
-
-    // HOST WORKSPACE
     cusp::host_memory host_exec;
-    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> H(R + 1, R);  // Hessenberg matrix
-    cusp::array1d<ValueType, cusp::host_memory> s(R + 1);
-    cusp::array1d<ValueType, cusp::host_memory> cs(R);
-    cusp::array1d<ValueType, cusp::host_memory> sn(R);
-    cusp::array1d<ValueType, cusp::host_memory> resid(1);
 
     do
     {
@@ -212,6 +210,48 @@ void gmres(thrust::execution_policy<DerivedPolicy> &exec,
     } while (!monitor.finished(resid));
 }
 
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void gmres(thrust::execution_policy<DerivedPolicy> &exec,
+           const LinearOperator &A,
+                 VectorType1 &x,
+           const VectorType2 &b,
+           const size_t restart,
+                 Monitor &monitor,
+                 Preconditioner &M)
+{
+    typedef typename LinearOperator::value_type ValueType;
+    typedef typename cusp::minimum_space<
+    typename LinearOperator::memory_space, typename VectorType1::memory_space,
+             typename Preconditioner::memory_space>::type MemorySpace;
+
+    const size_t N = A.num_rows;
+    const int R = restart;
+
+    // allocate workspace
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>   w(exec, N);
+    // Arnoldi matrix pos 0
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>   V0(exec, N);
+    // Arnoldi matrix
+    cusp::array2d<ValueType, MemorySpace, cusp::column_major> V(N, R + 1, ValueType(0.0));
+
+    // duplicate copy of s on GPU
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> sDev(exec, R + 1);
+
+    // HOST WORKSPACE
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> H(R + 1, R);  // Hessenberg matrix
+    cusp::array1d<ValueType, cusp::host_memory> s(R + 1);
+    cusp::array1d<ValueType, cusp::host_memory> cs(R);
+    cusp::array1d<ValueType, cusp::host_memory> sn(R);
+    cusp::array1d<ValueType, cusp::host_memory> resid(1);
+
+    gmres_solve(exec, A, x, b, restart, monitor, M, w, V0, V, sDev, H, s, cs, sn, resid);
+}
+
 }  // end gmres_detail namespace
 
 template <typename DerivedPolicy,
@@ -289,6 +329,102 @@ void gmres(const LinearOperator &A,
     return cusp::krylov::gmres(A, x, b, restart, monitor);
 }
 
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+gmres_solver<ValueType,MemorySpace>
+::gmres_solver(const MatrixType& A, const size_t restart)
+{
+    setup(A, restart);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void gmres_solver<ValueType,MemorySpace>
+::setup(const MatrixType& A, const size_t restart)
+{
+    if (restart == 0)
+        throw cusp::invalid_input_exception("restart must be positive");
+
+    const size_t N = A.num_rows;
+    const size_t R = restart;
+
+    this->restart = restart;
+
+    w.resize(N);
+    V0.resize(N);
+    V.resize(N, R + 1);
+    sDev.resize(R + 1);
+
+    H.resize(R + 1, R);
+    s.resize(R + 1);
+    cs.resize(R);
+    sn.resize(R);
+    resid.resize(1);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void gmres_solver<ValueType,MemorySpace>
+::solve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+        const LinearOperator& A,
+              VectorType1& x,
+        const VectorType2& b,
+              Monitor& monitor,
+              Preconditioner& M)
+{
+    using cusp::krylov::gmres_detail::gmres_solve;
+
+    // resizing is a no-op once the workspace matches A
+    setup(A, restart);
+
+    gmres_solve(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, b, restart, monitor, M,
+                w, V0, V, sDev, H, s, cs, sn, resid);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void gmres_solver<ValueType,MemorySpace>
+::solve(const LinearOperator& A,
+              VectorType1& x,
+        const VectorType2& b,
+              Monitor& monitor,
+              Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType1::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    solve(select_system(system1,system2), A, x, b, monitor, M);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void gmres_solver<ValueType,MemorySpace>
+::solve(const LinearOperator& A,
+              VectorType1& x,
+        const VectorType2& b,
+              Monitor& monitor)
+{
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    solve(A, x, b, monitor, M);
+}
+
 }  // end namespace krylov
 }  // end namespace cusp
-
@@ -0,0 +1,239 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/convert.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/linear_operator.h>
+#include <cusp/multiply.h>
+#include <cusp/monitor.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/krylov/cg.h>
+#include <cusp/krylov/gmres.h>
+
+#include <cusp/precond/aggregation/smoothed_aggregation.h>
+
+#include <thrust/copy.h>
+
+#include <cmath>
+#include <limits>
+
+namespace cusp
+{
+namespace krylov
+{
+namespace iterative_refinement_detail
+{
+
+// outer iterations on A, the corrections are solved with the inner matrix
+// Af and preconditioner M, both already in the inner precision
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename InnerMatrixType,
+          typename Preconditioner>
+void refine(thrust::execution_policy<DerivedPolicy> &exec,
+            const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+                  Monitor& monitor,
+            const InnerMatrixType& Af,
+                  Preconditioner& M,
+            const size_t restart)
+{
+    typedef typename LinearOperator::value_type               ValueType;
+    typedef typename cusp::norm_type<ValueType>::type         NormType;
+    typedef typename InnerMatrixType::value_type              InnerValueType;
+    typedef typename cusp::norm_type<InnerValueType>::type    InnerNormType;
+    typedef typename InnerMatrixType::memory_space            MemorySpace;
+
+    const size_t N = A.num_rows;
+
+    // allocate workspace
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>      r(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy>      y(exec, N);
+    cusp::detail::temporary_array<InnerValueType, DerivedPolicy> rf(exec, N);
+    cusp::detail::temporary_array<InnerValueType, DerivedPolicy> df(exec, N);
+
+    // the inner solvers keep their workspace across the outer iterations
+    cusp::krylov::cg_solver<InnerValueType, MemorySpace>    inner_cg;
+    cusp::krylov::gmres_solver<InnerValueType, MemorySpace> inner_gmres;
+
+    if (restart > 0)
+        inner_gmres.setup(Af, restart);
+    else
+        inner_cg.setup(Af);
+
+    const InnerNormType inner_tolerance = std::sqrt(std::numeric_limits<InnerNormType>::epsilon());
+
+    // r <- b - A*x
+    cusp::multiply(exec, A, x, r);
+    blas::axpby(exec, b, r, r, ValueType(1), ValueType(-1));
+
+    NormType norm = blas::nrm2(exec, r);
+
+    while (!monitor.finished_norm(norm))
+    {
+        // rf <- r / ||r|| in the inner precision
+        blas::copy(exec, r, y);
+        blas::scal(exec, y, ValueType(NormType(1) / norm));
+        thrust::copy(exec, y.begin(), y.end(), rf.begin());
+
+        // solve Af df = rf
+        blas::fill(exec, df, InnerValueType(0));
+
+        cusp::monitor<InnerValueType> inner_monitor(rf, N, inner_tolerance);
+
+        if (restart > 0)
+            inner_gmres.solve(exec, Af, df, rf, inner_monitor, M);
+        else
+            inner_cg.solve(exec, Af, df, rf, inner_monitor, M);
+
+        // x <- x + ||r|| * df
+        thrust::copy(exec, df.begin(), df.end(), y.begin());
+        blas::axpy(exec, y, x, ValueType(norm));
+
+        // r <- b - A*x
+        cusp::multiply(exec, A, x, r);
+        blas::axpby(exec, b, r, r, ValueType(1), ValueType(-1));
+
+        norm = blas::nrm2(exec, r);
+
+        ++monitor;
+    }
+}
+
+template <typename InnerValueType,
+          typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void iterative_refinement(thrust::execution_policy<DerivedPolicy> &exec,
+                          const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b,
+                                Monitor& monitor,
+                          const size_t restart,
+                          const bool use_smoothed_aggregation)
+{
+    typedef typename LinearOperator::index_type   IndexType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+
+    // the inner matrix and preconditioner are built once and reused by
+    // every outer iteration
+    cusp::csr_matrix<IndexType, InnerValueType, MemorySpace> Af;
+    cusp::convert(exec, A, Af);
+
+    if (use_smoothed_aggregation)
+    {
+        cusp::precond::aggregation::smoothed_aggregation<IndexType, InnerValueType, MemorySpace> M(Af);
+
+        refine(exec, A, x, b, monitor, Af, M, restart);
+    }
+    else
+    {
+        cusp::identity_operator<InnerValueType, MemorySpace> M(A.num_rows, A.num_cols);
+
+        refine(exec, A, x, b, monitor, Af, M, restart);
+    }
+}
+
+} // end iterative_refinement_detail namespace
+
+template <typename InnerValueType,
+          typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void iterative_refinement(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b,
+                                Monitor& monitor,
+                          const size_t restart,
+                          const bool use_smoothed_aggregation)
+{
+    using cusp::krylov::iterative_refinement_detail::iterative_refinement;
+
+    return iterative_refinement<InnerValueType>(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                                                A, x, b, monitor, restart, use_smoothed_aggregation);
+}
+
+template <typename InnerValueType,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void iterative_refinement(const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b,
+                                Monitor& monitor,
+                          const size_t restart,
+                          const bool use_smoothed_aggregation)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType2::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::iterative_refinement<InnerValueType>(select_system(system1,system2),
+                                                              A, x, b, monitor, restart, use_smoothed_aggregation);
+}
+
+template <typename InnerValueType,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void iterative_refinement(const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b,
+                                Monitor& monitor)
+{
+    return cusp::krylov::iterative_refinement<InnerValueType>(A, x, b, monitor, 0, false);
+}
+
+template <typename InnerValueType,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void iterative_refinement(const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    return cusp::krylov::iterative_refinement<InnerValueType>(A, x, b, monitor);
+}
+
+} // end namespace krylov
+} // end namespace cusp
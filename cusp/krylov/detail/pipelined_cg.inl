@@ -0,0 +1,306 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/functional.h>
+#include <cusp/linear_operator.h>
+#include <cusp/multiply.h>
+#include <cusp/monitor.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/blas/blas.h>
+
+#include <thrust/for_each.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/zip_iterator.h>
+
+#include <cmath>
+
+/*
+ * Pipelined preconditioned Conjugate Gradient as described in
+ *
+ *     Hiding global synchronization latency in the preconditioned
+ *     Conjugate Gradient algorithm
+ *     P. Ghysels and W. Vanroose
+ *     Parallel Computing 40 (2014)
+ *
+ * The recurrences for s = Ap, q = Ms and z = Aq replace the matrix and
+ * preconditioner applications on p, so all inner products of an iteration
+ * are available from the same vectors at the same time. The paper
+ * overlaps the reduction with the products of the same iteration; the
+ * execution policies used here are synchronous, so this implementation
+ * only fuses the reductions and the vector updates.
+ */
+
+namespace cusp
+{
+namespace krylov
+{
+namespace pipelined_cg_detail
+{
+
+// computes (<r,u>, <w,u>, |r|^2) for one entry of the tuple (r,u,w)
+template <typename ValueType>
+struct KERNEL_DOTS
+{
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef thrust::tuple<ValueType,ValueType,NormType> ResultType;
+
+    template <typename Tuple>
+    __host__ __device__
+    ResultType operator()(const Tuple& t) const
+    {
+        const ValueType r = thrust::get<0>(t);
+        const ValueType u = thrust::get<1>(t);
+        const ValueType w = thrust::get<2>(t);
+
+        return ResultType(cusp::conj(r) * u,
+                          cusp::conj(w) * u,
+                          cusp::abs_squared_functor<ValueType>()(r));
+    }
+};
+
+// sums the partial results of KERNEL_DOTS
+template <typename ValueType>
+struct KERNEL_DOTS_SUM
+{
+    typedef typename KERNEL_DOTS<ValueType>::ResultType ResultType;
+
+    __host__ __device__
+    ResultType operator()(const ResultType& a, const ResultType& b) const
+    {
+        return ResultType(thrust::get<0>(a) + thrust::get<0>(b),
+                          thrust::get<1>(a) + thrust::get<1>(b),
+                          thrust::get<2>(a) + thrust::get<2>(b));
+    }
+};
+
+// updates one entry of the tuple (x,r,u,w,z,q,s,p,m,n)
+//   z <- n + beta*z    q <- m + beta*q    s <- w + beta*s    p <- u + beta*p
+//   x <- x + alpha*p   r <- r - alpha*s   u <- u - alpha*q   w <- w - alpha*z
+template <typename ValueType>
+struct KERNEL_UPDATE
+{
+    ValueType alpha;
+    ValueType beta;
+
+    KERNEL_UPDATE(ValueType _alpha, ValueType _beta)
+        : alpha(_alpha), beta(_beta)
+    {}
+
+    template <typename Tuple>
+    __host__ __device__
+    void operator()(Tuple t)
+    {
+        const ValueType z = thrust::get<9>(t) + beta * thrust::get<4>(t);
+        const ValueType q = thrust::get<8>(t) + beta * thrust::get<5>(t);
+        const ValueType s = thrust::get<3>(t) + beta * thrust::get<6>(t);
+        const ValueType p = thrust::get<2>(t) + beta * thrust::get<7>(t);
+
+        thrust::get<0>(t) += alpha * p;
+        thrust::get<1>(t) -= alpha * s;
+        thrust::get<2>(t) -= alpha * q;
+        thrust::get<3>(t) -= alpha * z;
+        thrust::get<4>(t)  = z;
+        thrust::get<5>(t)  = q;
+        thrust::get<6>(t)  = s;
+        thrust::get<7>(t)  = p;
+    }
+};
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void pipelined_cg(thrust::execution_policy<DerivedPolicy> &exec,
+                  const LinearOperator& A,
+                        VectorType1& x,
+                  const VectorType2& b,
+                        Monitor& monitor,
+                        Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type           ValueType;
+    typedef typename cusp::norm_type<ValueType>::type     NormType;
+    typedef typename KERNEL_DOTS<ValueType>::ResultType   DotsType;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+
+    const size_t N = A.num_rows;
+
+    // allocate workspace, the search directions start at zero so the
+    // first update with beta = 0 is well defined
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> r(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> u(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> w(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> m(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> n(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> z(exec, N, ValueType(0));
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> q(exec, N, ValueType(0));
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> s(exec, N, ValueType(0));
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> p(exec, N, ValueType(0));
+
+    // r <- b - A*x
+    cusp::multiply(exec, A, x, w);
+    cusp::blas::axpby(exec, b, w, r, ValueType(1), ValueType(-1));
+
+    // u <- M*r
+    cusp::multiply(exec, M, r, u);
+
+    // w <- A*u
+    cusp::multiply(exec, A, u, w);
+
+    ValueType alpha = 0;
+    ValueType gamma = 0;
+
+    bool first_iteration = true;
+
+    while (true)
+    {
+        // gamma <- <r,u>, delta <- <w,u>, rr <- <r,r> in a single pass
+        const DotsType dots =
+            thrust::transform_reduce(exec,
+                                     thrust::make_zip_iterator(thrust::make_tuple(r.begin(), u.begin(), w.begin())),
+                                     thrust::make_zip_iterator(thrust::make_tuple(r.begin(), u.begin(), w.begin())) + N,
+                                     KERNEL_DOTS<ValueType>(),
+                                     DotsType(ValueType(0), ValueType(0), NormType(0)),
+                                     KERNEL_DOTS_SUM<ValueType>());
+
+        if (monitor.finished_norm(std::sqrt(thrust::get<2>(dots))))
+            break;
+
+        // these products do not depend on the reduction above, which has
+        // already completed: the synchronous execution policies cannot
+        // overlap the two
+        // m <- M*w
+        cusp::multiply(exec, M, w, m);
+
+        // n <- A*m
+        cusp::multiply(exec, A, m, n);
+
+        const ValueType gamma_old = gamma;
+
+        gamma = thrust::get<0>(dots);
+
+        const ValueType delta = thrust::get<1>(dots);
+
+        // beta <- gamma/gamma_old
+        // alpha <- gamma/(delta - beta*gamma/alpha_old)
+        ValueType beta = 0;
+
+        if (first_iteration)
+        {
+            alpha = gamma / delta;
+            first_iteration = false;
+        }
+        else
+        {
+            beta  = gamma / gamma_old;
+            alpha = gamma / (delta - beta * gamma / alpha);
+        }
+
+        // update search directions, solution and residuals in a single pass
+        thrust::for_each(exec,
+                         thrust::make_zip_iterator(thrust::make_tuple(x.begin(), r.begin(), u.begin(), w.begin(), z.begin(),
+                                                                      q.begin(), s.begin(), p.begin(), m.begin(), n.begin())),
+                         thrust::make_zip_iterator(thrust::make_tuple(x.begin(), r.begin(), u.begin(), w.begin(), z.begin(),
+                                                                      q.begin(), s.begin(), p.begin(), m.begin(), n.begin())) + N,
+                         KERNEL_UPDATE<ValueType>(alpha, beta));
+
+        ++monitor;
+    }
+}
+
+} // end pipelined_cg_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void pipelined_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  const LinearOperator& A,
+                        VectorType1& x,
+                  const VectorType2& b,
+                        Monitor& monitor,
+                        Preconditioner& M)
+{
+    using cusp::krylov::pipelined_cg_detail::pipelined_cg;
+
+    return pipelined_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, b, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void pipelined_cg(const LinearOperator& A,
+                        VectorType1& x,
+                  const VectorType2& b,
+                        Monitor& monitor,
+                        Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType2::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::pipelined_cg(select_system(system1,system2), A, x, b, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void pipelined_cg(const LinearOperator& A,
+                        VectorType1& x,
+                  const VectorType2& b,
+                        Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::pipelined_cg(A, x, b, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void pipelined_cg(const LinearOperator& A,
+                        VectorType1& x,
+                  const VectorType2& b)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    return cusp::krylov::pipelined_cg(A, x, b, monitor);
+}
+
+} // end namespace krylov
+} // end namespace cusp
@@ -0,0 +1,474 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+
+#include <cusp/krylov/s_step_basis.h>
+
+#include <thrust/for_each.h>
+#include <thrust/memory.h>
+
+#include <thrust/iterator/counting_iterator.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+/*
+ * Helpers shared by the s-step Krylov solvers. The basis vectors are
+ * stored column-major in a flat array as in block_utils.h, the small
+ * Gram, change of basis and Hessenberg matrices live on the host. The
+ * Gram matrices and the basis updates traverse the rows of the basis
+ * once, a dense gemm over the same columns would stream every column
+ * once per entry of its output.
+ */
+
+namespace cusp
+{
+namespace krylov
+{
+namespace s_step_detail
+{
+
+// number of rows processed together by block_gram and block_combine, the
+// tile of every column involved fits in the L1 cache of a host core
+const size_t s_step_tile_size = 64;
+
+// number of row chunks of block_gram, bounded so that the partial Gram
+// matrices stay small compared to the basis
+inline size_t gram_chunks(const size_t num_rows)
+{
+    const size_t min_chunk_size = 1024;
+    const size_t max_chunks     = 1024;
+
+    return std::max(size_t(1), std::min(max_chunks, (num_rows + min_chunk_size - 1) / min_chunk_size));
+}
+
+// partial Gram matrix of the rows [c * chunk_size, (c + 1) * chunk_size),
+// computed tile by tile with contiguous inner products
+template <typename ValueType>
+struct KERNEL_GRAM_CHUNK
+{
+    const ValueType* X;
+    const ValueType* Y;
+    ValueType* partial;
+    size_t num_rows, num_x, num_y, chunk_size;
+
+    KERNEL_GRAM_CHUNK(const ValueType* X, const ValueType* Y, ValueType* partial,
+                      const size_t num_rows, const size_t num_x, const size_t num_y,
+                      const size_t chunk_size)
+        : X(X), Y(Y), partial(partial),
+          num_rows(num_rows), num_x(num_x), num_y(num_y), chunk_size(chunk_size) {}
+
+    __host__ __device__
+    void operator()(const size_t c) const
+    {
+        ValueType* P = partial + c * num_x * num_y;
+
+        for (size_t k = 0; k < num_x * num_y; k++)
+            P[k] = ValueType(0);
+
+        const size_t begin = c * chunk_size;
+        const size_t end   = begin + chunk_size < num_rows ? begin + chunk_size : num_rows;
+
+        for (size_t tile = begin; tile < end; tile += s_step_tile_size)
+        {
+            const size_t tile_end = tile + s_step_tile_size < end ? tile + s_step_tile_size : end;
+
+            // 2 x 2 blocks of G, every value loaded from the tile is used
+            // twice and the four partial sums are independent. An odd
+            // last column is paired with itself and stored once.
+            for (size_t b = 0; b < num_y; b += 2)
+            {
+                const bool has_b1 = b + 1 < num_y;
+
+                const ValueType* y0 = Y + b * num_rows;
+                const ValueType* y1 = has_b1 ? y0 + num_rows : y0;
+
+                for (size_t a = 0; a < num_x; a += 2)
+                {
+                    const bool has_a1 = a + 1 < num_x;
+
+                    const ValueType* x0 = X + a * num_rows;
+                    const ValueType* x1 = has_a1 ? x0 + num_rows : x0;
+
+                    ValueType sum00 = ValueType(0);
+                    ValueType sum01 = ValueType(0);
+                    ValueType sum10 = ValueType(0);
+                    ValueType sum11 = ValueType(0);
+
+                    for (size_t i = tile; i < tile_end; i++)
+                    {
+                        const ValueType u0 = cusp::conj(x0[i]);
+                        const ValueType u1 = cusp::conj(x1[i]);
+                        const ValueType w0 = y0[i];
+                        const ValueType w1 = y1[i];
+
+                        sum00 += u0 * w0;
+                        sum10 += u1 * w0;
+                        sum01 += u0 * w1;
+                        sum11 += u1 * w1;
+                    }
+
+                    P[a + b * num_x] += sum00;
+
+                    if (has_a1)
+                        P[a + 1 + b * num_x] += sum10;
+
+                    if (has_b1)
+                    {
+                        P[a + (b + 1) * num_x] += sum01;
+
+                        if (has_a1)
+                            P[a + 1 + (b + 1) * num_x] += sum11;
+                    }
+                }
+            }
+        }
+    }
+};
+
+// G(a,b) <- sum of the partial Gram matrices of all chunks
+template <typename ValueType>
+struct KERNEL_GRAM_SUM
+{
+    const ValueType* partial;
+    ValueType* G;
+    size_t pitch, num_x, num_y, num_chunks;
+
+    KERNEL_GRAM_SUM(const ValueType* partial, ValueType* G, const size_t pitch,
+                    const size_t num_x, const size_t num_y, const size_t num_chunks)
+        : partial(partial), G(G), pitch(pitch),
+          num_x(num_x), num_y(num_y), num_chunks(num_chunks) {}
+
+    __host__ __device__
+    void operator()(const size_t k) const
+    {
+        ValueType sum = ValueType(0);
+
+        for (size_t c = 0; c < num_chunks; c++)
+            sum += partial[c * num_x * num_y + k];
+
+        G[(k % num_x) + (k / num_x) * pitch] = sum;
+    }
+};
+
+// Z(i,t) <- sum_a X(i,a) K(a,t) for the rows i of tile r
+template <typename ValueType>
+struct KERNEL_COMBINE
+{
+    const ValueType* X;
+    const ValueType* K;
+    ValueType* Z;
+    size_t num_rows, num_x, num_z, pitch;
+
+    KERNEL_COMBINE(const ValueType* X, const ValueType* K, ValueType* Z,
+                   const size_t num_rows, const size_t num_x, const size_t num_z,
+                   const size_t pitch)
+        : X(X), K(K), Z(Z), num_rows(num_rows), num_x(num_x), num_z(num_z), pitch(pitch) {}
+
+    __host__ __device__
+    void operator()(const size_t r) const
+    {
+        const size_t begin = r * s_step_tile_size;
+        const size_t end   = begin + s_step_tile_size < num_rows ? begin + s_step_tile_size : num_rows;
+
+        for (size_t t = 0; t < num_z; t++)
+        {
+            ValueType* z = Z + t * num_rows;
+
+            for (size_t i = begin; i < end; i++)
+                z[i] = ValueType(0);
+
+            for (size_t a = 0; a < num_x; a++)
+            {
+                const ValueType* x = X + a * num_rows;
+                const ValueType  k = K[a + t * pitch];
+
+                // the coefficient matrices are structurally half empty
+                if (k == ValueType(0))
+                    continue;
+
+                for (size_t i = begin; i < end; i++)
+                    z[i] += k * x[i];
+            }
+        }
+    }
+};
+
+// G(a,b) <- <X(:,x_first + a), Y(:,y_first + b)> for the column-major
+// blocks X and Y. Every chunk of rows accumulates its partial Gram matrix
+// one cached tile of rows at a time, so X and Y are read from memory once
+// no matter how many entries G has, and the partial matrices are summed at
+// the end. partial needs gram_chunks(num_rows) * num_x * num_y entries.
+template <typename DerivedPolicy, typename Array1, typename Array2, typename Array3, typename Array2d>
+void block_gram(thrust::execution_policy<DerivedPolicy>& exec,
+                const size_t num_rows,
+                const Array1& X, const size_t x_first, const size_t num_x,
+                const Array2& Y, const size_t y_first, const size_t num_y,
+                Array3& partial,
+                Array2d& G)
+{
+    typedef typename Array3::value_type ValueType;
+
+    const size_t num_chunks = gram_chunks(num_rows);
+    const size_t chunk_size = (num_rows + num_chunks - 1) / num_chunks;
+
+    assert(partial.size() >= num_chunks * num_x * num_y);
+
+    ValueType* raw_partial = thrust::raw_pointer_cast(&partial[0]);
+
+    thrust::for_each(exec,
+                     thrust::counting_iterator<size_t>(0),
+                     thrust::counting_iterator<size_t>(num_chunks),
+                     KERNEL_GRAM_CHUNK<ValueType>(thrust::raw_pointer_cast(&X[0]) + x_first * num_rows,
+                                                  thrust::raw_pointer_cast(&Y[0]) + y_first * num_rows,
+                                                  raw_partial, num_rows, num_x, num_y, chunk_size));
+
+    thrust::for_each(exec,
+                     thrust::counting_iterator<size_t>(0),
+                     thrust::counting_iterator<size_t>(num_x * num_y),
+                     KERNEL_GRAM_SUM<ValueType>(raw_partial, thrust::raw_pointer_cast(&G.values[0]), G.pitch,
+                                                num_x, num_y, num_chunks));
+}
+
+// Z(:,z_first + t) <- X(:,x_first:x_first + num_x) K(:,t) for t < num_z in
+// a single pass over the rows of X, one cached tile of rows at a time. Z
+// must not overlap the columns of X.
+template <typename DerivedPolicy, typename Array1, typename Array2d, typename Array2>
+void block_combine(thrust::execution_policy<DerivedPolicy>& exec,
+                   const size_t num_rows,
+                   const Array1& X, const size_t x_first, const size_t num_x,
+                   const Array2d& K,
+                   Array2& Z, const size_t z_first, const size_t num_z)
+{
+    typedef typename Array2::value_type ValueType;
+
+    const size_t num_tiles = (num_rows + s_step_tile_size - 1) / s_step_tile_size;
+
+    thrust::for_each(exec,
+                     thrust::counting_iterator<size_t>(0),
+                     thrust::counting_iterator<size_t>(num_tiles),
+                     KERNEL_COMBINE<ValueType>(thrust::raw_pointer_cast(&X[0]) + x_first * num_rows,
+                                               thrust::raw_pointer_cast(&K.values[0]),
+                                               thrust::raw_pointer_cast(&Z[0]) + z_first * num_rows,
+                                               num_rows, num_x, num_z, K.pitch));
+}
+
+// coefficients of v_{i+1} = (A v_i - theta_i v_i - mu_i v_{i-1}) / sigma_i
+// for i < s given the spectral estimate [lambda_min, lambda_max]
+template <typename Real, typename Array>
+void basis_coefficients(const s_step_basis basis,
+                        const size_t s,
+                        Real lambda_min,
+                        Real lambda_max,
+                        Array& theta,
+                        Array& sigma,
+                        Array& mu)
+{
+    typedef typename Array::value_type ValueType;
+
+    // a single point gives no scale to the basis, widen it
+    Real min_width = Real(1e-2) * std::max(std::abs(lambda_min), std::abs(lambda_max));
+
+    if (min_width == Real(0))
+        min_width = Real(1);
+
+    if (!(lambda_max - lambda_min > min_width))
+    {
+        const Real center = (lambda_min + lambda_max) / Real(2);
+
+        lambda_min = center - min_width / Real(2);
+        lambda_max = center + min_width / Real(2);
+    }
+
+    const Real center     = (lambda_min + lambda_max) / Real(2);
+    const Real half_width = (lambda_max - lambda_min) / Real(2);
+
+    for (size_t i = 0; i < s; i++)
+    {
+        theta[i] = ValueType(0);
+        sigma[i] = ValueType(1);
+        mu[i]    = ValueType(0);
+    }
+
+    if (basis == monomial_basis)
+    {
+        for (size_t i = 0; i < s; i++)
+            sigma[i] = std::max(std::abs(lambda_min), std::abs(lambda_max));
+    }
+    else if (basis == newton_basis)
+    {
+        // Chebyshev points of [lambda_min, lambda_max]
+        cusp::array1d<Real, cusp::host_memory> nodes(s);
+        cusp::array1d<bool, cusp::host_memory> used(s, false);
+
+        const Real pi = Real(4) * std::atan(Real(1));
+
+        for (size_t i = 0; i < s; i++)
+            nodes[i] = center + half_width * std::cos(Real(2 * i + 1) * pi / Real(2 * s));
+
+        // Leja order, every shift maximizes the product of its distances
+        // to the previous shifts, which keeps the basis well conditioned
+        for (size_t i = 0; i < s; i++)
+        {
+            size_t best = 0;
+            Real best_value = -std::numeric_limits<Real>::infinity();
+
+            for (size_t j = 0; j < s; j++)
+            {
+                if (used[j])
+                    continue;
+
+                Real value = 0;
+
+                if (i == 0)
+                {
+                    value = std::abs(nodes[j]);
+                }
+                else
+                {
+                    for (size_t k = 0; k < i; k++)
+                        value += std::log(std::abs(nodes[j] - Real(theta[k])));
+                }
+
+                if (value > best_value)
+                {
+                    best       = j;
+                    best_value = value;
+                }
+            }
+
+            used[best] = true;
+            theta[i]   = nodes[best];
+            sigma[i]   = half_width / Real(2);
+        }
+    }
+    else
+    {
+        // T_{i+1}(t) = 2 t T_i(t) - T_{i-1}(t) with t = (A - center) / half_width
+        for (size_t i = 0; i < s; i++)
+        {
+            theta[i] = center;
+            sigma[i] = i == 0 ? half_width : half_width / Real(2);
+            mu[i]    = i == 0 ? Real(0)    : half_width / Real(2);
+        }
+    }
+}
+
+// Gershgorin bounds of the real parts of the eigenvalues of the leading
+// n x n block of H
+template <typename Array2d, typename Real>
+void gershgorin_interval(const Array2d& H,
+                         const size_t n,
+                         Real& lambda_min,
+                         Real& lambda_max)
+{
+    lambda_min =  std::numeric_limits<Real>::max();
+    lambda_max = -std::numeric_limits<Real>::max();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        Real radius = 0;
+
+        for (size_t j = 0; j < n; j++)
+            if (j != i)
+                radius += std::abs(H(i, j));
+
+        lambda_min = std::min(lambda_min, Real(H(i, i)) - radius);
+        lambda_max = std::max(lambda_max, Real(H(i, i)) + radius);
+    }
+}
+
+// upper triangular R with G = R^T R for the leading n x n block of G.
+// Returns the number of columns factored before a pivot dropped below
+// tolerance * G(j,j), i.e. before the next basis vector became
+// numerically dependent on the previous ones.
+template <typename Array2d1, typename Array2d2, typename Real>
+size_t cholesky_upper(const Array2d1& G,
+                      Array2d2& R,
+                      const size_t n,
+                      const Real tolerance)
+{
+    typedef typename Array2d2::value_type ValueType;
+
+    for (size_t j = 0; j < n; j++)
+        for (size_t i = 0; i < n; i++)
+            R(i, j) = ValueType(0);
+
+    for (size_t j = 0; j < n; j++)
+    {
+        ValueType d = G(j, j);
+
+        for (size_t k = 0; k < j; k++)
+            d -= R(k, j) * R(k, j);
+
+        if (!(d > tolerance * G(j, j)))
+            return j;
+
+        R(j, j) = std::sqrt(d);
+
+        for (size_t i = j + 1; i < n; i++)
+        {
+            ValueType v = G(j, i);
+
+            for (size_t k = 0; k < j; k++)
+                v -= R(k, j) * R(k, i);
+
+            R(j, i) = v / R(j, j);
+        }
+    }
+
+    return n;
+}
+
+// inverse of the leading n x n block of the upper triangular R
+template <typename Array2d1, typename Array2d2>
+void invert_upper(const Array2d1& R,
+                  Array2d2& Rinv,
+                  const size_t n)
+{
+    typedef typename Array2d2::value_type ValueType;
+
+    for (size_t j = 0; j < n; j++)
+    {
+        for (size_t i = j + 1; i < n; i++)
+            Rinv(i, j) = ValueType(0);
+
+        Rinv(j, j) = ValueType(1) / R(j, j);
+
+        for (size_t i = j; i-- > 0;)
+        {
+            ValueType v = 0;
+
+            for (size_t k = i + 1; k <= j; k++)
+                v += R(i, k) * Rinv(k, j);
+
+            Rinv(i, j) = -v / R(i, i);
+        }
+    }
+}
+
+} // end namespace s_step_detail
+} // end namespace krylov
+} // end namespace cusp
@@ -22,6 +22,9 @@
 
 #include <cusp/detail/config.h>
 
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+
 #include <cusp/detail/execution_policy.h>
 
 #include <cstddef>
@@ -147,6 +150,142 @@ void gmres(const LinearOperator& A,
            const size_t restart,
                  Monitor& monitor,
                  Preconditioner& M);
+
+/**
+ * \brief GMRES solver owning its workspace
+ *
+ * \tparam ValueType value_type of the workspace
+ * \tparam MemorySpace memory space of the workspace
+ *
+ * \par Overview
+ * Performs the same iterations as \p gmres, but the Krylov basis, the
+ * Hessenberg matrix and the work vectors are members of the solver. They
+ * are allocated by \p setup, or by the first call to \p solve, and reused
+ * by every later \p solve on a matrix of the same size, so repeated solves
+ * do not allocate the N x (restart + 1) basis again.
+ *
+ * \par Example
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/gmres.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int, float, cusp::device_memory> A;
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      cusp::array1d<float, cusp::device_memory> x(A.num_rows);
+ *      cusp::array1d<float, cusp::device_memory> b(A.num_rows, 1);
+ *
+ *      // allocate the workspace for restart = 50 once
+ *      cusp::krylov::gmres_solver<float, cusp::device_memory> solver(A, 50);
+ *
+ *      for (int i = 0; i < 1000; i++)
+ *      {
+ *          cusp::blas::fill(x, 0);
+ *          cusp::monitor<float> monitor(b, 100, 1e-6);
+ *
+ *          // solve the linear system A x = b without allocating workspace
+ *          solver.solve(A, x, b, monitor);
+ *      }
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p gmres
+ */
+template <typename ValueType, typename MemorySpace>
+class gmres_solver
+{
+public:
+
+    /*! Construct an empty \p gmres_solver with restart parameter 50,
+     * the workspace is allocated by the first call to \p solve.
+     */
+    gmres_solver(void) : restart(50) {}
+
+    /*! Construct a \p gmres_solver with workspace for \p A.
+     *
+     * \param A matrix of the linear systems
+     * \param restart restart parameter of GMRES
+     */
+    template <typename MatrixType>
+    gmres_solver(const MatrixType& A, const size_t restart);
+
+    /*! Allocate the workspace for \p A and \p restart, does nothing if
+     * the workspace already has these sizes. Throws
+     * \p invalid_input_exception if \p restart is 0.
+     *
+     * \param A matrix of the linear systems
+     * \param restart restart parameter of GMRES
+     */
+    template <typename MatrixType>
+    void setup(const MatrixType& A, const size_t restart);
+
+    /* \cond */
+    template <typename DerivedPolicy,
+              typename LinearOperator,
+              typename VectorType1,
+              typename VectorType2,
+              typename Monitor,
+              typename Preconditioner>
+    void solve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+               const LinearOperator& A,
+                     VectorType1& x,
+               const VectorType2& b,
+                     Monitor& monitor,
+                     Preconditioner& M);
+
+    template <typename LinearOperator,
+              typename VectorType1,
+              typename VectorType2,
+              typename Monitor>
+    void solve(const LinearOperator& A,
+                     VectorType1& x,
+               const VectorType2& b,
+                     Monitor& monitor);
+    /* \endcond */
+
+    /*! Solve A x = b with preconditioner \p M using the restart
+     * parameter given to \p setup, see \p gmres.
+     *
+     * \param A matrix of the linear system
+     * \param x approximate solution of the linear system
+     * \param b right-hand side of the linear system
+     * \param monitor monitors iteration and determines stopping conditions
+     * \param M preconditioner for A
+     */
+    template <typename LinearOperator,
+              typename VectorType1,
+              typename VectorType2,
+              typename Monitor,
+              typename Preconditioner>
+    void solve(const LinearOperator& A,
+                     VectorType1& x,
+               const VectorType2& b,
+                     Monitor& monitor,
+                     Preconditioner& M);
+
+private:
+
+    /* \cond */
+    size_t restart;
+
+    cusp::array1d<ValueType,MemorySpace> w;
+    cusp::array1d<ValueType,MemorySpace> V0;
+    cusp::array1d<ValueType,MemorySpace> sDev;
+    cusp::array2d<ValueType,MemorySpace,cusp::column_major> V;
+
+    cusp::array2d<ValueType,cusp::host_memory,cusp::column_major> H;
+    cusp::array1d<ValueType,cusp::host_memory> s;
+    cusp::array1d<ValueType,cusp::host_memory> cs;
+    cusp::array1d<ValueType,cusp::host_memory> sn;
+    cusp::array1d<ValueType,cusp::host_memory> resid;
+    /* \endcond */
+};
 /*! \}
 */
 
@@ -0,0 +1,176 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file iterative_refinement.h
+ *  \brief Mixed-precision iterative refinement
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+template <typename InnerValueType,
+          typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void iterative_refinement(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b,
+                                Monitor& monitor,
+                          const size_t restart,
+                          const bool use_smoothed_aggregation);
+
+template <typename InnerValueType,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void iterative_refinement(const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b,
+                                Monitor& monitor);
+
+template <typename InnerValueType,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void iterative_refinement(const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b);
+/* \endcond */
+
+/**
+ * \brief Mixed-precision iterative refinement
+ *
+ * \tparam InnerValueType value_type of the inner solves, e.g. \c float
+ * \tparam LinearOperator is a sparse matrix
+ * \tparam VectorType1 x input vector type
+ * \tparam VectorType2 b output vector type
+ * \tparam Monitor is a \p monitor
+ *
+ * \param A matrix of the linear system
+ * \param x approximate solution of the linear system
+ * \param b right-hand side of the linear system
+ * \param monitor monitors the outer iteration and determines stopping conditions
+ * \param restart restart parameter of the inner GMRES, 0 selects inner CG
+ * \param use_smoothed_aggregation precondition the inner solves with
+ * \p smoothed_aggregation
+ *
+ * \par Overview
+ * Solves the linear system A x = b to the precision of \p A by
+ * iterative refinement. Each outer iteration computes the residual
+ * r = b - A x in the precision of \p A, solves A d = r approximately in
+ * \p InnerValueType and corrects x = x + d.
+ *
+ * The inner matrix is a copy of \p A in \p InnerValueType made with
+ * \p convert once per call, the optional \p smoothed_aggregation
+ * hierarchy is built once on that copy and the workspace of the inner
+ * \p cg_solver or \p gmres_solver is reused, so the outer iterations only
+ * pay for the inner iterations. Running these in \c float halves the
+ * memory traffic of a \c double solve.
+ *
+ * The inner solves stop at a relative tolerance of the square root of
+ * the machine epsilon of \p InnerValueType or after A.num_rows
+ * iterations. The residual is scaled to unit
+ * norm before it is converted, so it does not underflow as x converges.
+ *
+ * \note \p A must be a sparse matrix, its condition number times the
+ * machine epsilon of \p InnerValueType must be well below one for the
+ * refinement to converge.
+ * \note \p A must be symmetric and positive-definite if \p restart is 0.
+ * \note \p monitor is checked with \p finished_norm using the residual
+ * norm in the precision of \p A.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to use
+ *  \p iterative_refinement to solve a double precision 100x100 Poisson
+ *  problem with float inner solves.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/iterative_refinement.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // create an empty sparse matrix structure (CSR format)
+ *      cusp::csr_matrix<int, double, cusp::device_memory> A;
+ *
+ *      // initialize matrix
+ *      cusp::gallery::poisson5pt(A, 100, 100);
+ *
+ *      // allocate storage for solution (x) and right hand side (b)
+ *      cusp::array1d<double, cusp::device_memory> x(A.num_rows, 0);
+ *      cusp::array1d<double, cusp::device_memory> b(A.num_rows, 1);
+ *
+ *      // set stopping criteria of the outer iteration:
+ *      //  iteration_limit    = 100
+ *      //  relative_tolerance = 1e-12
+ *      //  absolute_tolerance = 0
+ *      //  verbose            = true
+ *      cusp::monitor<double> monitor(b, 100, 1e-12, 0, true);
+ *
+ *      // solve the linear system A x = b with float CG preconditioned
+ *      // by smoothed aggregation
+ *      cusp::krylov::iterative_refinement<float>(A, x, b, monitor, 0, true);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p cg_solver
+ *  \see \p gmres_solver
+ *  \see \p monitor
+ *
+ */
+template <typename InnerValueType,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void iterative_refinement(const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b,
+                                Monitor& monitor,
+                          const size_t restart,
+                          const bool use_smoothed_aggregation);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/iterative_refinement.inl>
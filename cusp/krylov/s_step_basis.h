@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file s_step_basis.h
+ *  \brief Polynomial bases of the s-step Krylov methods
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/**
+ * \brief Polynomials used by \p ca_cg and \p ca_gmres to generate s
+ * Krylov basis vectors at once.
+ *
+ * The basis vectors are v_{i+1} = (A v_i - theta_i v_i - mu_i v_{i-1}) / sigma_i
+ * where the coefficients are derived from an estimate [a,b] of the
+ * spectrum of the preconditioned operator.
+ *
+ * - \p monomial_basis uses theta_i = mu_i = 0 and sigma_i = max(|a|,|b|).
+ *   Its vectors quickly become linearly dependent, so it is only suited to
+ *   small s.
+ * - \p newton_basis uses shifts theta_i at the Chebyshev points of [a,b]
+ *   in Leja order.
+ * - \p chebyshev_basis uses the three term recurrence of the Chebyshev
+ *   polynomials scaled and shifted to [a,b].
+ */
+typedef enum
+{
+    monomial_basis,
+    newton_basis,
+    chebyshev_basis,
+} s_step_basis;
+
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
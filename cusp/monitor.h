@@ -187,6 +187,14 @@ public:
     template <typename DerivedPolicy, typename Vector>
     bool finished(thrust::execution_policy<DerivedPolicy> &exec, const Vector& r);
 
+    /**
+     *  \brief Applies convergence criteria to a residual norm computed by
+     *  the solver, e.g. as part of a fused reduction
+     *
+     *  \param norm Euclidean norm of the residual (||b - A x||)
+     */
+    bool finished_norm(const Real norm);
+
     /**
      *  \brief Sets the verbosity level of the monitor
      *
@@ -290,6 +290,317 @@ void generalized_spgemm(const LinearOperator&  A,
                               BinaryFunction1 combine,
                               BinaryFunction2 reduce);
 
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_symbolic(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                     const MatrixType1& A,
+                     const MatrixType2& B,
+                           MatrixType3& C);
+/*! \endcond */
+
+/**
+ * \brief Computes the sparsity pattern of a sparse matrix-matrix product
+ *
+ * \par Overview
+ *
+ * \p spgemm_symbolic computes the structure of <tt>C = A * B</tt> without
+ * computing its values. Every entry formed by the product is kept, including
+ * entries whose value may later cancel to zero, so the pattern depends only on
+ * the structure of \p A and \p B. Together with \p spgemm_numeric this splits
+ * \p multiply into a symbolic and a numeric phase: when the sparsity of \p A
+ * and \p B is fixed and only their values change, the pattern is computed once
+ * and each following product only recomputes the values.
+ *
+ * The values of \p C are unspecified until \p spgemm_numeric is called. On
+ * the host the column indices of each row of a CSR output are sorted.
+ *
+ * \tparam MatrixType1 Type of first matrix
+ * \tparam MatrixType2 Type of second matrix
+ * \tparam MatrixType3 Type of output matrix
+ *
+ * \param A first input matrix
+ * \param B second input matrix
+ * \param C output matrix
+ *
+ * \par Example
+ *
+ *  The following code snippet demonstrates how to use \p spgemm_symbolic and
+ *  \p spgemm_numeric to compute repeated products with a fixed pattern.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/multiply.h>
+ *  #include <cusp/print.h>
+ *
+ *  #include <cusp/blas/blas.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // initialize matrix
+ *      cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *      cusp::gallery::poisson5pt(A, 3, 3);
+ *
+ *      // compute the pattern of C = A * A once
+ *      cusp::csr_matrix<int,float,cusp::host_memory> C;
+ *      cusp::spgemm_symbolic(A, A, C);
+ *
+ *      for(int step = 0; step < 3; step++)
+ *      {
+ *          // update the values of A
+ *          cusp::blas::scal(A.values, 2.0f);
+ *
+ *          // recompute only the values of C = A * A
+ *          cusp::spgemm_numeric(A, A, C);
+ *
+ *          cusp::print(C);
+ *      }
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ */
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_symbolic(const MatrixType1& A,
+                     const MatrixType2& B,
+                           MatrixType3& C);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_numeric(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                          MatrixType3& C);
+/*! \endcond */
+
+/**
+ * \brief Computes the values of a sparse matrix-matrix product with a known
+ * sparsity pattern
+ *
+ * \par Overview
+ *
+ * \p spgemm_numeric computes the values of <tt>C = A * B</tt>, where \p C
+ * holds the pattern computed by \p spgemm_symbolic for matrices with the same
+ * structure as \p A and \p B. The structure of \p C is not modified.
+ *
+ * \tparam MatrixType1 Type of first matrix
+ * \tparam MatrixType2 Type of second matrix
+ * \tparam MatrixType3 Type of output matrix
+ *
+ * \param A first input matrix
+ * \param B second input matrix
+ * \param C output matrix, holding the pattern of <tt>A * B</tt>
+ *
+ * \see \p spgemm_symbolic
+ */
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_numeric(const MatrixType1& A,
+                    const MatrixType2& B,
+                          MatrixType3& C);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spgemm_numeric(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                          MatrixType3& C,
+                          UnaryFunction   initialize,
+                          BinaryFunction1 combine,
+                          BinaryFunction2 reduce);
+/*! \endcond */
+
+/**
+ * \brief Computes the values of a generalized sparse matrix-matrix product
+ * with a known sparsity pattern
+ *
+ * \par Overview
+ *
+ * Each entry of \p C is set to \p initialize applied to its current value
+ * and then reduced with the combined products contributing to it.
+ *
+ * \tparam MatrixType1     Type of first matrix
+ * \tparam MatrixType2     Type of second matrix
+ * \tparam MatrixType3     Type of output matrix
+ * \tparam UnaryFunction   Type of unary function to initialize the output
+ * \tparam BinaryFunction1 Type of binary function to combine entries
+ * \tparam BinaryFunction2 Type of binary function to reduce entries
+ *
+ * \param A first input matrix
+ * \param B second input matrix
+ * \param C output matrix, holding the pattern of <tt>A * B</tt>
+ * \param initialize unary function applied to the entries of \p C
+ * \param combine binary function combining entries of \p A and \p B
+ * \param reduce binary function reducing the combined entries
+ *
+ * \see \p spgemm_symbolic
+ */
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spgemm_numeric(const MatrixType1& A,
+                    const MatrixType2& B,
+                          MatrixType3& C,
+                          UnaryFunction   initialize,
+                          BinaryFunction1 combine,
+                          BinaryFunction2 reduce);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4>
+void masked_spgemm(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                         MatrixType4& C);
+/*! \endcond */
+
+/**
+ * \brief Computes a sparse matrix-matrix product restricted to the pattern
+ * of a mask matrix
+ *
+ * \par Overview
+ *
+ * \p masked_spgemm computes <tt>C = M .* (A * B)</tt>, the entries of
+ * <tt>A * B</tt> whose position is an entry of the mask \p M. Products that
+ * land outside of \p M are never formed or accumulated, so the cost depends
+ * on the pattern of \p M rather than on the pattern of the full product.
+ * Only the structure of \p M is used: \p C contains the entries of \p M
+ * that receive at least one product, in the order they appear in \p M.
+ * \p C must not alias \p A, \p B or \p M.
+ *
+ * \tparam MatrixType1 Type of first matrix
+ * \tparam MatrixType2 Type of second matrix
+ * \tparam MatrixType3 Type of mask matrix
+ * \tparam MatrixType4 Type of output matrix
+ *
+ * \param A first input matrix
+ * \param B second input matrix
+ * \param M mask matrix with the dimensions of <tt>A * B</tt>
+ * \param C output matrix
+ *
+ * \par Example
+ *
+ *  The following code snippet demonstrates how to use \p masked_spgemm to
+ *  count the paths of length two that close a triangle with an edge.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/multiply.h>
+ *  #include <cusp/print.h>
+ *
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // initialize matrix
+ *      cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *      cusp::gallery::poisson9pt(A, 4, 4);
+ *
+ *      // compute A * A only on the entries of A
+ *      cusp::csr_matrix<int,float,cusp::host_memory> C;
+ *      cusp::masked_spgemm(A, A, A, C);
+ *
+ *      cusp::print(C);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ * \see \p generalized_spgemm
+ */
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4>
+void masked_spgemm(const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                         MatrixType4& C);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void masked_spgemm(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                         MatrixType4& C,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce);
+/*! \endcond */
+
+/**
+ * \brief Computes a generalized sparse matrix-matrix product restricted to
+ * the pattern of a mask matrix
+ *
+ * \par Overview
+ *
+ * Each entry of \p C starts from \p initialize applied to the value of the
+ * corresponding entry of \p M and is then reduced with the combined products
+ * landing on it. Entries of \p M that receive no product are dropped.
+ *
+ * \tparam MatrixType1     Type of first matrix
+ * \tparam MatrixType2     Type of second matrix
+ * \tparam MatrixType3     Type of mask matrix
+ * \tparam MatrixType4     Type of output matrix
+ * \tparam UnaryFunction   Type of unary function to initialize the output
+ * \tparam BinaryFunction1 Type of binary function to combine entries
+ * \tparam BinaryFunction2 Type of binary function to reduce entries
+ *
+ * \param A first input matrix
+ * \param B second input matrix
+ * \param M mask matrix with the dimensions of <tt>A * B</tt>
+ * \param C output matrix
+ * \param initialize unary function applied to the entries of \p M
+ * \param combine binary function combining entries of \p A and \p B
+ * \param reduce binary function reducing the combined entries
+ *
+ * \see \p masked_spgemm
+ */
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void masked_spgemm(const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                         MatrixType4& C,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce);
+
 /*! \cond */
 template <typename DerivedPolicy,
           typename LinearOperator,
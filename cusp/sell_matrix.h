@@ -0,0 +1,587 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file sell_matrix.h
+ *  \brief Sliced ELLPACK (SELL-C-sigma) matrix format.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/memory.h>
+
+#include <cusp/detail/format.h>
+#include <cusp/detail/matrix_base.h>
+#include <cusp/detail/type_traits.h>
+
+namespace cusp
+{
+
+/*! \cond */
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3, typename ArrayType4,
+          typename IndexType, typename ValueType, typename MemorySpace> class sell_matrix_view;
+/*! \endcond */
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Sliced ELLPACK (SELL-C-sigma) representation of a sparse matrix
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * A \p sell_matrix groups the rows of the matrix into chunks of \c chunk_size
+ * consecutive rows and stores each chunk in ELL format, so that a row is
+ * only padded to the length of the longest row in its own chunk rather
+ * than to the longest row of the whole matrix. Before chunking, the rows
+ * within each window of \c sigma consecutive rows are sorted by decreasing
+ * length to further reduce padding. The \c row_permutation array records
+ * the original index of each sorted row.
+ *
+ * Chunk \c c occupies the range <tt>[chunk_offsets[c], chunk_offsets[c+1])</tt>
+ * of the \c column_indices and \c values arrays and is stored column-major,
+ * i.e. entry \c j of the \c r-th row of the chunk is located at
+ * <tt>chunk_offsets[c] + j * chunk_size + r</tt>. Consecutive rows of a
+ * chunk are adjacent in memory, which allows the SpMV kernels to process
+ * the \c chunk_size rows of a chunk with SIMD instructions.
+ *
+ * \note The matrix entries within each row must be sorted by column index.
+ * \note The matrix entries within each row should be shifted to the left.
+ * \note Padded entries use \c invalid_index as column index and zero as value.
+ * \note The matrix should not contain duplicate entries.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to create a 4-by-3
+ *  \p sell_matrix on the host with chunks of 2 rows (6 total nonzeros)
+ *  and then copies the matrix to the device.
+ *
+ *  \code
+ *  // include the sell_matrix header file
+ *  #include <cusp/sell_matrix.h>
+ *  #include <cusp/print.h>
+ *
+ *  int main()
+ *  {
+ *    // allocate storage for (4,3) matrix with 6 nonzeros in 10 slots using
+ *    // chunks of 2 rows and no row sorting
+ *    cusp::sell_matrix<int,float,cusp::host_memory> A(4,3,6,10,2,1);
+ *
+ *    // X is used to fill unused entries in the matrix
+ *    const int X = cusp::sell_matrix<int,float,cusp::host_memory>::invalid_index;
+ *
+ *    // rows are not reordered
+ *    A.row_permutation[0] = 0; A.row_permutation[1] = 1;
+ *    A.row_permutation[2] = 2; A.row_permutation[3] = 3;
+ *
+ *    // the first chunk is 2 entries wide, the second 3 entries wide
+ *    A.chunk_offsets[0] = 0; A.chunk_offsets[1] = 4; A.chunk_offsets[2] = 10;
+ *
+ *    // first chunk (rows 0 and 1)
+ *    A.column_indices[0] = 0; A.values[0] = 10;
+ *    A.column_indices[1] = X; A.values[1] =  0;  // padding
+ *    A.column_indices[2] = 2; A.values[2] = 20;
+ *    A.column_indices[3] = X; A.values[3] =  0;  // padding
+ *
+ *    // second chunk (rows 2 and 3)
+ *    A.column_indices[4] = 2; A.values[4] = 30;
+ *    A.column_indices[5] = 0; A.values[5] = 40;
+ *    A.column_indices[6] = X; A.values[6] =  0;  // padding
+ *    A.column_indices[7] = 1; A.values[7] = 50;
+ *    A.column_indices[8] = X; A.values[8] =  0;  // padding
+ *    A.column_indices[9] = 2; A.values[9] = 60;
+ *
+ *    // A now represents the following matrix
+ *    //    [10  0 20]
+ *    //    [ 0  0  0]
+ *    //    [ 0  0 30]
+ *    //    [40 50 60]
+ *
+ *    // copy to the device
+ *    cusp::sell_matrix<int,float,cusp::device_memory> B(A);
+ *
+ *    cusp::print(B);
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+class sell_matrix : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::sell_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::sell_format> Parent;
+
+public:
+
+    /*! Value used to pad the rows of the column_indices array.
+     */
+    const static IndexType invalid_index = static_cast<IndexType>(-1);
+
+    /*! \cond */
+    typedef typename cusp::array1d<IndexType, MemorySpace> chunk_offsets_array_type;
+    typedef typename cusp::array1d<IndexType, MemorySpace> row_permutation_array_type;
+    typedef typename cusp::array1d<IndexType, MemorySpace> column_indices_array_type;
+    typedef typename cusp::array1d<ValueType, MemorySpace> values_array_type;
+
+    typedef typename cusp::sell_matrix<IndexType, ValueType, MemorySpace> container;
+
+    typedef typename cusp::sell_matrix_view<typename chunk_offsets_array_type::view,
+            typename row_permutation_array_type::view,
+            typename column_indices_array_type::view,
+            typename values_array_type::view,
+            IndexType, ValueType, MemorySpace> view;
+
+    typedef typename cusp::sell_matrix_view<typename chunk_offsets_array_type::const_view,
+            typename row_permutation_array_type::const_view,
+            typename column_indices_array_type::const_view,
+            typename values_array_type::const_view,
+            IndexType, ValueType, MemorySpace> const_view;
+
+    template<typename MemorySpace2>
+    struct rebind
+    {
+        typedef cusp::sell_matrix<IndexType, ValueType, MemorySpace2> type;
+    };
+    /*! \endcond */
+
+    /*! Storage for the offsets of each chunk in the SELL data structure.
+     */
+    chunk_offsets_array_type chunk_offsets;
+
+    /*! Storage for the original index of each sorted row.
+     */
+    row_permutation_array_type row_permutation;
+
+    /*! Storage for the column indices of the SELL data structure.
+     */
+    column_indices_array_type column_indices;
+
+    /*! Storage for the nonzero entries of the SELL data structure.
+     */
+    values_array_type values;
+
+    /*! Number of rows in each chunk.
+     */
+    size_t chunk_size;
+
+    /*! Number of consecutive rows sorted by length before chunking.
+     */
+    size_t sigma;
+
+    /*! Construct an empty \p sell_matrix.
+     */
+    sell_matrix(void) : chunk_size(0), sigma(0) {}
+
+    /*! Construct a \p sell_matrix with a specific shape, number of nonzero
+     *  entries, number of stored entries, chunk size and sorting window.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_slots Number of stored entries, including padding.
+     *  \param chunk_size Number of rows in each chunk.
+     *  \param sigma Number of consecutive rows sorted by length.
+     */
+    sell_matrix(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_slots, const size_t chunk_size, const size_t sigma = 1);
+
+    /*! Construct a \p sell_matrix from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  sell_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    sell_matrix(const MatrixType& matrix);
+
+    /*! Construct a \p sell_matrix with a given chunk size and sorting
+     *  window from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix used to create this \p
+     *  sell_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     *  \param chunk_size Number of rows in each chunk.
+     *  \param sigma Number of consecutive rows sorted by length.
+     */
+    template <typename MatrixType>
+    sell_matrix(const MatrixType& matrix, const size_t chunk_size, const size_t sigma = 1);
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_slots Number of stored entries, including padding.
+     *  \param chunk_size Number of rows in each chunk.
+     *  \param sigma Number of consecutive rows sorted by length.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_slots, const size_t chunk_size, const size_t sigma = 1);
+
+    /*! Swap the contents of two \p sell_matrix objects.
+     *
+     *  \param matrix Another \p sell_matrix with the same IndexType and ValueType.
+     */
+    void swap(sell_matrix& matrix);
+
+    /*! Assignment from another matrix.
+     *
+     *  \tparam MatrixType Type of input matrix to copy into this \p
+     *  sell_matrix.
+     *
+     *  \param matrix Another sparse or dense matrix.
+     */
+    template <typename MatrixType>
+    sell_matrix& operator=(const MatrixType& matrix);
+
+}; // class sell_matrix
+/*! \}
+ */
+
+/*! \addtogroup sparse_matrix_views Sparse Matrix Views
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief View of a \p sell_matrix
+ *
+ * \tparam ArrayType1 Type of \c chunk_offsets array view
+ * \tparam ArrayType2 Type of \c row_permutation array view
+ * \tparam ArrayType3 Type of \c column_indices array view
+ * \tparam ArrayType4 Type of \c values array view
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * \note The matrix entries within each row must be sorted by column index.
+ * \note The matrix entries within each row should be shifted to the left.
+ * \note Padded entries use \c invalid_index as column index and zero as value.
+ * \note The matrix should not contain duplicate entries.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to create a view of a
+ *  \p sell_matrix that was converted from a \p csr_matrix.
+ *
+ *  \code
+ *  // include the sell_matrix header file
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/sell_matrix.h>
+ *  #include <cusp/print.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main()
+ *  {
+ *    cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *    cusp::gallery::poisson5pt(A, 4, 4);
+ *
+ *    // convert to SELL with chunks of 4 rows sorted in windows of 8 rows
+ *    cusp::sell_matrix<int,float,cusp::host_memory> B(A, 4, 8);
+ *
+ *    // create a view of B
+ *    cusp::sell_matrix<int,float,cusp::host_memory>::view C = cusp::make_sell_matrix_view(B);
+ *
+ *    // print the view
+ *    cusp::print(C);
+ *  }
+ *  \endcode
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ArrayType4,
+          typename IndexType   = typename ArrayType1::value_type,
+          typename ValueType   = typename ArrayType4::value_type,
+          typename MemorySpace = typename cusp::minimum_space<
+                                    typename ArrayType1::memory_space,
+                                    typename ArrayType2::memory_space,
+                                    typename ArrayType3::memory_space,
+                                    typename ArrayType4::memory_space>::type >
+class sell_matrix_view : public cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::sell_format>
+{
+private:
+
+    typedef cusp::detail::matrix_base<IndexType,ValueType,MemorySpace,cusp::sell_format> Parent;
+
+public:
+
+    /*! \cond */
+    typedef ArrayType1 chunk_offsets_array_type;
+    typedef ArrayType2 row_permutation_array_type;
+    typedef ArrayType3 column_indices_array_type;
+    typedef ArrayType4 values_array_type;
+
+    typedef typename cusp::sell_matrix<IndexType, ValueType, MemorySpace> container;
+    typedef typename cusp::sell_matrix_view<ArrayType1, ArrayType2, ArrayType3, ArrayType4, IndexType, ValueType, MemorySpace> view;
+    typedef typename cusp::sell_matrix_view<ArrayType1, ArrayType2, ArrayType3, ArrayType4, IndexType, ValueType, MemorySpace> const_view;
+    /*! \endcond */
+
+    /**
+     * Value used to pad the rows of the column_indices array.
+     */
+    const static IndexType invalid_index = container::invalid_index;
+
+    /**
+     * View of the chunk offsets of the SELL data structure.
+     */
+    chunk_offsets_array_type chunk_offsets;
+
+    /**
+     * View of the original index of each sorted row.
+     */
+    row_permutation_array_type row_permutation;
+
+    /**
+     * View of the column indices of the SELL data structure.
+     */
+    column_indices_array_type column_indices;
+
+    /**
+     * View of the nonzero entries of the SELL data structure.
+     */
+    values_array_type values;
+
+    /**
+     * Number of rows in each chunk.
+     */
+    size_t chunk_size;
+
+    /**
+     * Number of consecutive rows sorted by length before chunking.
+     */
+    size_t sigma;
+
+    /**
+     * Construct an empty \p sell_matrix_view.
+     */
+    sell_matrix_view(void)
+        : Parent(), chunk_size(0), sigma(0) {}
+
+    /*! Construct a \p sell_matrix_view with a specific shape, number of
+     *  nonzero entries, chunk size and sorting window from existing arrays.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param chunk_size Number of rows in each chunk.
+     *  \param sigma Number of consecutive rows sorted by length.
+     *  \param chunk_offsets Array containing the chunk offsets.
+     *  \param row_permutation Array containing the original index of each sorted row.
+     *  \param column_indices Array containing the column indices.
+     *  \param values Array containing the values.
+     */
+    sell_matrix_view(const size_t num_rows,
+                     const size_t num_cols,
+                     const size_t num_entries,
+                     const size_t chunk_size,
+                     const size_t sigma,
+                     ArrayType1 chunk_offsets,
+                     ArrayType2 row_permutation,
+                     ArrayType3 column_indices,
+                     ArrayType4 values)
+        : Parent(num_rows, num_cols, num_entries),
+          chunk_offsets(chunk_offsets),
+          row_permutation(row_permutation),
+          column_indices(column_indices),
+          values(values),
+          chunk_size(chunk_size),
+          sigma(sigma) {}
+
+    /*! Construct a \p sell_matrix_view from a existing \p sell_matrix.
+     *
+     *  \param matrix \p sell_matrix used to create view.
+     */
+    sell_matrix_view(sell_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          chunk_offsets(matrix.chunk_offsets),
+          row_permutation(matrix.row_permutation),
+          column_indices(matrix.column_indices),
+          values(matrix.values),
+          chunk_size(matrix.chunk_size),
+          sigma(matrix.sigma) {}
+
+    /*! Construct a \p sell_matrix_view from a existing const \p sell_matrix.
+     *
+     *  \param matrix \p sell_matrix used to create view.
+     */
+    sell_matrix_view(const sell_matrix<IndexType,ValueType,MemorySpace>& matrix)
+        : Parent(matrix),
+          chunk_offsets(matrix.chunk_offsets),
+          row_permutation(matrix.row_permutation),
+          column_indices(matrix.column_indices),
+          values(matrix.values),
+          chunk_size(matrix.chunk_size),
+          sigma(matrix.sigma) {}
+
+    /*! Construct a \p sell_matrix_view from a existing \p sell_matrix_view.
+     *
+     *  \param matrix \p sell_matrix_view used to create view.
+     */
+    sell_matrix_view(sell_matrix_view& matrix)
+        : Parent(matrix),
+          chunk_offsets(matrix.chunk_offsets),
+          row_permutation(matrix.row_permutation),
+          column_indices(matrix.column_indices),
+          values(matrix.values),
+          chunk_size(matrix.chunk_size),
+          sigma(matrix.sigma) {}
+
+    /*! Construct a \p sell_matrix_view from a existing const \p sell_matrix_view.
+     *
+     *  \param matrix \p sell_matrix_view used to create view.
+     */
+    sell_matrix_view(const sell_matrix_view& matrix)
+        : Parent(matrix),
+          chunk_offsets(matrix.chunk_offsets),
+          row_permutation(matrix.row_permutation),
+          column_indices(matrix.column_indices),
+          values(matrix.values),
+          chunk_size(matrix.chunk_size),
+          sigma(matrix.sigma) {}
+
+    /*! Resize matrix dimensions and underlying storage
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     *  \param num_slots Number of stored entries, including padding.
+     *  \param chunk_size Number of rows in each chunk.
+     *  \param sigma Number of consecutive rows sorted by length.
+     */
+    void resize(const size_t num_rows, const size_t num_cols, const size_t num_entries,
+                const size_t num_slots, const size_t chunk_size, const size_t sigma = 1);
+}; // class sell_matrix_view
+
+/**
+ *  This is a convenience function for generating a \p sell_matrix_view
+ *  using individual arrays
+ *  \tparam ArrayType1 chunk offsets array type
+ *  \tparam ArrayType2 row permutation array type
+ *  \tparam ArrayType3 column indices array type
+ *  \tparam ArrayType4 values array type
+ *
+ *  \param num_rows Number of rows.
+ *  \param num_cols Number of columns.
+ *  \param num_entries Number of nonzero matrix entries.
+ *  \param chunk_size Number of rows in each chunk.
+ *  \param sigma Number of consecutive rows sorted by length.
+ *  \param chunk_offsets Array containing the chunk offsets.
+ *  \param row_permutation Array containing the original index of each sorted row.
+ *  \param column_indices Array containing the column indices.
+ *  \param values Array containing the values.
+ *
+ *  \return \p sell_matrix_view constructed using input arrays
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ArrayType4>
+sell_matrix_view<ArrayType1,ArrayType2,ArrayType3,ArrayType4>
+make_sell_matrix_view(size_t num_rows,
+                      size_t num_cols,
+                      size_t num_entries,
+                      size_t chunk_size,
+                      size_t sigma,
+                      ArrayType1 chunk_offsets,
+                      ArrayType2 row_permutation,
+                      ArrayType3 column_indices,
+                      ArrayType4 values)
+{
+    sell_matrix_view<ArrayType1,ArrayType2,ArrayType3,ArrayType4>
+           view(num_rows, num_cols, num_entries, chunk_size, sigma,
+                chunk_offsets, row_permutation, column_indices, values);
+
+    return view;
+}
+
+/**
+ *  This is a convenience function for generating a \p sell_matrix_view
+ *  using an existing \p sell_matrix_view.
+ *
+ *  \param m Exemplar \p sell_matrix_view matrix to copy.
+ *
+ *  \return \p sell_matrix_view constructed using input matrix.
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ArrayType4,
+          typename IndexType,
+          typename ValueType,
+          typename MemorySpace>
+sell_matrix_view<ArrayType1,ArrayType2,ArrayType3,ArrayType4,IndexType,ValueType,MemorySpace>
+make_sell_matrix_view(const sell_matrix_view<ArrayType1,ArrayType2,ArrayType3,ArrayType4,IndexType,ValueType,MemorySpace>& m)
+{
+    return sell_matrix_view<ArrayType1,ArrayType2,ArrayType3,ArrayType4,IndexType,ValueType,MemorySpace>(m);
+}
+
+/**
+ *  This is a convenience function for generating a \p sell_matrix_view
+ *  using an existing \p sell_matrix.
+ *
+ *  \param m Exemplar \p sell_matrix matrix to copy.
+ *
+ *  \return \p sell_matrix_view constructed using input matrix.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename sell_matrix<IndexType,ValueType,MemorySpace>::view
+make_sell_matrix_view(sell_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_sell_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries, m.chunk_size, m.sigma,
+            make_array1d_view(m.chunk_offsets),
+            make_array1d_view(m.row_permutation),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.values));
+}
+
+/**
+ *  This is a convenience function for generating a const \p sell_matrix_view
+ *  using an existing \p sell_matrix.
+ *
+ *  \param m Exemplar \p sell_matrix matrix to copy.
+ *
+ *  \return \p sell_matrix_view constructed using input matrix.
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+typename sell_matrix<IndexType,ValueType,MemorySpace>::const_view
+make_sell_matrix_view(const sell_matrix<IndexType,ValueType,MemorySpace>& m)
+{
+    return make_sell_matrix_view
+           (m.num_rows, m.num_cols, m.num_entries, m.chunk_size, m.sigma,
+            make_array1d_view(m.chunk_offsets),
+            make_array1d_view(m.row_permutation),
+            make_array1d_view(m.column_indices),
+            make_array1d_view(m.values));
+}
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/sell_matrix.inl>
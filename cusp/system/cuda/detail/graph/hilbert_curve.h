@@ -22,7 +22,7 @@
 #include <cusp/exception.h>
 
 #include <thrust/extrema.h>
-#include <thrust/gather.h>
+#include <thrust/scatter.h>
 #include <thrust/sort.h>
 #include <thrust/transform.h>
 
@@ -202,18 +202,15 @@ struct hilbert_transform_3d : public thrust::unary_function<double,double>
     }
 };
 
+// perm[k] is the index of the k-th point along the Hilbert curve
 template <typename DerivedPolicy, typename Array2d, typename Array1d>
-void hilbert_curve(cuda::execution_policy<DerivedPolicy>& exec,
-                   const Array2d& coord,
-                   size_t num_parts,
-                   Array1d& parts)
+void hilbert_curve_order(cuda::execution_policy<DerivedPolicy>& exec,
+                         const Array2d& coord,
+                         Array1d& perm)
 {
-    typedef typename Array1d::value_type PartType;
     typedef typename Array2d::const_column_view::iterator Iterator;
     typedef typename Array2d::value_type ValueType;
-    typedef typename Array2d::memory_space MemorySpace;
 
-    size_t num_points = coord.num_rows;
     size_t dims = coord.num_cols;
 
     if( (dims != 2) && (dims != 3) )
@@ -254,15 +251,45 @@ void hilbert_curve(cuda::execution_policy<DerivedPolicy>& exec,
                           hilbert_keys.begin(), hilbert_transform_3d());
     }
 
-    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
     thrust::sequence(exec, perm.begin(), perm.end());
     thrust::sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), perm.begin());
+}
+
+template <typename DerivedPolicy, typename Array2d, typename Array1d>
+void hilbert_curve(cuda::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   size_t num_parts,
+                   Array1d& parts)
+{
+    typedef typename Array1d::value_type PartType;
+
+    size_t num_points = coord.num_rows;
+
+    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
+    hilbert_curve_order(exec, coord, perm);
 
     cusp::detail::temporary_array<PartType, DerivedPolicy> uniform_parts(exec, num_points);
     thrust::transform(exec,
                       thrust::counting_iterator<PartType>(0), thrust::counting_iterator<PartType>(num_points),
                       thrust::constant_iterator<PartType>(num_points/num_parts), uniform_parts.begin(), thrust::divides<PartType>());
-    thrust::gather(exec, perm.begin(), perm.end(), uniform_parts.begin(), parts.begin());
+    thrust::scatter(exec, uniform_parts.begin(), uniform_parts.end(), perm.begin(), parts.begin());
+}
+
+template <typename DerivedPolicy, typename Array2d, typename PermutationType>
+void hilbert_curve_permutation(cuda::execution_policy<DerivedPolicy>& exec,
+                               const Array2d& coord,
+                               PermutationType& P)
+{
+    typedef typename PermutationType::index_type IndexType;
+
+    size_t num_points = coord.num_rows;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> perm(exec, num_points);
+    hilbert_curve_order(exec, coord, perm);
+
+    thrust::scatter(exec,
+                    thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(num_points),
+                    perm.begin(), P.permutation.begin());
 }
 
 } // end namespace detail
@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/format.h>
+
+#include <cusp/bsr_matrix.h>
+#include <cusp/format_utils.h>
+#include <cusp/functional.h>
+#include <cusp/sort.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <thrust/copy.h>
+#include <thrust/gather.h>
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// maps (scalar index, block row) to the global row of a stored block entry
+template <typename IndexType>
+struct bsr_row_functor : public thrust::unary_function<thrust::tuple<IndexType,IndexType>,IndexType>
+{
+    IndexType block_size;
+
+    bsr_row_functor(IndexType block_size)
+        : block_size(block_size) {}
+
+    template<typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        IndexType n         = thrust::get<0>(t);
+        IndexType block_row = thrust::get<1>(t);
+
+        return block_row * block_size + (n / block_size) % block_size;
+    }
+};
+
+// maps (scalar index, block column) to the global column of a stored block entry
+template <typename IndexType>
+struct bsr_column_functor : public thrust::unary_function<thrust::tuple<IndexType,IndexType>,IndexType>
+{
+    IndexType block_size;
+
+    bsr_column_functor(IndexType block_size)
+        : block_size(block_size) {}
+
+    template<typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        IndexType n         = thrust::get<0>(t);
+        IndexType block_col = thrust::get<1>(t);
+
+        return block_col * block_size + n % block_size;
+    }
+};
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::bsr_format&,
+        cusp::coo_format&)
+{
+    typedef typename SourceType::index_type   IndexType;
+    typedef typename SourceType::value_type   ValueType;
+
+    typedef thrust::counting_iterator<IndexType>                                      IndexIterator;
+    typedef thrust::transform_iterator<cusp::divide_value<IndexType>, IndexIterator>  BlockIndexIterator;
+
+    // allocate output storage
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if( src.num_entries == 0 ) return;
+
+    const IndexType block_size  = src.block_size;
+    const IndexType num_blocks  = src.column_indices.size();
+    const IndexType num_values  = num_blocks * block_size * block_size;
+
+    // expand block row offsets to block row indices
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_row_indices(exec, num_blocks);
+    cusp::offsets_to_indices(exec, src.row_offsets, block_row_indices);
+
+    // replicate the block coordinates for every stored entry of each block
+    BlockIndexIterator block_index_begin(IndexIterator(0), cusp::divide_value<IndexType>(block_size * block_size));
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_indices(exec, num_values);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> column_indices(exec, num_values);
+
+    thrust::gather(exec,
+                   block_index_begin, block_index_begin + num_values,
+                   block_row_indices.begin(),
+                   row_indices.begin());
+    thrust::gather(exec,
+                   block_index_begin, block_index_begin + num_values,
+                   src.column_indices.begin(),
+                   column_indices.begin());
+
+    // offset block coordinates by the position of each entry within its block
+    thrust::transform(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(IndexIterator(0), row_indices.begin())),
+                      thrust::make_zip_iterator(thrust::make_tuple(IndexIterator(0), row_indices.begin())) + num_values,
+                      row_indices.begin(),
+                      bsr_row_functor<IndexType>(block_size));
+    thrust::transform(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(IndexIterator(0), column_indices.begin())),
+                      thrust::make_zip_iterator(thrust::make_tuple(IndexIterator(0), column_indices.begin())) + num_values,
+                      column_indices.begin(),
+                      bsr_column_functor<IndexType>(block_size));
+
+    // drop explicit zeros stored inside the dense blocks
+    thrust::copy_if
+     (exec,
+      thrust::make_zip_iterator(thrust::make_tuple(row_indices.begin(), column_indices.begin(), src.values.begin())),
+      thrust::make_zip_iterator(thrust::make_tuple(row_indices.begin(), column_indices.begin(), src.values.begin())) + num_values,
+      src.values.begin(),
+      thrust::make_zip_iterator(thrust::make_tuple(dst.row_indices.begin(), dst.column_indices.begin(), dst.values.begin())),
+      thrust::placeholders::_1 != ValueType(0));
+
+    // entries of adjacent blocks in the same block row interleave
+    cusp::sort_by_row_and_column(exec, dst.row_indices, dst.column_indices, dst.values);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -20,6 +20,8 @@
 #include <cusp/copy.h>
 #include <cusp/coo_matrix.h>
 #include <cusp/format_utils.h>
+#include <cusp/functional.h>
+#include <cusp/sort.h>
 
 #include <cusp/blas/blas.h>
 
@@ -28,15 +30,22 @@
 
 #include <thrust/count.h>
 #include <thrust/gather.h>
+#include <thrust/functional.h>
 #include <thrust/inner_product.h>
+#include <thrust/reduce.h>
 #include <thrust/replace.h>
 #include <thrust/scan.h>
 #include <thrust/scatter.h>
 #include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
 #include <thrust/tuple.h>
 
 #include <thrust/iterator/constant_iterator.h>
 #include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
 #include <thrust/iterator/zip_iterator.h>
 
 #include <algorithm>
@@ -71,6 +80,46 @@ struct array2d_map_functor : public thrust::unary_function<IndexType,IndexType>
     }
 };
 
+template <typename IndexType>
+struct bsr_map_functor : public thrust::unary_function<IndexType,IndexType>
+{
+    IndexType block_size;
+
+    bsr_map_functor(IndexType block_size)
+        : block_size(block_size) {}
+
+    template<typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        IndexType block = thrust::get<0>(t);
+        IndexType row   = thrust::get<1>(t);
+        IndexType col   = thrust::get<2>(t);
+
+        return (block * block_size + row % block_size) * block_size + col % block_size;
+    }
+};
+
+template <typename IndexType>
+struct sell_map_functor : public thrust::unary_function<IndexType,IndexType>
+{
+    IndexType chunk_size;
+
+    sell_map_functor(IndexType chunk_size)
+        : chunk_size(chunk_size) {}
+
+    template<typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        IndexType chunk_start = thrust::get<0>(t);
+        IndexType slot        = thrust::get<1>(t);
+        IndexType n           = thrust::get<2>(t);
+
+        return chunk_start + n * chunk_size + slot % chunk_size;
+    }
+};
+
 template <typename DerivedPolicy, typename SourceType, typename DestinationType>
 void
 convert(thrust::execution_policy<DerivedPolicy>& exec,
@@ -377,6 +426,246 @@ convert(thrust::execution_policy<DerivedPolicy>& exec,
 //                     less_than<size_t>(dst.ell.column_indices.values.size()));
 }
 
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::bsr_format&,
+        size_t block_size = 0)
+{
+    typedef typename DestinationType::index_type   IndexType;
+    typedef typename DestinationType::value_type   ValueType;
+
+    typedef typename SourceType::row_indices_array_type::const_iterator           RowIterator;
+    typedef typename SourceType::column_indices_array_type::const_iterator        ColumnIterator;
+    typedef typename SourceType::values_array_type::const_iterator                ValueIterator;
+    typedef typename cusp::detail::temporary_array<IndexType, DerivedPolicy>::iterator PermIterator;
+
+    // use the block size requested by the caller, then the block size of dst
+    if(block_size == 0)
+        block_size = dst.block_size == 0 ? 1 : dst.block_size;
+
+    if((src.num_rows % block_size) != 0 || (src.num_cols % block_size) != 0)
+        throw cusp::format_conversion_exception("bsr_matrix dimensions must be divisible by block_size");
+
+    if(src.num_entries == 0)
+    {
+        dst.resize(src.num_rows, src.num_cols, 0, 0, block_size);
+        thrust::fill(exec, dst.row_offsets.begin(), dst.row_offsets.end(), IndexType(0));
+        return;
+    }
+
+    // compute the block coordinates of every entry
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_rows(exec, src.num_entries);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_cols(exec, src.num_entries);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> permutation(exec, src.num_entries);
+
+    thrust::transform(exec, src.row_indices.begin(), src.row_indices.end(),
+                      block_rows.begin(), cusp::divide_value<IndexType>(block_size));
+    thrust::transform(exec, src.column_indices.begin(), src.column_indices.end(),
+                      block_cols.begin(), cusp::divide_value<IndexType>(block_size));
+    thrust::sequence(exec, permutation.begin(), permutation.end());
+
+    // group entries belonging to the same block
+    cusp::sort_by_row_and_column(exec, block_rows, block_cols, permutation);
+
+    // enumerate the distinct blocks, e.g. [0, 0, 1, 1, 1, 2, ...]
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_map(exec, src.num_entries, IndexType(0));
+    thrust::transform(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(block_rows.begin(), block_cols.begin())) + 1,
+                      thrust::make_zip_iterator(thrust::make_tuple(block_rows.end(),   block_cols.end())),
+                      thrust::make_zip_iterator(thrust::make_tuple(block_rows.begin(), block_cols.begin())),
+                      block_map.begin() + 1,
+                      thrust::not_equal_to< thrust::tuple<IndexType,IndexType> >());
+
+    const size_t num_blocks = thrust::reduce(exec, block_map.begin(), block_map.end(), IndexType(0)) + 1;
+    thrust::inclusive_scan(exec, block_map.begin(), block_map.end(), block_map.begin());
+
+    const size_t num_values  = num_blocks * block_size * block_size;
+    const float max_fill     = 3.0;
+    const float threshold    = 1e6; // 1M entries
+    const float fill_ratio   = float(num_values) / std::max(1.0f, float(src.num_entries));
+
+    if (max_fill < fill_ratio && float(num_values) > threshold)
+        throw cusp::format_conversion_exception("bsr_matrix fill-in would exceed maximum tolerance");
+
+    size_t num_entries = src.num_entries - thrust::count(exec, src.values.begin(), src.values.end(), ValueType(0));
+
+    // allocate output storage
+    dst.resize(src.num_rows, src.num_cols, num_entries, num_blocks, block_size);
+
+    // record the block row and block column of each distinct block
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> block_row_indices(exec, num_blocks);
+
+    thrust::scatter(exec,
+                    thrust::make_zip_iterator(thrust::make_tuple(block_rows.begin(), block_cols.begin())),
+                    thrust::make_zip_iterator(thrust::make_tuple(block_rows.end(),   block_cols.end())),
+                    block_map.begin(),
+                    thrust::make_zip_iterator(thrust::make_tuple(block_row_indices.begin(), dst.column_indices.begin())));
+
+    cusp::indices_to_offsets(exec, block_row_indices, dst.row_offsets);
+
+    // scatter COO entries into the dense blocks
+    thrust::permutation_iterator<RowIterator,PermIterator>    rows_begin(src.row_indices.begin(),    permutation.begin());
+    thrust::permutation_iterator<ColumnIterator,PermIterator> cols_begin(src.column_indices.begin(), permutation.begin());
+    thrust::permutation_iterator<ValueIterator,PermIterator>  vals_begin(src.values.begin(),         permutation.begin());
+
+    thrust::fill(exec, dst.values.begin(), dst.values.end(), ValueType(0));
+
+    thrust::scatter(exec,
+                    vals_begin, vals_begin + src.num_entries,
+                    thrust::make_transform_iterator(
+                        thrust::make_zip_iterator(thrust::make_tuple(block_map.begin(), rows_begin, cols_begin)),
+                        bsr_map_functor<IndexType>(block_size)),
+                    dst.values.begin());
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::coo_format&,
+        cusp::sell_format&,
+        size_t chunk_size = 0,
+        size_t sigma = 0)
+{
+    typedef typename DestinationType::index_type   IndexType;
+    typedef typename DestinationType::value_type   ValueType;
+
+    typedef thrust::counting_iterator<IndexType>                                      IndexIterator;
+    typedef thrust::transform_iterator<cusp::divide_value<IndexType>, IndexIterator>  ChunkIndexIterator;
+
+    // use the parameters requested by the caller, then the parameters of dst
+    if(chunk_size == 0)
+        chunk_size = dst.chunk_size == 0 ? 8 : dst.chunk_size;
+    if(sigma == 0)
+        sigma = dst.sigma == 0 ? 1 : dst.sigma;
+
+    const size_t num_chunks = (src.num_rows + chunk_size - 1) / chunk_size;
+
+    if(src.num_entries == 0)
+    {
+        dst.resize(src.num_rows, src.num_cols, 0, 0, chunk_size, sigma);
+        thrust::fill(exec, dst.chunk_offsets.begin(), dst.chunk_offsets.end(), IndexType(0));
+        thrust::sequence(exec, dst.row_permutation.begin(), dst.row_permutation.end());
+        return;
+    }
+
+    // compute the length of each row
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, src.num_rows + 1);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_lengths(exec, src.num_rows);
+    cusp::indices_to_offsets(exec, src.row_indices, row_offsets);
+
+    thrust::transform(exec,
+                      row_offsets.begin() + 1, row_offsets.end(),
+                      row_offsets.begin(),
+                      row_lengths.begin(),
+                      thrust::minus<IndexType>());
+
+    // sort the rows within each window of sigma rows by decreasing length
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> permutation(exec, src.num_rows);
+    thrust::sequence(exec, permutation.begin(), permutation.end());
+
+    if(sigma > 1)
+    {
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> keys(exec, row_lengths.begin(), row_lengths.end());
+        thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), permutation.begin(), thrust::greater<IndexType>());
+
+        // a stable sort by window preserves the length order within each window
+        thrust::transform(exec, permutation.begin(), permutation.end(), keys.begin(), cusp::divide_value<IndexType>(sigma));
+        thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), permutation.begin());
+    }
+
+    // the width of each chunk is the length of its longest row
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> sorted_lengths(exec, src.num_rows);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> chunk_widths(exec, num_chunks);
+
+    thrust::gather(exec, permutation.begin(), permutation.end(), row_lengths.begin(), sorted_lengths.begin());
+
+    ChunkIndexIterator chunk_index_begin(IndexIterator(0), cusp::divide_value<IndexType>(chunk_size));
+
+    thrust::reduce_by_key(exec,
+                          chunk_index_begin, chunk_index_begin + src.num_rows,
+                          sorted_lengths.begin(),
+                          thrust::make_discard_iterator(),
+                          chunk_widths.begin(),
+                          thrust::equal_to<IndexType>(),
+                          thrust::maximum<IndexType>());
+
+    const size_t num_slots = size_t(thrust::reduce(exec, chunk_widths.begin(), chunk_widths.end(), IndexType(0))) * chunk_size;
+
+    const float max_fill   = 3.0;
+    const float threshold  = 1e6; // 1M entries
+    const float fill_ratio = float(num_slots) / std::max(1.0f, float(src.num_entries));
+
+    if (max_fill < fill_ratio && float(num_slots) > threshold)
+        throw cusp::format_conversion_exception("sell_matrix fill-in would exceed maximum tolerance");
+
+    size_t num_entries = src.num_entries - thrust::count(exec, src.values.begin(), src.values.end(), ValueType(0));
+
+    // allocate output storage
+    dst.resize(src.num_rows, src.num_cols, num_entries, num_slots, chunk_size, sigma);
+
+    thrust::fill(exec, dst.chunk_offsets.begin(), dst.chunk_offsets.begin() + 1, IndexType(0));
+    thrust::transform_inclusive_scan(exec,
+                                     chunk_widths.begin(), chunk_widths.end(),
+                                     dst.chunk_offsets.begin() + 1,
+                                     cusp::multiplies_value<IndexType>(chunk_size),
+                                     thrust::plus<IndexType>());
+
+    thrust::copy(exec, permutation.begin(), permutation.end(), dst.row_permutation.begin());
+
+    // compute the sorted position (slot) of every row
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_slots(exec, src.num_rows);
+    thrust::scatter(exec,
+                    IndexIterator(0), IndexIterator(src.num_rows),
+                    permutation.begin(),
+                    row_slots.begin());
+
+    // enumerate the entries within each row, e.g. [0, 1, 2, 0, 1, 2, 3, ...]
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> entry_index(exec, src.num_entries);
+    thrust::exclusive_scan_by_key(exec,
+                                  src.row_indices.begin(), src.row_indices.end(),
+                                  thrust::constant_iterator<IndexType>(1),
+                                  entry_index.begin(),
+                                  IndexType(0));
+
+    // look up the slot and chunk offset of each entry
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> entry_slots(exec, src.num_entries);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> chunk_starts(exec, src.num_entries);
+
+    thrust::gather(exec, src.row_indices.begin(), src.row_indices.end(), row_slots.begin(), entry_slots.begin());
+    thrust::gather(exec,
+                   thrust::make_transform_iterator(entry_slots.begin(), cusp::divide_value<IndexType>(chunk_size)),
+                   thrust::make_transform_iterator(entry_slots.end(),   cusp::divide_value<IndexType>(chunk_size)),
+                   dst.chunk_offsets.begin(),
+                   chunk_starts.begin());
+
+    // entry n of slot r in chunk c is stored at chunk_offsets[c] + n * chunk_size + r % chunk_size
+    thrust::transform(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(chunk_starts.begin(), entry_slots.begin(), entry_index.begin())),
+                      thrust::make_zip_iterator(thrust::make_tuple(chunk_starts.end(),   entry_slots.end(),   entry_index.end())),
+                      entry_index.begin(),
+                      sell_map_functor<IndexType>(chunk_size));
+
+    // fill output with padding
+    thrust::fill(exec, dst.column_indices.begin(), dst.column_indices.end(), IndexType(-1));
+    thrust::fill(exec, dst.values.begin(),         dst.values.end(),         ValueType(0));
+
+    // scatter COO entries to SELL
+    thrust::scatter(exec,
+                    src.column_indices.begin(), src.column_indices.end(),
+                    entry_index.begin(),
+                    dst.column_indices.begin());
+    thrust::scatter(exec,
+                    src.values.begin(), src.values.end(),
+                    entry_index.begin(),
+                    dst.values.begin());
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
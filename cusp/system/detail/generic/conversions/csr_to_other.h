@@ -18,6 +18,7 @@
 #pragma once
 
 #include <cusp/copy.h>
+#include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/format_utils.h>
 #include <cusp/sort.h>
@@ -27,6 +28,8 @@
 #include <cusp/detail/format.h>
 #include <cusp/detail/temporary_array.h>
 
+#include <cusp/system/detail/generic/conversions/coo_to_other.h>
+
 #include <thrust/count.h>
 #include <thrust/gather.h>
 #include <thrust/inner_product.h>
@@ -305,6 +308,61 @@ convert(thrust::execution_policy<DerivedPolicy>& exec,
                        cusp::less_value<size_t>(dst.ell.values.values.size()));
 }
 
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::bsr_format&,
+        size_t block_size = 0)
+{
+    typedef typename DestinationType::index_type   IndexType;
+
+    // expand row offsets into row indices
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_indices(exec, src.num_entries);
+    cusp::offsets_to_indices(exec, src.row_offsets, row_indices);
+
+    // reuse the COO conversion on a view that shares columns and values with src
+    cusp::coo_format format1;
+    cusp::bsr_format format2;
+
+    convert(exec,
+            cusp::make_coo_matrix_view(src.num_rows, src.num_cols, src.num_entries,
+                                       cusp::make_array1d_view(row_indices.begin(), row_indices.end()),
+                                       cusp::make_array1d_view(src.column_indices.begin(), src.column_indices.end()),
+                                       cusp::make_array1d_view(src.values.begin(), src.values.end())),
+            dst, format1, format2, block_size);
+}
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::csr_format&,
+        cusp::sell_format&,
+        size_t chunk_size = 0,
+        size_t sigma = 0)
+{
+    typedef typename DestinationType::index_type   IndexType;
+
+    // expand row offsets into row indices
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_indices(exec, src.num_entries);
+    cusp::offsets_to_indices(exec, src.row_offsets, row_indices);
+
+    // reuse the COO conversion on a view that shares columns and values with src
+    cusp::coo_format  format1;
+    cusp::sell_format format2;
+
+    convert(exec,
+            cusp::make_coo_matrix_view(src.num_rows, src.num_cols, src.num_entries,
+                                       cusp::make_array1d_view(row_indices.begin(), row_indices.end()),
+                                       cusp::make_array1d_view(src.column_indices.begin(), src.column_indices.end()),
+                                       cusp::make_array1d_view(src.values.begin(), src.values.end())),
+            dst, format1, format2, chunk_size, sigma);
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
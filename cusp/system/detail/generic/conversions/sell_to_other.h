@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/format.h>
+
+#include <cusp/format_utils.h>
+#include <cusp/sell_matrix.h>
+#include <cusp/sort.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <thrust/copy.h>
+#include <thrust/gather.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// maps (storage index, chunk, chunk offset) to the sorted row (slot) of a stored entry
+template <typename IndexType>
+struct sell_slot_functor : public thrust::unary_function<thrust::tuple<IndexType,IndexType,IndexType>,IndexType>
+{
+    IndexType chunk_size;
+
+    sell_slot_functor(IndexType chunk_size)
+        : chunk_size(chunk_size) {}
+
+    template<typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        IndexType n           = thrust::get<0>(t);
+        IndexType chunk       = thrust::get<1>(t);
+        IndexType chunk_start = thrust::get<2>(t);
+
+        return chunk * chunk_size + (n - chunk_start) % chunk_size;
+    }
+};
+
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void
+convert(thrust::execution_policy<DerivedPolicy>& exec,
+        const SourceType& src,
+        DestinationType& dst,
+        cusp::sell_format&,
+        cusp::coo_format&)
+{
+    typedef typename SourceType::index_type   IndexType;
+    typedef typename SourceType::value_type   ValueType;
+
+    typedef thrust::counting_iterator<IndexType>                                              IndexIterator;
+    typedef typename cusp::detail::temporary_array<IndexType, DerivedPolicy>::iterator        ChunkIterator;
+    typedef typename SourceType::chunk_offsets_array_type::const_iterator                     OffsetIterator;
+    typedef thrust::permutation_iterator<OffsetIterator, ChunkIterator>                       ChunkStartIterator;
+    typedef thrust::tuple<IndexIterator, ChunkIterator, ChunkStartIterator>                   SlotTuple;
+    typedef thrust::transform_iterator<sell_slot_functor<IndexType>,
+                                       thrust::zip_iterator<SlotTuple> >                      SlotIterator;
+
+    // allocate output storage
+    dst.resize(src.num_rows, src.num_cols, src.num_entries);
+
+    if( src.num_entries == 0 ) return;
+
+    const IndexType num_slots = src.column_indices.size();
+
+    // determine the chunk of every stored entry
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> chunk_indices(exec, num_slots);
+    cusp::offsets_to_indices(exec, src.chunk_offsets, chunk_indices);
+
+    SlotIterator slots_begin(thrust::make_zip_iterator(thrust::make_tuple(
+                                 IndexIterator(0),
+                                 chunk_indices.begin(),
+                                 ChunkStartIterator(src.chunk_offsets.begin(), chunk_indices.begin()))),
+                             sell_slot_functor<IndexType>(src.chunk_size));
+
+    // drop padding and explicit zeros
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> slots(exec, src.num_entries);
+
+    thrust::copy_if
+     (exec,
+      thrust::make_zip_iterator(thrust::make_tuple(slots_begin, src.column_indices.begin(), src.values.begin())),
+      thrust::make_zip_iterator(thrust::make_tuple(slots_begin, src.column_indices.begin(), src.values.begin())) + num_slots,
+      src.values.begin(),
+      thrust::make_zip_iterator(thrust::make_tuple(slots.begin(), dst.column_indices.begin(), dst.values.begin())),
+      thrust::placeholders::_1 != ValueType(0));
+
+    // map sorted rows back to the original rows
+    thrust::gather(exec,
+                   slots.begin(), slots.end(),
+                   src.row_permutation.begin(),
+                   dst.row_indices.begin());
+
+    // entries of each row are interleaved with the other rows of its chunk
+    cusp::sort_by_row_and_column(exec, dst.row_indices, dst.column_indices, dst.values);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
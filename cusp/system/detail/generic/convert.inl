@@ -21,12 +21,14 @@
 #include <cusp/detail/type_traits.h>
 
 #include <cusp/system/detail/generic/conversions/array_to_other.h>
+#include <cusp/system/detail/generic/conversions/bsr_to_other.h>
 #include <cusp/system/detail/generic/conversions/coo_to_other.h>
 #include <cusp/system/detail/generic/conversions/csr_to_other.h>
 #include <cusp/system/detail/generic/conversions/dia_to_other.h>
 #include <cusp/system/detail/generic/conversions/ell_to_other.h>
 #include <cusp/system/detail/generic/conversions/hyb_to_other.h>
 #include <cusp/system/detail/generic/conversions/permutation_to_other.h>
+#include <cusp/system/detail/generic/conversions/sell_to_other.h>
 
 namespace cusp
 {
@@ -64,6 +64,34 @@ void copy(thrust::execution_policy<DerivedPolicy>& exec,
     cusp::copy(exec, src.values,         dst.values);
 }
 
+template <typename DerivedPolicy, typename T1, typename T2>
+void copy(thrust::execution_policy<DerivedPolicy>& exec,
+          const T1& src, T2& dst,
+          cusp::bsr_format,
+          cusp::bsr_format)
+{
+    copy_matrix_dimensions(src, dst);
+    dst.block_size = src.block_size;
+    cusp::copy(exec, src.row_offsets,    dst.row_offsets);
+    cusp::copy(exec, src.column_indices, dst.column_indices);
+    cusp::copy(exec, src.values,         dst.values);
+}
+
+template <typename DerivedPolicy, typename T1, typename T2>
+void copy(thrust::execution_policy<DerivedPolicy>& exec,
+          const T1& src, T2& dst,
+          cusp::sell_format,
+          cusp::sell_format)
+{
+    copy_matrix_dimensions(src, dst);
+    dst.chunk_size = src.chunk_size;
+    dst.sigma      = src.sigma;
+    cusp::copy(exec, src.chunk_offsets,   dst.chunk_offsets);
+    cusp::copy(exec, src.row_permutation, dst.row_permutation);
+    cusp::copy(exec, src.column_indices,  dst.column_indices);
+    cusp::copy(exec, src.values,          dst.values);
+}
+
 template <typename DerivedPolicy, typename T1, typename T2>
 void copy(thrust::execution_policy<DerivedPolicy>& exec,
           const T1& src, T2& dst,
@@ -74,6 +74,16 @@ size_t count_diagonals(thrust::execution_policy<DerivedPolicy> &exec,
                        const ArrayType1& row_indices,
                        const ArrayType2& column_indices );
 
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+size_t compute_bandwidth(thrust::execution_policy<DerivedPolicy> &exec,
+                         const ArrayType1& row_indices,
+                         const ArrayType2& column_indices);
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+size_t compute_profile(thrust::execution_policy<DerivedPolicy> &exec,
+                       const ArrayType1& row_indices,
+                       const ArrayType2& column_indices);
+
 template <typename DerivedPolicy, typename ArrayType>
 size_t compute_max_entries_per_row(thrust::execution_policy<DerivedPolicy> &exec,
                                    const ArrayType& row_offsets);
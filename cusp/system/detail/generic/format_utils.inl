@@ -28,14 +28,24 @@
 #include <thrust/fill.h>
 #include <thrust/gather.h>
 #include <thrust/inner_product.h>
+#include <thrust/reduce.h>
 #include <thrust/scan.h>
 #include <thrust/scatter.h>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
+
+#include <thrust/iterator/discard_iterator.h>
 
 namespace cusp
 {
+
+// Forward definitions
+template <typename DerivedPolicy, typename SourceType, typename DestinationType>
+void convert(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+             const SourceType& src, DestinationType& dst);
+
 namespace system
 {
 namespace detail
@@ -169,6 +179,36 @@ void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
      cusp::equal_pair_functor<IndexType>());
 }
 
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::bsr_format)
+{
+    typedef typename Matrix::container ContainerType;
+
+    // extract diagonal from the COO expansion of the blocks
+    typename cusp::detail::as_coo_type<ContainerType>::type A_coo;
+    cusp::convert(exec, A, A_coo);
+
+    extract_diagonal(exec, A_coo, output, cusp::coo_format());
+}
+
+template <typename DerivedPolicy, typename Matrix, typename Array>
+void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
+                      const Matrix& A,
+                      Array& output,
+                      cusp::sell_format)
+{
+    typedef typename Matrix::container ContainerType;
+
+    // extract diagonal from the COO expansion of the chunks
+    typename cusp::detail::as_coo_type<ContainerType>::type A_coo;
+    cusp::convert(exec, A, A_coo);
+
+    extract_diagonal(exec, A_coo, output, cusp::coo_format());
+}
+
 template <typename DerivedPolicy, typename Matrix, typename Array>
 void extract_diagonal(thrust::execution_policy<DerivedPolicy> &exec,
                       const Matrix& A, Array& output)
@@ -245,6 +285,48 @@ size_t count_diagonals(thrust::execution_policy<DerivedPolicy> &exec,
     return thrust::reduce(exec, values.begin(), values.end());
 }
 
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+size_t compute_bandwidth(thrust::execution_policy<DerivedPolicy> &exec,
+                         const ArrayType1& row_indices,
+                         const ArrayType2& column_indices)
+{
+    typedef typename ArrayType1::value_type IndexType;
+
+    return thrust::transform_reduce(exec,
+                                    thrust::make_zip_iterator(thrust::make_tuple(row_indices.begin(), column_indices.begin())),
+                                    thrust::make_zip_iterator(thrust::make_tuple(row_indices.end(), column_indices.end())),
+                                    cusp::detail::entry_bandwidth_functor<IndexType>(),
+                                    IndexType(0),
+                                    thrust::maximum<IndexType>());
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+size_t compute_profile(thrust::execution_policy<DerivedPolicy> &exec,
+                       const ArrayType1& row_indices,
+                       const ArrayType2& column_indices)
+{
+    typedef typename ArrayType1::value_type IndexType;
+
+    const size_t num_entries = row_indices.size();
+
+    // distance of the first entry of every row from the diagonal
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_profiles(exec, num_entries);
+
+    size_t num_profile_rows =
+        thrust::reduce_by_key(exec,
+                              row_indices.begin(), row_indices.end(),
+                              thrust::make_transform_iterator(
+                                  thrust::make_zip_iterator(
+                                      thrust::make_tuple(row_indices.begin(), column_indices.begin())),
+                                  cusp::detail::entry_profile_functor<IndexType>()),
+                              thrust::make_discard_iterator(),
+                              row_profiles.begin(),
+                              thrust::equal_to<IndexType>(),
+                              thrust::maximum<IndexType>()).second - row_profiles.begin();
+
+    return thrust::reduce(exec, row_profiles.begin(), row_profiles.begin() + num_profile_rows, size_t(0));
+}
+
 
 template <typename DerivedPolicy, typename ArrayType>
 size_t compute_max_entries_per_row(thrust::execution_policy<DerivedPolicy> &exec,
@@ -43,6 +43,16 @@ void hilbert_curve(thrust::execution_policy<DerivedPolicy>& exec,
   throw cusp::not_implemented_exception("No generic Hilbert curve");
 }
 
+template <typename DerivedPolicy,
+          typename Array2d,
+          typename PermutationType>
+void hilbert_curve_permutation(thrust::execution_policy<DerivedPolicy>& exec,
+                               const Array2d& coord,
+                                     PermutationType& P)
+{
+  throw cusp::not_implemented_exception("No generic Hilbert curve");
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
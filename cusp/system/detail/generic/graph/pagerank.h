@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/array1d.h>
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <cusp/blas/blas.h>
+
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
+
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// damping * rank / degree for every vertex with outgoing edges
+template <typename ValueType>
+struct pagerank_scale_functor
+{
+    const ValueType damping;
+
+    pagerank_scale_functor(const ValueType damping)
+        : damping(damping) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    ValueType operator()(const Tuple& t) const
+    {
+        const ValueType rank = thrust::get<0>(t);
+        const ValueType degree = ValueType(thrust::get<1>(t));
+
+        return degree == ValueType(0) ? ValueType(0) : damping * rank / degree;
+    }
+};
+
+// rank of every vertex without outgoing edges
+template <typename ValueType>
+struct pagerank_dangling_functor
+{
+    template <typename Tuple>
+    __host__ __device__
+    ValueType operator()(const Tuple& t) const
+    {
+        return thrust::get<1>(t) == 0 ? ValueType(thrust::get<0>(t)) : ValueType(0);
+    }
+};
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType,
+         typename Monitor>
+void pagerank(thrust::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& G,
+                    ArrayType& ranks,
+                    Monitor& monitor,
+              const double damping,
+              cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename ArrayType::value_type  ValueType;
+
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t N = G.num_rows;
+
+    if(N == 0)
+        return;
+
+    // rank flows along the edges into every vertex
+    CsrMatrix G_t;
+    cusp::transpose(exec, G, G_t);
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> degrees(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> scaled(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> next(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> residual(exec, N);
+
+    thrust::transform(exec,
+                      G.row_offsets.begin() + 1, G.row_offsets.end(),
+                      G.row_offsets.begin(), degrees.begin(),
+                      thrust::minus<IndexType>());
+
+    thrust::fill(exec, ranks.begin(), ranks.end(), ValueType(1) / ValueType(N));
+
+    do
+    {
+        ValueType dangling =
+            thrust::transform_reduce(exec,
+                                     thrust::make_zip_iterator(thrust::make_tuple(ranks.begin(), degrees.begin())),
+                                     thrust::make_zip_iterator(thrust::make_tuple(ranks.end(), degrees.end())),
+                                     pagerank_dangling_functor<ValueType>(),
+                                     ValueType(0),
+                                     thrust::plus<ValueType>());
+
+        thrust::transform(exec,
+                          thrust::make_zip_iterator(thrust::make_tuple(ranks.begin(), degrees.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(ranks.end(), degrees.end())),
+                          scaled.begin(),
+                          pagerank_scale_functor<ValueType>(damping));
+
+        // random jumps and the rank of dangling vertices reach every vertex
+        const ValueType teleport = (ValueType(1) - ValueType(damping) + ValueType(damping) * dangling) / ValueType(N);
+
+        // next <- teleport + G^T * scaled
+        cusp::generalized_spmv(exec, G_t, scaled, cusp::constant_array<ValueType>(N, teleport), next,
+                               thrust::project2nd<ValueType,ValueType>(), thrust::plus<ValueType>());
+
+        // residual <- next - ranks
+        cusp::blas::axpby(exec, next, ranks, residual, ValueType(1), ValueType(-1));
+        cusp::blas::copy(exec, next, ranks);
+
+        ++monitor;
+    }
+    while(!monitor.finished(exec, residual));
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType,
+         typename Monitor>
+void pagerank(thrust::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& G,
+                    ArrayType& ranks,
+                    Monitor& monitor,
+              const double damping,
+              cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    cusp::graph::pagerank(exec, G_csr, ranks, monitor, damping);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType,
+         typename Monitor>
+void pagerank(thrust::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& G,
+                    ArrayType& ranks,
+                    Monitor& monitor,
+              const double damping)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    pagerank(thrust::detail::derived_cast(exec), G, ranks, monitor, damping, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <cusp/blas/blas.h>
+
+#include <thrust/equal.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+
+#include <limits>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// (min,+) semiring product of an edge weight and a distance, where the
+// largest representable distance marks an unreachable vertex
+template <typename ValueType>
+struct shortest_path_combine_functor
+{
+    const ValueType infinity;
+
+    shortest_path_combine_functor(void)
+        : infinity(std::numeric_limits<ValueType>::max()) {}
+
+    template <typename WeightType>
+    __host__ __device__
+    ValueType operator()(const WeightType& weight, const ValueType& distance) const
+    {
+        return distance == infinity ? infinity : distance + ValueType(weight);
+    }
+};
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+void single_source_shortest_path(thrust::execution_policy<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances,
+                                 cusp::csr_format)
+{
+    typedef typename ArrayType::value_type ValueType;
+
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const size_t N = G.num_rows;
+
+    if(N == 0)
+        return;
+
+    // distances flow along the edges into every vertex
+    CsrMatrix G_t;
+    cusp::transpose(exec, G, G_t);
+
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> next(exec, N);
+
+    thrust::fill(exec, distances.begin(), distances.end(), std::numeric_limits<ValueType>::max());
+    distances[src] = ValueType(0);
+
+    // a shortest path has at most N - 1 edges
+    for(size_t i = 0; i < N; i++)
+    {
+        // next <- min(distances, G^T (min,+) distances)
+        cusp::generalized_spmv(exec, G_t, distances, distances, next,
+                               shortest_path_combine_functor<ValueType>(), thrust::minimum<ValueType>());
+
+        if(thrust::equal(exec, next.begin(), next.end(), distances.begin()))
+            break;
+
+        cusp::blas::copy(exec, next, distances);
+    }
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+void single_source_shortest_path(thrust::execution_policy<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances,
+                                 cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    cusp::graph::single_source_shortest_path(exec, G_csr, src, distances);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+void single_source_shortest_path(thrust::execution_policy<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                       ArrayType& distances)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    single_source_shortest_path(thrust::detail::derived_cast(exec), G, src, distances, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
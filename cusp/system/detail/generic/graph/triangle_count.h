@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/coo_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/functional.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// entries strictly below the diagonal
+struct strictly_lower_functor
+{
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<1>(t) < thrust::get<0>(t);
+    }
+};
+
+template<typename DerivedPolicy,
+         typename MatrixType>
+size_t triangle_count(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      cusp::coo_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    typedef cusp::coo_matrix<IndexType,IndexType,MemorySpace> PatternMatrix;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    size_t num_lower =
+        thrust::count_if(exec,
+                         thrust::make_zip_iterator(thrust::make_tuple(G.row_indices.begin(), G.column_indices.begin())),
+                         thrust::make_zip_iterator(thrust::make_tuple(G.row_indices.end(), G.column_indices.end())),
+                         strictly_lower_functor());
+
+    if(num_lower == 0)
+        return 0;
+
+    PatternMatrix L(G.num_rows, G.num_cols, num_lower);
+
+    thrust::copy_if(exec,
+                    thrust::make_zip_iterator(thrust::make_tuple(G.row_indices.begin(), G.column_indices.begin())),
+                    thrust::make_zip_iterator(thrust::make_tuple(G.row_indices.end(), G.column_indices.end())),
+                    thrust::make_zip_iterator(thrust::make_tuple(L.row_indices.begin(), L.column_indices.begin())),
+                    strictly_lower_functor());
+    thrust::fill(exec, L.values.begin(), L.values.end(), IndexType(1));
+
+    PatternMatrix L_t;
+    cusp::transpose(exec, L, L_t);
+
+    // C <- L .* (L * L^T), only evaluated on the pattern of L
+    PatternMatrix C(L);
+    cusp::generalized_spgemm(exec, L, L_t, C,
+                             cusp::constant_functor<IndexType>(0),
+                             thrust::multiplies<IndexType>(),
+                             thrust::plus<IndexType>());
+
+    return thrust::reduce(exec, C.values.begin(), C.values.end(), size_t(0));
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType>
+size_t triangle_count(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      cusp::csr_format)
+{
+    typename MatrixType::const_coo_view_type G_coo(G);
+
+    return triangle_count(exec, G_coo, cusp::coo_format());
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType>
+size_t triangle_count(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    return cusp::graph::triangle_count(exec, G_csr);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType>
+size_t triangle_count(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return triangle_count(thrust::detail::derived_cast(exec), G, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
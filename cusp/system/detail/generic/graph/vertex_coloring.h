@@ -37,13 +37,14 @@ template<typename DerivedPolicy,
 size_t vertex_coloring(thrust::execution_policy<DerivedPolicy>& exec,
                        const MatrixType& G,
                              ArrayType& colors,
+                       const bool balance,
                        cusp::known_format)
 {
     typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
 
     CsrMatrix G_csr(G);
 
-    return cusp::graph::vertex_coloring(exec, G_csr, colors);
+    return cusp::graph::vertex_coloring(exec, G_csr, colors, balance);
 }
 
 template<typename DerivedPolicy,
@@ -51,13 +52,24 @@ template<typename DerivedPolicy,
          typename ArrayType>
 size_t vertex_coloring(thrust::execution_policy<DerivedPolicy>& exec,
                        const MatrixType& G,
-                             ArrayType& colors)
+                             ArrayType& colors,
+                       const bool balance)
 {
     typedef typename MatrixType::format Format;
 
     Format format;
 
-    return vertex_coloring(thrust::detail::derived_cast(exec), G, colors, format);
+    return vertex_coloring(thrust::detail::derived_cast(exec), G, colors, balance, format);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+size_t vertex_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             ArrayType& colors)
+{
+    return vertex_coloring(exec, G, colors, false);
 }
 
 } // end namespace generic
@@ -157,6 +157,120 @@ void generalized_spgemm(thrust::execution_policy<DerivedPolicy> &exec,
     generalized_spgemm(exec, A, B, C, initialize, combine, reduce, format1, format2, format3);
 }
 
+template <typename DerivedPolicy,
+         typename MatrixType1,
+         typename MatrixType2,
+         typename MatrixType3>
+void spgemm_symbolic(thrust::execution_policy<DerivedPolicy> &exec,
+                     const MatrixType1& A,
+                     const MatrixType2& B,
+                     MatrixType3& C)
+{
+    typedef typename MatrixType1::format Format1;
+    typedef typename MatrixType2::format Format2;
+    typedef typename MatrixType3::format Format3;
+
+    Format1 format1;
+    Format2 format2;
+    Format3 format3;
+
+    spgemm_symbolic(thrust::detail::derived_cast(exec), A, B, C, format1, format2, format3);
+}
+
+template <typename DerivedPolicy,
+         typename MatrixType1,
+         typename MatrixType2,
+         typename MatrixType3>
+void spgemm_numeric(thrust::execution_policy<DerivedPolicy> &exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C)
+{
+    typedef typename MatrixType3::value_type ValueType;
+
+    cusp::constant_functor<ValueType> initialize(0);
+    thrust::multiplies<ValueType> combine;
+    thrust::plus<ValueType> reduce;
+
+    cusp::spgemm_numeric(exec, A, B, C, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+         typename MatrixType1,
+         typename MatrixType2,
+         typename MatrixType3,
+         typename UnaryFunction,
+         typename BinaryFunction1,
+         typename BinaryFunction2>
+void spgemm_numeric(thrust::execution_policy<DerivedPolicy> &exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C,
+                    UnaryFunction   initialize,
+                    BinaryFunction1 combine,
+                    BinaryFunction2 reduce)
+{
+    typedef typename MatrixType1::format Format1;
+    typedef typename MatrixType2::format Format2;
+    typedef typename MatrixType3::format Format3;
+
+    Format1 format1;
+    Format2 format2;
+    Format3 format3;
+
+    spgemm_numeric(thrust::detail::derived_cast(exec), A, B, C, initialize, combine, reduce, format1, format2, format3);
+}
+
+template <typename DerivedPolicy,
+         typename MatrixType1,
+         typename MatrixType2,
+         typename MatrixType3,
+         typename MatrixType4>
+void masked_spgemm(thrust::execution_policy<DerivedPolicy> &exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C)
+{
+    typedef typename MatrixType4::value_type ValueType;
+
+    cusp::constant_functor<ValueType> initialize(0);
+    thrust::multiplies<ValueType> combine;
+    thrust::plus<ValueType> reduce;
+
+    cusp::masked_spgemm(exec, A, B, M, C, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+         typename MatrixType1,
+         typename MatrixType2,
+         typename MatrixType3,
+         typename MatrixType4,
+         typename UnaryFunction,
+         typename BinaryFunction1,
+         typename BinaryFunction2>
+void masked_spgemm(thrust::execution_policy<DerivedPolicy> &exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    typedef typename MatrixType1::format Format1;
+    typedef typename MatrixType2::format Format2;
+    typedef typename MatrixType3::format Format3;
+    typedef typename MatrixType4::format Format4;
+
+    Format1 format1;
+    Format2 format2;
+    Format3 format3;
+    Format4 format4;
+
+    masked_spgemm(thrust::detail::derived_cast(exec), A, B, M, C, initialize, combine, reduce, format1, format2, format3, format4);
+}
+
 template <typename DerivedPolicy,
          typename LinearOperator,
          typename Vector1,
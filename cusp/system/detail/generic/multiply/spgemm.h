@@ -19,13 +19,16 @@
 #include <cusp/array1d.h>
 #include <cusp/coo_matrix.h>
 #include <cusp/format_utils.h>
+#include <cusp/functional.h>
 #include <cusp/sort.h>
 
+#include <thrust/functional.h>
 #include <thrust/gather.h>
 #include <thrust/scan.h>
 #include <thrust/scatter.h>
 #include <thrust/transform.h>
 #include <thrust/reduce.h>
+#include <thrust/remove.h>
 #include <thrust/inner_product.h>
 #include <thrust/iterator/zip_iterator.h>
 #include <thrust/iterator/permutation_iterator.h>
@@ -404,6 +407,122 @@ void multiply(thrust::execution_policy<DerivedPolicy>& exec,
     cusp::convert(exec, C_, C);
 }
 
+// combines any two entries into a nonzero, so the product of two patterns
+// keeps every structural entry
+template <typename ValueType>
+struct spgemm_pattern_functor
+{
+    template <typename T1, typename T2>
+    __host__ __device__
+    ValueType operator()(const T1&, const T2&) const
+    {
+        return ValueType(1);
+    }
+};
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_symbolic(thrust::execution_policy<DerivedPolicy>& exec,
+                     const MatrixType1& A,
+                     const MatrixType2& B,
+                     MatrixType3& C,
+                     cusp::sparse_format,
+                     cusp::sparse_format,
+                     cusp::sparse_format)
+{
+    typedef typename MatrixType3::value_type ValueType;
+
+    cusp::constant_functor<ValueType> initialize(0);
+    spgemm_pattern_functor<ValueType> combine;
+    thrust::plus<ValueType>           reduce;
+
+    cusp::multiply(exec, A, B, C, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spgemm_numeric(thrust::execution_policy<DerivedPolicy>& exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C,
+                    UnaryFunction   initialize,
+                    BinaryFunction1 combine,
+                    BinaryFunction2 reduce,
+                    cusp::sparse_format,
+                    cusp::sparse_format,
+                    cusp::sparse_format)
+{
+    // the entries of C are exactly the entries of the product
+    cusp::generalized_spgemm(exec, A, B, C, initialize, combine, reduce);
+}
+
+// Evaluates the product on every entry of M with the inner products of
+// generalized_spgemm, counting the products landing on each entry in a
+// second pass so that entries of M without products can be dropped.
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void masked_spgemm(thrust::execution_policy<DerivedPolicy>& exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce,
+                   cusp::sparse_format,
+                   cusp::sparse_format,
+                   cusp::sparse_format,
+                   cusp::sparse_format)
+{
+    typedef typename MatrixType1::const_coo_view_type             CooMatrix1;
+    typedef typename MatrixType2::const_coo_view_type             CooMatrix2;
+    typedef typename cusp::detail::as_coo_type<MatrixType4>::type CooMatrix4;
+    typedef typename MatrixType4::value_type                      ValueType;
+
+    CooMatrix1 A_(A);
+    CooMatrix2 B_(B);
+    CooMatrix4 C_;
+
+    cusp::convert(exec, M, C_);
+
+    CooMatrix4 hits(C_);
+
+    cusp::generalized_spgemm(exec, A_, B_, hits,
+                             cusp::constant_functor<ValueType>(0),
+                             spgemm_pattern_functor<ValueType>(),
+                             thrust::plus<ValueType>());
+
+    cusp::generalized_spgemm(exec, A_, B_, C_, initialize, combine, reduce);
+
+    size_t num_entries =
+        thrust::remove_if(exec,
+            thrust::make_zip_iterator(
+              thrust::make_tuple(C_.row_indices.begin(), C_.column_indices.begin(), C_.values.begin())),
+            thrust::make_zip_iterator(
+              thrust::make_tuple(C_.row_indices.end(),   C_.column_indices.end(),   C_.values.end())),
+            hits.values.begin(),
+            thrust::placeholders::_1 == ValueType(0)) -
+        thrust::make_zip_iterator(
+            thrust::make_tuple(C_.row_indices.begin(), C_.column_indices.begin(), C_.values.begin()));
+
+    C_.resize(C_.num_rows, C_.num_cols, num_entries);
+
+    cusp::convert(exec, C_, C);
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
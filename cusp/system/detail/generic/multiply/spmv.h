@@ -22,6 +22,7 @@
 #include <cusp/detail/temporary_array.h>
 #include <cusp/detail/utils.h>
 
+#include <cusp/convert.h>
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/functional.h>
@@ -285,6 +286,98 @@ void multiply(thrust::execution_policy<DerivedPolicy> &exec,
     cusp::multiply(exec, A.coo, B, C, thrust::identity<ValueType>(), combine, reduce);
 }
 
+template <typename DerivedPolicy,
+          typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+          typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction  initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename LinearOperator::container ContainerType;
+
+    // systems without a native BSR kernel expand the blocks to CSR
+    typename cusp::detail::as_csr_type<ContainerType>::type A_csr;
+    cusp::convert(exec, A, A_csr);
+
+    cusp::multiply(exec, A_csr, B, C, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+          typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction  initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    typedef typename LinearOperator::container ContainerType;
+
+    // systems without a native BSR kernel expand the blocks to CSR
+    typename cusp::detail::as_csr_type<ContainerType>::type A_csr;
+    cusp::convert(exec, A, A_csr);
+
+    cusp::multiply(exec, A_csr, B, C, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+          typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction  initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::sell_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename LinearOperator::container ContainerType;
+
+    // systems without a native SELL kernel fall back to CSR
+    typename cusp::detail::as_csr_type<ContainerType>::type A_csr;
+    cusp::convert(exec, A, A_csr);
+
+    cusp::multiply(exec, A_csr, B, C, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+          typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator&  A,
+              MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction  initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::sell_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    typedef typename LinearOperator::container ContainerType;
+
+    // systems without a native SELL kernel fall back to CSR
+    typename cusp::detail::as_csr_type<ContainerType>::type A_csr;
+    cusp::convert(exec, A, A_csr);
+
+    cusp::multiply(exec, A_csr, B, C, initialize, combine, reduce);
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
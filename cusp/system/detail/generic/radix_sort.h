@@ -0,0 +1,333 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file radix_sort.h
+ *  \brief LSD radix sort drivers shared by the parallel host systems.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/exception.h>
+
+#include <thrust/copy.h>
+#include <thrust/extrema.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// The drivers below plan the passes of a stable LSD radix sort and move
+// the keys and payloads between the input arrays and temporaries. The
+// parallel work of a pass is delegated to a RadixPass object provided by
+// the calling system, which implements
+//
+//   radix.ranks(keys, min, shift, digit_bits, ranks)
+//     ranks[n] is the position of keys[n] in a stable sort by the digit
+//     ((keys[n] - min) >> shift) & (2^digit_bits - 1)
+//
+//   radix.scatter(input, ranks, output)
+//     output[ranks[n]] = input[n]
+
+// widest digit sorted by a single radix pass
+const size_t radix_sort_max_digit_bits = 8;
+
+// number of bits needed to represent every key in [0, max]
+template <typename IndexType>
+size_t radix_sort_bits(const IndexType max)
+{
+    size_t bits = 0;
+
+    while(bits < 8 * sizeof(size_t) && (size_t(max) >> bits) != 0)
+        bits++;
+
+    return bits;
+}
+
+// The key bits are split into the fewest passes of at most
+// radix_sort_max_digit_bits and the digits are made as narrow as possible,
+// so small key ranges need a single pass with a small histogram and an
+// empty range needs none.
+inline size_t radix_sort_num_passes(const size_t bits)
+{
+    return (bits + radix_sort_max_digit_bits - 1) / radix_sort_max_digit_bits;
+}
+
+inline size_t radix_sort_digit_bits(const size_t bits)
+{
+    const size_t num_passes = radix_sort_num_passes(bits);
+
+    return num_passes == 0 ? 0 : (bits + num_passes - 1) / num_passes;
+}
+
+// Sorts keys in [min, max]. Keys are offset by min, so only the bits of
+// max - min are sorted.
+template <typename DerivedPolicy, typename RadixPass, typename ArrayType>
+void radix_counting_sort(thrust::execution_policy<DerivedPolicy>& exec,
+                         RadixPass& radix,
+                         ArrayType& keys,
+                         typename ArrayType::value_type min,
+                         typename ArrayType::value_type max)
+{
+    typedef typename ArrayType::value_type IndexType;
+
+    if(min < IndexType(0))
+      throw cusp::invalid_input_exception("counting_sort min element less than 0");
+
+    if(max < min)
+      throw cusp::invalid_input_exception("counting_sort min element less than max element");
+
+    const size_t bits       = radix_sort_bits(max - min);
+    const size_t num_passes = radix_sort_num_passes(bits);
+    const size_t digit_bits = radix_sort_digit_bits(bits);
+
+    if(num_passes == 0)
+      return;
+
+    cusp::detail::temporary_array<size_t,    DerivedPolicy> ranks(exec, keys.size());
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> temp_keys(exec, keys.size());
+
+    for(size_t pass = 0; pass < num_passes; pass++)
+    {
+        if(pass % 2 == 0)
+        {
+            radix.ranks(keys, min, pass * digit_bits, digit_bits, ranks);
+            radix.scatter(keys, ranks, temp_keys);
+        }
+        else
+        {
+            radix.ranks(temp_keys, min, pass * digit_bits, digit_bits, ranks);
+            radix.scatter(temp_keys, ranks, keys);
+        }
+    }
+
+    if(num_passes % 2 == 1)
+      thrust::copy(exec, temp_keys.begin(), temp_keys.end(), keys.begin());
+}
+
+// Sorts keys in [min, max] and moves vals along with them.
+template <typename DerivedPolicy, typename RadixPass, typename ArrayType1, typename ArrayType2>
+void radix_counting_sort_by_key(thrust::execution_policy<DerivedPolicy>& exec,
+                                RadixPass& radix,
+                                ArrayType1& keys, ArrayType2& vals,
+                                typename ArrayType1::value_type min,
+                                typename ArrayType1::value_type max)
+{
+    typedef typename ArrayType1::value_type IndexType1;
+    typedef typename ArrayType2::value_type IndexType2;
+
+    if(min < IndexType1(0))
+      throw cusp::invalid_input_exception("counting_sort min element less than 0");
+
+    if(max < min)
+      throw cusp::invalid_input_exception("counting_sort min element less than max element");
+
+    if(keys.size() < vals.size())
+      throw cusp::invalid_input_exception("counting_sort keys.size() less than vals.size()");
+
+    const size_t bits       = radix_sort_bits(max - min);
+    const size_t num_passes = radix_sort_num_passes(bits);
+    const size_t digit_bits = radix_sort_digit_bits(bits);
+
+    if(num_passes == 0)
+      return;
+
+    cusp::detail::temporary_array<size_t,     DerivedPolicy> ranks(exec, keys.size());
+    cusp::detail::temporary_array<IndexType1, DerivedPolicy> temp_keys(exec, keys.size());
+    cusp::detail::temporary_array<IndexType2, DerivedPolicy> temp_vals(exec, vals.size());
+
+    for(size_t pass = 0; pass < num_passes; pass++)
+    {
+        if(pass % 2 == 0)
+        {
+            radix.ranks(keys, min, pass * digit_bits, digit_bits, ranks);
+            radix.scatter(keys, ranks, temp_keys);
+            radix.scatter(vals, ranks, temp_vals);
+        }
+        else
+        {
+            radix.ranks(temp_keys, min, pass * digit_bits, digit_bits, ranks);
+            radix.scatter(temp_keys, ranks, keys);
+            radix.scatter(temp_vals, ranks, vals);
+        }
+    }
+
+    if(num_passes % 2 == 1)
+    {
+      thrust::copy(exec, temp_keys.begin(), temp_keys.end(), keys.begin());
+      thrust::copy(exec, temp_vals.begin(), temp_vals.end(), vals.begin());
+    }
+}
+
+// LSD radix sort of (row, column, value) triplets, by column and then by
+// row when by_column is set and by row only otherwise. Keys are offset by
+// the minimum of their range, so only the bits of max - min are sorted.
+// Every pass moves all three arrays, alternating between the input arrays
+// and the temporaries.
+template <typename DerivedPolicy, typename RadixPass, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void radix_sort_triplets(thrust::execution_policy<DerivedPolicy>& exec,
+                         RadixPass& radix,
+                         ArrayType1& row_indices, ArrayType2& column_indices, ArrayType3& values,
+                         const size_t min_row, const size_t row_bits,
+                         const size_t min_col, const size_t column_bits,
+                         const bool by_column)
+{
+    typedef typename ArrayType1::value_type IndexType1;
+    typedef typename ArrayType2::value_type IndexType2;
+    typedef typename ArrayType3::value_type ValueType;
+
+    const size_t N = row_indices.size();
+
+    const size_t row_passes    = radix_sort_num_passes(row_bits);
+    const size_t column_passes = by_column ? radix_sort_num_passes(column_bits) : 0;
+    const size_t num_passes    = column_passes + row_passes;
+
+    if(num_passes == 0)
+        return;
+
+    cusp::detail::temporary_array<size_t,     DerivedPolicy> ranks(exec, N);
+    cusp::detail::temporary_array<IndexType1, DerivedPolicy> temp_rows(exec, N);
+    cusp::detail::temporary_array<IndexType2, DerivedPolicy> temp_columns(exec, N);
+    cusp::detail::temporary_array<ValueType,  DerivedPolicy> temp_values(exec, N);
+
+    for(size_t pass = 0; pass < num_passes; pass++)
+    {
+        const bool   column_pass = pass < column_passes;
+        const size_t digit_bits  = column_pass ? radix_sort_digit_bits(column_bits) : radix_sort_digit_bits(row_bits);
+        const size_t shift       = (column_pass ? pass : pass - column_passes) * digit_bits;
+
+        if(pass % 2 == 0)
+        {
+            if(column_pass)
+                radix.ranks(column_indices, min_col, shift, digit_bits, ranks);
+            else
+                radix.ranks(row_indices, min_row, shift, digit_bits, ranks);
+
+            radix.scatter(row_indices,    ranks, temp_rows);
+            radix.scatter(column_indices, ranks, temp_columns);
+            radix.scatter(values,         ranks, temp_values);
+        }
+        else
+        {
+            if(column_pass)
+                radix.ranks(temp_columns, min_col, shift, digit_bits, ranks);
+            else
+                radix.ranks(temp_rows, min_row, shift, digit_bits, ranks);
+
+            radix.scatter(temp_rows,    ranks, row_indices);
+            radix.scatter(temp_columns, ranks, column_indices);
+            radix.scatter(temp_values,  ranks, values);
+        }
+    }
+
+    if(num_passes % 2 == 1)
+    {
+        thrust::copy(exec, temp_rows.begin(),    temp_rows.end(),    row_indices.begin());
+        thrust::copy(exec, temp_columns.begin(), temp_columns.end(), column_indices.begin());
+        thrust::copy(exec, temp_values.begin(),  temp_values.end(),  values.begin());
+    }
+}
+
+// Sorts the triplets by row. When max_row is 0 the row range is taken
+// from the data.
+template <typename DerivedPolicy, typename RadixPass, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void radix_sort_by_row(thrust::execution_policy<DerivedPolicy>& exec,
+                       RadixPass& radix,
+                       ArrayType1& row_indices, ArrayType2& column_indices, ArrayType3& values,
+                       typename ArrayType1::value_type min_row,
+                       typename ArrayType1::value_type max_row)
+{
+    typedef typename ArrayType1::value_type IndexType;
+
+    if(row_indices.size() == 0)
+      return;
+
+    if(max_row == 0)
+    {
+      thrust::pair<typename ArrayType1::iterator, typename ArrayType1::iterator> row_range =
+        thrust::minmax_element(exec, row_indices.begin(), row_indices.end());
+
+      min_row = *row_range.first;
+      max_row = *row_range.second;
+    }
+
+    if(min_row < IndexType(0))
+      throw cusp::invalid_input_exception("sort_by_row min element less than 0");
+
+    if(max_row < min_row)
+      throw cusp::invalid_input_exception("sort_by_row min element less than max element");
+
+    radix_sort_triplets(exec, radix, row_indices, column_indices, values,
+                        min_row, radix_sort_bits(max_row - min_row), 0, 0, false);
+}
+
+// Sorts the triplets by row and then by column. When max_row or max_col
+// is 0 the corresponding range is taken from the data.
+template <typename DerivedPolicy, typename RadixPass, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void radix_sort_by_row_and_column(thrust::execution_policy<DerivedPolicy>& exec,
+                                  RadixPass& radix,
+                                  ArrayType1& row_indices, ArrayType2& column_indices, ArrayType3& values,
+                                  typename ArrayType1::value_type min_row,
+                                  typename ArrayType1::value_type max_row,
+                                  typename ArrayType2::value_type min_col,
+                                  typename ArrayType2::value_type max_col)
+{
+    typedef typename ArrayType1::value_type IndexType1;
+    typedef typename ArrayType2::value_type IndexType2;
+
+    if(row_indices.size() == 0)
+      return;
+
+    if(max_row == 0)
+    {
+      thrust::pair<typename ArrayType1::iterator, typename ArrayType1::iterator> row_range =
+        thrust::minmax_element(exec, row_indices.begin(), row_indices.end());
+
+      min_row = *row_range.first;
+      max_row = *row_range.second;
+    }
+
+    if(max_col == 0)
+    {
+      thrust::pair<typename ArrayType2::iterator, typename ArrayType2::iterator> col_range =
+        thrust::minmax_element(exec, column_indices.begin(), column_indices.end());
+
+      min_col = *col_range.first;
+      max_col = *col_range.second;
+    }
+
+    if(min_row < IndexType1(0) || min_col < IndexType2(0))
+      throw cusp::invalid_input_exception("sort_by_row_and_column min element less than 0");
+
+    if(max_row < min_row || max_col < min_col)
+      throw cusp::invalid_input_exception("sort_by_row_and_column min element less than max element");
+
+    radix_sort_triplets(exec, radix, row_indices, column_indices, values,
+                        min_row, radix_sort_bits(max_row - min_row),
+                        min_col, radix_sort_bits(max_col - min_col), true);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
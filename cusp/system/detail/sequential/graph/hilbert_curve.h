@@ -25,7 +25,7 @@
 #include <cusp/system/detail/sequential/execution_policy.h>
 
 #include <thrust/extrema.h>
-#include <thrust/gather.h>
+#include <thrust/scatter.h>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/transform.h>
@@ -135,15 +135,13 @@ static const unsigned int *s3d[] =
     istate3d +160, istate3d +168, istate3d +176, istate3d +184
 };
 
+// key() returns the full 56 (2D) or 57 (3D) bit Hilbert key as an integer,
+// the functors convert it to a double in [0,1)
 struct hilbert_transform_2d : public thrust::unary_function<double,double>
 {
-    template<typename Tuple>
     __host__
-    double operator()(const Tuple& t) const
+    static unsigned long long key(const double x, const double y)
     {
-        const double x = thrust::get<0>(t);
-        const double y = thrust::get<1>(t);
-
         int level;
         unsigned int key[2], c[2], temp, state;
 
@@ -165,28 +163,32 @@ struct hilbert_transform_2d : public thrust::unary_function<double,double>
             state = *(s2d[state] + temp);
         }
 
+        return ((unsigned long long) key[0] << 32) | key[1];
+    }
+
+    template<typename Tuple>
+    __host__
+    double operator()(const Tuple& t) const
+    {
+        const unsigned long long k = key(thrust::get<0>(t), thrust::get<1>(t));
+
         // convert 2 part Hilbert key to double and return
-        return ldexp ((double) key[0], -24)  +  ldexp ((double) key[1], -56);
+        return ldexp ((double) (unsigned int) (k >> 32), -24)  +  ldexp ((double) (unsigned int) k, -56);
     }
 };
 
 struct hilbert_transform_3d : public thrust::unary_function<double,double>
 {
-    template<typename Tuple>
     __host__
-    double operator()(const Tuple& t) const
+    static unsigned long long key(const double x, const double y, const double z)
     {
-        const double x = thrust::get<0>(t);
-        const double y = thrust::get<1>(t);
-        const double z = thrust::get<2>(t);
-
         int level;
         unsigned int key[2], c[3], temp, state;
 
         // convert x,y,z coordinates to integers in range [0, IMAX]
         c[0] = (unsigned int) (x * (double) IMAX);         // x
         c[1] = (unsigned int) (y * (double) IMAX);         // y
-        c[2] = (unsigned int) (z * (double) IMAX);     		 // z
+        c[2] = (unsigned int) (z * (double) IMAX);         // z
 
         // use state tables to convert nested quadrant's coordinates level by level
         key[0] = key[1] = 0;
@@ -203,24 +205,31 @@ struct hilbert_transform_3d : public thrust::unary_function<double,double>
             state = *(s3d[state] + temp);
         }
 
+        return ((unsigned long long) key[0] << 32) | key[1];
+    }
+
+    template<typename Tuple>
+    __host__
+    double operator()(const Tuple& t) const
+    {
+        const unsigned long long k = key(thrust::get<0>(t), thrust::get<1>(t), thrust::get<2>(t));
+
         // convert 2 part Hilbert key to double and return
-        return ldexp ((double) key[0], -25)  +  ldexp ((double) key[1], -57);
+        return ldexp ((double) (unsigned int) (k >> 32), -25)  +  ldexp ((double) (unsigned int) k, -57);
     }
 };
 
 } // end namespace detail
 
+// perm[k] is the index of the k-th point along the Hilbert curve
 template <typename DerivedPolicy, typename Array2d, typename Array1d>
-void hilbert_curve(thrust::cpp::execution_policy<DerivedPolicy>& exec,
-                   const Array2d& coord,
-                   size_t num_parts,
-                   Array1d& parts)
+void hilbert_curve_order(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                         const Array2d& coord,
+                         Array1d& perm)
 {
-    typedef typename Array1d::value_type PartType;
     typedef typename Array2d::const_column_view::iterator Iterator;
     typedef typename Array2d::value_type ValueType;
 
-    size_t num_points = coord.num_rows;
     size_t dims = coord.num_cols;
 
     if( (dims != 2) && (dims != 3) )
@@ -261,15 +270,45 @@ void hilbert_curve(thrust::cpp::execution_policy<DerivedPolicy>& exec,
                           hilbert_keys.begin(), detail::hilbert_transform_3d());
     }
 
-    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
     thrust::sequence(exec, perm.begin(), perm.end());
     thrust::sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), perm.begin());
+}
+
+template <typename DerivedPolicy, typename Array2d, typename Array1d>
+void hilbert_curve(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   size_t num_parts,
+                   Array1d& parts)
+{
+    typedef typename Array1d::value_type PartType;
+
+    size_t num_points = coord.num_rows;
+
+    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
+    hilbert_curve_order(exec, coord, perm);
 
     cusp::detail::temporary_array<PartType, DerivedPolicy> uniform_parts(exec, num_points);
     thrust::transform(exec,
                       thrust::counting_iterator<PartType>(0), thrust::counting_iterator<PartType>(num_points),
                       thrust::constant_iterator<PartType>(num_points/num_parts), uniform_parts.begin(), thrust::divides<PartType>());
-    thrust::gather(exec, perm.begin(), perm.end(), uniform_parts.begin(), parts.begin());
+    thrust::scatter(exec, uniform_parts.begin(), uniform_parts.end(), perm.begin(), parts.begin());
+}
+
+template <typename DerivedPolicy, typename Array2d, typename PermutationType>
+void hilbert_curve_permutation(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                               const Array2d& coord,
+                               PermutationType& P)
+{
+    typedef typename PermutationType::index_type IndexType;
+
+    size_t num_points = coord.num_rows;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> perm(exec, num_points);
+    hilbert_curve_order(exec, coord, perm);
+
+    thrust::scatter(exec,
+                    thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(num_points),
+                    perm.begin(), P.permutation.begin());
 }
 
 } // end namespace sequential
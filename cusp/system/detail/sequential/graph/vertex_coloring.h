@@ -34,10 +34,60 @@ namespace detail
 namespace sequential
 {
 
+// Moves vertices out of color classes larger than N / num_colors into the
+// smallest class that is not larger and that no neighbor uses. Vertices
+// are visited in order, so the result is deterministic.
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void balance_vertex_colors(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                           const MatrixType& G,
+                           ArrayType& colors,
+                           const size_t num_colors)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t N = G.num_rows;
+
+    if(num_colors == 0)
+        return;
+
+    const size_t target = (N + num_colors - 1) / num_colors;
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> sizes(exec, num_colors, 0);
+    cusp::detail::temporary_array<size_t, DerivedPolicy> mark(exec, num_colors, N);
+
+    for(size_t vertex = 0; vertex < N; vertex++)
+        sizes[colors[vertex]]++;
+
+    for(size_t vertex = 0; vertex < N; vertex++)
+    {
+        const size_t color = colors[vertex];
+
+        if(sizes[color] <= target)
+            continue;
+
+        for(IndexType offset = G.row_offsets[vertex]; offset < G.row_offsets[vertex + 1]; offset++)
+            mark[colors[G.column_indices[offset]]] = vertex;
+
+        size_t best = color;
+
+        for(size_t c = 0; c < num_colors; c++)
+            if(mark[c] != vertex && sizes[c] < target && (best == color || sizes[c] < sizes[best]))
+                best = c;
+
+        if(best != color)
+        {
+            sizes[color]--;
+            sizes[best]++;
+            colors[vertex] = best;
+        }
+    }
+}
+
 template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
 size_t vertex_coloring(thrust::cpp::execution_policy<DerivedPolicy>& exec,
                        const MatrixType& G,
                        ArrayType& colors,
+                       const bool balance,
                        cusp::csr_format)
 {
     typedef typename MatrixType::index_type IndexType;
@@ -73,6 +123,9 @@ size_t vertex_coloring(thrust::cpp::execution_policy<DerivedPolicy>& exec,
         colors[vertex] = vertex_color;
     }
 
+    if(balance)
+        balance_vertex_colors(exec, G, colors, max_color);
+
     return max_color;
 }
 
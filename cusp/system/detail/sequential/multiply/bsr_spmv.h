@@ -0,0 +1,455 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// y[i*BLOCK_SIZE:(i+1)*BLOCK_SIZE] = A[i,:] * x for a single block row,
+// holding the partial sums and the gathered x entries in registers
+template <size_t BLOCK_SIZE,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmv_block_row(const MatrixType& A,
+                        const VectorType1& x,
+                        VectorType2& y,
+                        const size_t i,
+                        UnaryFunction   initialize,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+    const size_t    base      = i * BLOCK_SIZE;
+
+    ValueType sums[BLOCK_SIZE];
+
+    for (size_t r = 0; r < BLOCK_SIZE; r++)
+        sums[r] = initialize(y[base + r]);
+
+    for (IndexType jj = row_start; jj < row_end; jj++)
+    {
+        const size_t j      = size_t(A.column_indices[jj]) * BLOCK_SIZE;
+        const size_t offset = size_t(jj) * BLOCK_SIZE * BLOCK_SIZE;
+
+        ValueType xs[BLOCK_SIZE];
+
+        for (size_t c = 0; c < BLOCK_SIZE; c++)
+            xs[c] = x[j + c];
+
+        for (size_t r = 0; r < BLOCK_SIZE; r++)
+            for (size_t c = 0; c < BLOCK_SIZE; c++)
+                sums[r] = reduce(sums[r], combine(A.values[offset + r * BLOCK_SIZE + c], xs[c]));
+    }
+
+    for (size_t r = 0; r < BLOCK_SIZE; r++)
+        y[base + r] = sums[r];
+}
+
+// runtime block size variant of bsr_spmv_block_row
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmv_block_row(const MatrixType& A,
+                        const VectorType1& x,
+                        VectorType2& y,
+                        const size_t i,
+                        const size_t block_size,
+                        UnaryFunction   initialize,
+                        BinaryFunction1 combine,
+                        BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+    const size_t    base      = i * block_size;
+
+    for (size_t r = 0; r < block_size; r++)
+    {
+        ValueType accumulator = initialize(y[base + r]);
+
+        for (IndexType jj = row_start; jj < row_end; jj++)
+        {
+            const size_t j      = size_t(A.column_indices[jj]) * block_size;
+            const size_t offset = (size_t(jj) * block_size + r) * block_size;
+
+            for (size_t c = 0; c < block_size; c++)
+                accumulator = reduce(accumulator, combine(A.values[offset + c], x[j + c]));
+        }
+
+        y[base + r] = accumulator;
+    }
+}
+
+template <size_t BLOCK_SIZE,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmv(const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce)
+{
+    const size_t num_block_rows = A.row_offsets.size() - 1;
+
+    for (size_t i = 0; i < num_block_rows; i++)
+        bsr_spmv_block_row<BLOCK_SIZE>(A, x, y, i, initialize, combine, reduce);
+}
+
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmv(const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce)
+{
+    const size_t num_block_rows = A.row_offsets.size() - 1;
+
+    switch (A.block_size)
+    {
+      case 1:  bsr_spmv<1>(A, x, y, initialize, combine, reduce); break;
+      case 2:  bsr_spmv<2>(A, x, y, initialize, combine, reduce); break;
+      case 3:  bsr_spmv<3>(A, x, y, initialize, combine, reduce); break;
+      case 4:  bsr_spmv<4>(A, x, y, initialize, combine, reduce); break;
+      case 5:  bsr_spmv<5>(A, x, y, initialize, combine, reduce); break;
+      case 6:  bsr_spmv<6>(A, x, y, initialize, combine, reduce); break;
+      case 8:  bsr_spmv<8>(A, x, y, initialize, combine, reduce); break;
+      default:
+        for (size_t i = 0; i < num_block_rows; i++)
+            bsr_spmv_block_row(A, x, y, i, A.block_size, initialize, combine, reduce);
+    }
+}
+
+// Computes columns [col, col + WIDTH) of block row i of y. Each block of
+// A is loaded once and applied to a BLOCK_SIZE x WIDTH tile of x, with the
+// BLOCK_SIZE x WIDTH partial sums held in registers.
+template <size_t BLOCK_SIZE,
+          size_t WIDTH,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmm_tile(const MatrixType& A,
+                   const VectorType1& x,
+                   VectorType2& y,
+                   const size_t i,
+                   const size_t col,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type                     IndexType;
+    typedef typename VectorType2::values_array_type::value_type ValueType;
+
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+    const size_t    base      = i * BLOCK_SIZE;
+
+    ValueType sums[BLOCK_SIZE][WIDTH];
+
+    for (size_t r = 0; r < BLOCK_SIZE; r++)
+        for (size_t k = 0; k < WIDTH; k++)
+            sums[r][k] = initialize(y(base + r, col + k));
+
+    for (IndexType jj = row_start; jj < row_end; jj++)
+    {
+        const size_t j      = size_t(A.column_indices[jj]) * BLOCK_SIZE;
+        const size_t offset = size_t(jj) * BLOCK_SIZE * BLOCK_SIZE;
+
+        ValueType xs[BLOCK_SIZE][WIDTH];
+
+        for (size_t c = 0; c < BLOCK_SIZE; c++)
+            for (size_t k = 0; k < WIDTH; k++)
+                xs[c][k] = x(j + c, col + k);
+
+        for (size_t r = 0; r < BLOCK_SIZE; r++)
+        {
+            for (size_t c = 0; c < BLOCK_SIZE; c++)
+            {
+                const ValueType Aij = A.values[offset + r * BLOCK_SIZE + c];
+
+                for (size_t k = 0; k < WIDTH; k++)
+                    sums[r][k] = reduce(sums[r][k], combine(Aij, xs[c][k]));
+            }
+        }
+    }
+
+    for (size_t r = 0; r < BLOCK_SIZE; r++)
+        for (size_t k = 0; k < WIDTH; k++)
+            y(base + r, col + k) = sums[r][k];
+}
+
+// runtime block size variant of bsr_spmm_tile
+template <size_t WIDTH,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmm_tile(const MatrixType& A,
+                   const VectorType1& x,
+                   VectorType2& y,
+                   const size_t i,
+                   const size_t col,
+                   const size_t block_size,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type                     IndexType;
+    typedef typename VectorType2::values_array_type::value_type ValueType;
+
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+    const size_t    base      = i * block_size;
+
+    for (size_t r = 0; r < block_size; r++)
+    {
+        ValueType sums[WIDTH];
+
+        for (size_t k = 0; k < WIDTH; k++)
+            sums[k] = initialize(y(base + r, col + k));
+
+        for (IndexType jj = row_start; jj < row_end; jj++)
+        {
+            const size_t j      = size_t(A.column_indices[jj]) * block_size;
+            const size_t offset = (size_t(jj) * block_size + r) * block_size;
+
+            for (size_t c = 0; c < block_size; c++)
+            {
+                const ValueType Aij = A.values[offset + c];
+
+                for (size_t k = 0; k < WIDTH; k++)
+                    sums[k] = reduce(sums[k], combine(Aij, x(j + c, col + k)));
+            }
+        }
+
+        for (size_t k = 0; k < WIDTH; k++)
+            y(base + r, col + k) = sums[k];
+    }
+}
+
+// Computes block rows [row_start, row_end) of y. As in csr_block_spmv_rows
+// the columns are covered by tiles of width 8 followed by at most one tile
+// each of width 4, 2 and 1; the block already contributes BLOCK_SIZE rows
+// of accumulators, so the widest tile is narrower than for CSR.
+template <size_t BLOCK_SIZE,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmm_block_rows(const MatrixType& A,
+                         const VectorType1& x,
+                         VectorType2& y,
+                         const size_t row_start,
+                         const size_t row_end,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce)
+{
+    const size_t num_cols = x.num_cols;
+
+    for (size_t i = row_start; i < row_end; i++)
+    {
+        size_t col = 0;
+
+        for (; col + 8 <= num_cols; col += 8)
+            bsr_spmm_tile<BLOCK_SIZE,8>(A, x, y, i, col, initialize, combine, reduce);
+
+        if (col + 4 <= num_cols)
+        {
+            bsr_spmm_tile<BLOCK_SIZE,4>(A, x, y, i, col, initialize, combine, reduce);
+            col += 4;
+        }
+
+        if (col + 2 <= num_cols)
+        {
+            bsr_spmm_tile<BLOCK_SIZE,2>(A, x, y, i, col, initialize, combine, reduce);
+            col += 2;
+        }
+
+        if (col + 1 <= num_cols)
+            bsr_spmm_tile<BLOCK_SIZE,1>(A, x, y, i, col, initialize, combine, reduce);
+    }
+}
+
+// runtime block size variant of bsr_spmm_block_rows
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmm_block_rows(const MatrixType& A,
+                         const VectorType1& x,
+                         VectorType2& y,
+                         const size_t row_start,
+                         const size_t row_end,
+                         const size_t block_size,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce)
+{
+    const size_t num_cols = x.num_cols;
+
+    for (size_t i = row_start; i < row_end; i++)
+    {
+        size_t col = 0;
+
+        for (; col + 8 <= num_cols; col += 8)
+            bsr_spmm_tile<8>(A, x, y, i, col, block_size, initialize, combine, reduce);
+
+        if (col + 4 <= num_cols)
+        {
+            bsr_spmm_tile<4>(A, x, y, i, col, block_size, initialize, combine, reduce);
+            col += 4;
+        }
+
+        if (col + 2 <= num_cols)
+        {
+            bsr_spmm_tile<2>(A, x, y, i, col, block_size, initialize, combine, reduce);
+            col += 2;
+        }
+
+        if (col + 1 <= num_cols)
+            bsr_spmm_tile<1>(A, x, y, i, col, block_size, initialize, combine, reduce);
+    }
+}
+
+// dispatches block rows [row_start, row_end) on the block size of A
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmm(const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              const size_t row_start,
+              const size_t row_end,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce)
+{
+    switch (A.block_size)
+    {
+      case 1:  bsr_spmm_block_rows<1>(A, x, y, row_start, row_end, initialize, combine, reduce); break;
+      case 2:  bsr_spmm_block_rows<2>(A, x, y, row_start, row_end, initialize, combine, reduce); break;
+      case 3:  bsr_spmm_block_rows<3>(A, x, y, row_start, row_end, initialize, combine, reduce); break;
+      case 4:  bsr_spmm_block_rows<4>(A, x, y, row_start, row_end, initialize, combine, reduce); break;
+      case 5:  bsr_spmm_block_rows<5>(A, x, y, row_start, row_end, initialize, combine, reduce); break;
+      case 6:  bsr_spmm_block_rows<6>(A, x, y, row_start, row_end, initialize, combine, reduce); break;
+      case 8:  bsr_spmm_block_rows<8>(A, x, y, row_start, row_end, initialize, combine, reduce); break;
+      default:
+        bsr_spmm_block_rows(A, x, y, row_start, row_end, A.block_size, initialize, combine, reduce);
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    if (A.num_rows == 0)
+        return;
+
+    bsr_spmv(A, x, y, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    if (A.num_rows == 0)
+        return;
+
+    bsr_spmm(A, x, y, 0, A.row_offsets.size() - 1, initialize, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -18,7 +18,6 @@
 
 #include <cusp/detail/config.h>
 #include <cusp/detail/format.h>
-#include <cusp/detail/temporary_array.h>
 
 #include <cusp/system/detail/sequential/execution_policy.h>
 
@@ -31,6 +30,101 @@ namespace detail
 namespace sequential
 {
 
+// Computes columns [col, col + WIDTH) of row i of y. The partial sums of
+// the row are kept in a fixed-size local array so the accumulators stay in
+// registers and every nonzero of A is applied to WIDTH contiguous entries
+// of a row-major x.
+template <size_t WIDTH,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void csr_block_spmv_tile(const MatrixType& A,
+                         const VectorType1& x,
+                         VectorType2& y,
+                         const size_t i,
+                         const size_t col,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type                     IndexType;
+    typedef typename VectorType2::values_array_type::value_type ValueType;
+
+    const IndexType row_start = A.row_offsets[i];
+    const IndexType row_end   = A.row_offsets[i + 1];
+
+    ValueType accumulator[WIDTH];
+
+    for(size_t k = 0; k < WIDTH; k++)
+        accumulator[k] = initialize(y(i, col + k));
+
+    for(IndexType jj = row_start; jj < row_end; jj++)
+    {
+        const IndexType j   = A.column_indices[jj];
+        const ValueType Aij = A.values[jj];
+
+        for(size_t k = 0; k < WIDTH; k++)
+            accumulator[k] = reduce(accumulator[k], combine(Aij, x(j, col + k)));
+    }
+
+    for(size_t k = 0; k < WIDTH; k++)
+        y(i, col + k) = accumulator[k];
+}
+
+// Computes rows [row_start, row_end) of y. The columns of each row are
+// covered by tiles of width 16 followed by at most one tile each of width
+// 8, 4, 2 and 1, so every width is handled without a heap allocated
+// accumulator and the common widths map to a single tile.
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void csr_block_spmv_rows(const MatrixType& A,
+                         const VectorType1& x,
+                         VectorType2& y,
+                         const size_t row_start,
+                         const size_t row_end,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce)
+{
+    const size_t num_cols = x.num_cols;
+
+    for(size_t i = row_start; i < row_end; i++)
+    {
+        size_t col = 0;
+
+        for(; col + 16 <= num_cols; col += 16)
+            csr_block_spmv_tile<16>(A, x, y, i, col, initialize, combine, reduce);
+
+        if(col + 8 <= num_cols)
+        {
+            csr_block_spmv_tile<8>(A, x, y, i, col, initialize, combine, reduce);
+            col += 8;
+        }
+
+        if(col + 4 <= num_cols)
+        {
+            csr_block_spmv_tile<4>(A, x, y, i, col, initialize, combine, reduce);
+            col += 4;
+        }
+
+        if(col + 2 <= num_cols)
+        {
+            csr_block_spmv_tile<2>(A, x, y, i, col, initialize, combine, reduce);
+            col += 2;
+        }
+
+        if(col + 1 <= num_cols)
+            csr_block_spmv_tile<1>(A, x, y, i, col, initialize, combine, reduce);
+    }
+}
+
 template <typename DerivedPolicy,
           typename MatrixType,
           typename VectorType1,
@@ -49,34 +143,7 @@ void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
               cusp::array2d_format,
               cusp::array2d_format)
 {
-    typedef typename MatrixType::index_type	                    IndexType;
-    typedef typename VectorType2::values_array_type::value_type ValueType;
-
-    for(size_t i = 0; i < A.num_rows; i++)
-    {
-        const IndexType row_start = A.row_offsets[i];
-        const IndexType row_end   = A.row_offsets[i + 1];
-
-		    cusp::detail::temporary_array<ValueType, DerivedPolicy> accumulator(exec, x.num_cols);
-
-        for(size_t k = 0; k < x.num_cols; k++)
-            accumulator[k] = initialize(y(i,k));
-
-        for (IndexType jj = row_start; jj < row_end; jj++)
-        {
-            const IndexType j   = A.column_indices[jj];
-            const ValueType Aij = A.values[jj];
-
-            for(size_t k = 0; k < x.num_cols; k++)
-            {
-              const ValueType xj  = x(j,k);
-              accumulator[k] = reduce(accumulator[k], combine(Aij, xj));
-            }
-        }
-
-        for(size_t k = 0; k < x.num_cols; k++)
-            y(i,k) = accumulator[k];
-    }
+    csr_block_spmv_rows(A, x, y, 0, A.num_rows, initialize, combine, reduce);
 }
 
 } // end namespace sequential
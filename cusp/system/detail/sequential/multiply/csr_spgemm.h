@@ -22,6 +22,8 @@
 
 #include <cusp/system/detail/sequential/execution_policy.h>
 
+#include <thrust/sort.h>
+
 namespace cusp
 {
 namespace system
@@ -196,6 +198,200 @@ void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
     C.resize(A.num_rows, B.num_cols, num_nonzeros);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_symbolic(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                     const MatrixType1& A,
+                     const MatrixType2& B,
+                     MatrixType3& C,
+                     cusp::csr_format,
+                     cusp::csr_format,
+                     cusp::csr_format)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType2;
+
+    size_t num_nonzeros =
+        spmm_csr_pass1(exec,
+                       A.num_rows, B.num_cols,
+                       A.row_offsets, A.column_indices,
+                       B.row_offsets, B.column_indices);
+
+    C.resize(A.num_rows, B.num_cols, num_nonzeros);
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> mask(exec, B.num_cols, static_cast<size_t>(-1));
+
+    num_nonzeros = 0;
+
+    C.row_offsets[0] = 0;
+
+    // record the column of every structural entry of C, sorted within rows
+    for(size_t i = 0; i < A.num_rows; i++)
+    {
+        for(IndexType1 jj = A.row_offsets[i]; jj < A.row_offsets[i+1]; jj++)
+        {
+            IndexType1 j = A.column_indices[jj];
+
+            for(IndexType2 kk = B.row_offsets[j]; kk < B.row_offsets[j+1]; kk++)
+            {
+                IndexType2 k = B.column_indices[kk];
+
+                if(mask[k] != i)
+                {
+                    mask[k] = i;
+                    C.column_indices[num_nonzeros++] = k;
+                }
+            }
+        }
+
+        thrust::sort(exec, C.column_indices.begin() + C.row_offsets[i], C.column_indices.begin() + num_nonzeros);
+
+        C.row_offsets[i+1] = num_nonzeros;
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spgemm_numeric(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C,
+                    UnaryFunction   initialize,
+                    BinaryFunction1 combine,
+                    BinaryFunction2 reduce,
+                    cusp::csr_format,
+                    cusp::csr_format,
+                    cusp::csr_format)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType2;
+    typedef typename MatrixType3::index_type IndexType;
+
+    // position of each column within the current row of C
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> position(exec, C.num_cols);
+
+    for(size_t i = 0; i < A.num_rows; i++)
+    {
+        for(IndexType n = C.row_offsets[i]; n < C.row_offsets[i+1]; n++)
+        {
+            position[C.column_indices[n]] = n;
+            C.values[n] = initialize(C.values[n]);
+        }
+
+        for(IndexType1 jj = A.row_offsets[i]; jj < A.row_offsets[i+1]; jj++)
+        {
+            IndexType1 j = A.column_indices[jj];
+
+            for(IndexType2 kk = B.row_offsets[j]; kk < B.row_offsets[j+1]; kk++)
+            {
+                IndexType n = position[B.column_indices[kk]];
+
+                C.values[n] = reduce(C.values[n], combine(A.values[jj], B.values[kk]));
+            }
+        }
+    }
+}
+
+// Row-wise product that only accumulates into the columns of the current
+// row of M. Those columns are marked in a dense position array, products
+// landing on unmarked columns are skipped and entries of M without any
+// product are dropped while the row is compacted into C.
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void masked_spgemm(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce,
+                   cusp::csr_format,
+                   cusp::csr_format,
+                   cusp::csr_format,
+                   cusp::csr_format)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType2;
+    typedef typename MatrixType3::index_type IndexType3;
+
+    const IndexType3 unmarked = static_cast<IndexType3>(-1);
+
+    C.resize(M.num_rows, M.num_cols, M.num_entries);
+
+    cusp::detail::temporary_array<IndexType3, DerivedPolicy> position(exec, M.num_cols, unmarked);
+    cusp::detail::temporary_array<char, DerivedPolicy>       hit(exec, M.num_entries, 0);
+
+    size_t num_entries = 0;
+
+    C.row_offsets[0] = 0;
+
+    for(size_t i = 0; i < M.num_rows; i++)
+    {
+        const IndexType3 row_start = M.row_offsets[i];
+        const IndexType3 row_end   = M.row_offsets[i+1];
+
+        if(row_start == row_end)
+        {
+            C.row_offsets[i+1] = num_entries;
+            continue;
+        }
+
+        // entries of the current row are accumulated in place, compacted
+        // entries of the previous rows lie before row_start
+        for(IndexType3 n = row_start; n < row_end; n++)
+        {
+            position[M.column_indices[n]] = n;
+            C.values[n] = initialize(M.values[n]);
+        }
+
+        for(IndexType1 jj = A.row_offsets[i]; jj < A.row_offsets[i+1]; jj++)
+        {
+            IndexType1 j = A.column_indices[jj];
+
+            for(IndexType2 kk = B.row_offsets[j]; kk < B.row_offsets[j+1]; kk++)
+            {
+                IndexType3 n = position[B.column_indices[kk]];
+
+                if(n == unmarked)
+                    continue;
+
+                C.values[n] = reduce(C.values[n], combine(A.values[jj], B.values[kk]));
+                hit[n] = 1;
+            }
+        }
+
+        for(IndexType3 n = row_start; n < row_end; n++)
+        {
+            position[M.column_indices[n]] = unmarked;
+
+            if(hit[n])
+            {
+                C.column_indices[num_entries] = M.column_indices[n];
+                C.values[num_entries]         = C.values[n];
+                num_entries++;
+            }
+        }
+
+        C.row_offsets[i+1] = num_entries;
+    }
+
+    C.resize(M.num_rows, M.num_cols, num_entries);
+}
+
 } // end namespace sequential
 } // end namespace detail
 } // end namespace system
@@ -0,0 +1,252 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+// y[perm[c*CHUNK_SIZE:(c+1)*CHUNK_SIZE]] = A[chunk c,:] * x, holding one partial
+// sum per row of the chunk in registers. Padding is skipped with a select rather
+// than a branch so the loop over the rows of the chunk has no control flow.
+template <size_t CHUNK_SIZE,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void sell_spmv_chunk(const MatrixType& A,
+                     const VectorType1& x,
+                     VectorType2& y,
+                     const size_t c,
+                     UnaryFunction   initialize,
+                     BinaryFunction1 combine,
+                     BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType invalid_index = MatrixType::invalid_index;
+
+    const size_t chunk_start = A.chunk_offsets[c];
+    const size_t chunk_end   = A.chunk_offsets[c + 1];
+    const size_t width       = (chunk_end - chunk_start) / CHUNK_SIZE;
+    const size_t base        = c * CHUNK_SIZE;
+    const size_t num_rows    = std::min(CHUNK_SIZE, size_t(A.num_rows) - base);
+
+    ValueType sums[CHUNK_SIZE];
+
+    for (size_t r = 0; r < CHUNK_SIZE; r++)
+        sums[r] = r < num_rows ? initialize(y[A.row_permutation[base + r]]) : ValueType(0);
+
+    for (size_t j = 0; j < width; j++)
+    {
+        const size_t offset = chunk_start + j * CHUNK_SIZE;
+
+        for (size_t r = 0; r < CHUNK_SIZE; r++)
+        {
+            const IndexType col   = A.column_indices[offset + r];
+            const bool      valid = col != invalid_index;
+            const ValueType xj    = x[valid ? col : 0];
+
+            sums[r] = valid ? reduce(sums[r], combine(A.values[offset + r], xj)) : sums[r];
+        }
+    }
+
+    for (size_t r = 0; r < num_rows; r++)
+        y[A.row_permutation[base + r]] = sums[r];
+}
+
+// runtime chunk size variant of sell_spmv_chunk
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void sell_spmv_chunk(const MatrixType& A,
+                     const VectorType1& x,
+                     VectorType2& y,
+                     const size_t c,
+                     const size_t chunk_size,
+                     UnaryFunction   initialize,
+                     BinaryFunction1 combine,
+                     BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const IndexType invalid_index = MatrixType::invalid_index;
+
+    const size_t chunk_start = A.chunk_offsets[c];
+    const size_t chunk_end   = A.chunk_offsets[c + 1];
+    const size_t width       = (chunk_end - chunk_start) / chunk_size;
+    const size_t base        = c * chunk_size;
+    const size_t num_rows    = std::min(chunk_size, size_t(A.num_rows) - base);
+
+    for (size_t r = 0; r < num_rows; r++)
+    {
+        const IndexType row = A.row_permutation[base + r];
+
+        ValueType accumulator = initialize(y[row]);
+
+        for (size_t j = 0; j < width; j++)
+        {
+            const size_t    offset = chunk_start + j * chunk_size + r;
+            const IndexType col    = A.column_indices[offset];
+
+            if (col != invalid_index)
+                accumulator = reduce(accumulator, combine(A.values[offset], x[col]));
+        }
+
+        y[row] = accumulator;
+    }
+}
+
+template <size_t CHUNK_SIZE,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void sell_spmv(const MatrixType& A,
+               const VectorType1& x,
+               VectorType2& y,
+               UnaryFunction   initialize,
+               BinaryFunction1 combine,
+               BinaryFunction2 reduce)
+{
+    const size_t num_chunks = A.chunk_offsets.size() - 1;
+
+    for (size_t c = 0; c < num_chunks; c++)
+        sell_spmv_chunk<CHUNK_SIZE>(A, x, y, c, initialize, combine, reduce);
+}
+
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void sell_spmv(const MatrixType& A,
+               const VectorType1& x,
+               VectorType2& y,
+               UnaryFunction   initialize,
+               BinaryFunction1 combine,
+               BinaryFunction2 reduce)
+{
+    const size_t num_chunks = A.chunk_offsets.size() - 1;
+
+    switch (A.chunk_size)
+    {
+      case 1:  sell_spmv<1>(A, x, y, initialize, combine, reduce); break;
+      case 2:  sell_spmv<2>(A, x, y, initialize, combine, reduce); break;
+      case 4:  sell_spmv<4>(A, x, y, initialize, combine, reduce); break;
+      case 8:  sell_spmv<8>(A, x, y, initialize, combine, reduce); break;
+      case 16: sell_spmv<16>(A, x, y, initialize, combine, reduce); break;
+      case 32: sell_spmv<32>(A, x, y, initialize, combine, reduce); break;
+      default:
+        for (size_t c = 0; c < num_chunks; c++)
+            sell_spmv_chunk(A, x, y, c, A.chunk_size, initialize, combine, reduce);
+    }
+}
+
+// column views are passed by value so temporaries can be written through
+template <typename MatrixType,
+          typename ColumnView1,
+          typename ColumnView2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void sell_spmv_column(const MatrixType& A,
+                      const ColumnView1& x,
+                      ColumnView2 y,
+                      UnaryFunction   initialize,
+                      BinaryFunction1 combine,
+                      BinaryFunction2 reduce)
+{
+    sell_spmv(A, x, y, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::sell_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    if (A.num_rows == 0)
+        return;
+
+    sell_spmv(A, x, y, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::sell_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    if (A.num_rows == 0)
+        return;
+
+    for (size_t k = 0; k < x.num_cols; k++)
+        sell_spmv_column(A, x.column(k), y.column(k), initialize, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
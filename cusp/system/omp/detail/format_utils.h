@@ -18,6 +18,14 @@
 
 #include <cusp/detail/config.h>
 
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+
+#include <algorithm>
+
+#include <omp.h>
+
 // this system inherits format_utils
 #include <cusp/system/cpp/detail/format_utils.h>
 
@@ -33,6 +41,54 @@ namespace detail
 using cusp::system::detail::sequential::offsets_to_indices;
 using cusp::system::detail::sequential::indices_to_offsets;
 
+// Replaces the counts stored in offsets[1:n+1] with their inclusive scan
+// and sets offsets[0] to zero. Each thread scans a contiguous block, the
+// block totals are scanned once and then added back to every block.
+template <typename DerivedPolicy, typename Array>
+void counts_to_offsets(omp::execution_policy<DerivedPolicy>& exec,
+                       const size_t n, Array& offsets)
+{
+    typedef typename Array::value_type IndexType;
+
+    const int max_threads = std::max(1, omp_get_max_threads());
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> block_sums(exec, max_threads + 1, 0);
+
+    offsets[0] = 0;
+
+    #pragma omp parallel num_threads(max_threads)
+    {
+        const size_t t           = omp_get_thread_num();
+        const size_t num_threads = omp_get_num_threads();
+        const size_t block_size  = (n + num_threads - 1) / num_threads;
+        const size_t start       = std::min(n, t * block_size) + 1;
+        const size_t end         = std::min(n, (t + 1) * block_size) + 1;
+
+        size_t sum = 0;
+
+        for(size_t i = start; i < end; i++)
+        {
+            sum += offsets[i];
+            offsets[i] = sum;
+        }
+
+        block_sums[t + 1] = sum;
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            for(size_t m = 1; m < num_threads + 1; m++)
+                block_sums[m] += block_sums[m - 1];
+        }
+
+        const IndexType base = block_sums[t];
+
+        for(size_t i = start; i < end; i++)
+            offsets[i] += base;
+    }
+}
+
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
@@ -17,7 +17,19 @@
 #pragma once
 
 #include <cusp/detail/config.h>
-#include <cusp/system/cpp/detail/graph/breadth_first_search.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <omp.h>
 
 namespace cusp
 {
@@ -28,10 +40,432 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::breadth_first_search;
+// Direction switching thresholds of the Beamer et al. heuristic. The search
+// switches to bottom-up steps once the frontier touches more than 1/alpha
+// of the unexplored edges and back to top-down steps once the frontier
+// shrinks below 1/beta of the vertices.
+const size_t bfs_alpha = 14;
+const size_t bfs_beta  = 24;
+
+const size_t bfs_word_bits = 8 * sizeof(unsigned int);
+
+// Bottom-up steps scan the rows of G as in-edges, which is only valid when
+// every edge (i,j) has a matching edge (j,i). Rows that are unsorted or
+// contain padding are conservatively reported as unsymmetric.
+template <typename MatrixType>
+bool bfs_symmetric_pattern(const MatrixType& G)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const int num_rows = G.num_rows;
+
+    size_t num_mismatches = 0;
+
+    #pragma omp parallel for reduction(+ : num_mismatches) schedule(dynamic, 256)
+    for(int i = 0; i < num_rows; i++)
+    {
+        for(VertexId jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+        {
+            const VertexId j = G.column_indices[jj];
+
+            if(j < 0 || (jj > G.row_offsets[i] && j < G.column_indices[jj - 1]))
+            {
+                num_mismatches++;
+                continue;
+            }
+
+            if(!std::binary_search(&G.column_indices[0] + G.row_offsets[j],
+                                   &G.column_indices[0] + G.row_offsets[j + 1], VertexId(i)))
+                num_mismatches++;
+        }
+    }
+
+    return num_mismatches == 0;
+}
+
+// Expands every vertex of the frontier queue, claiming unvisited neighbors
+// with an atomic update of the visited bitmap so each vertex is enqueued
+// exactly once. Threads collect their discoveries locally and append them
+// to the next queue at offsets given by a scan of the local sizes.
+template <typename MatrixType, typename ArrayType1, typename ArrayType2, typename ArrayType3, typename ArrayType4>
+size_t bfs_top_down_step(const MatrixType& G,
+                         const ArrayType1& frontier,
+                         const size_t frontier_size,
+                         ArrayType1& next,
+                         unsigned int* visited,
+                         ArrayType2& levels,
+                         ArrayType3& parents,
+                         const bool track_parents,
+                         ArrayType4& thread_offsets,
+                         const typename MatrixType::index_type depth,
+                         size_t& next_edges)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const int num_frontier = frontier_size;
+
+    size_t next_size = 0;
+    size_t edges     = 0;
+
+    #pragma omp parallel reduction(+ : edges)
+    {
+        const int thread_id   = omp_get_thread_num();
+        const int num_threads = omp_get_num_threads();
+
+        std::vector<VertexId> discovered;
+
+        #pragma omp for schedule(dynamic, 64) nowait
+        for(int n = 0; n < num_frontier; n++)
+        {
+            const VertexId u = frontier[n];
+
+            for(VertexId jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+            {
+                const VertexId v = G.column_indices[jj];
+
+                if(v < 0)
+                    continue;
+
+                const unsigned int bit = 1u << (v % bfs_word_bits);
+                unsigned int old_word;
+
+                #pragma omp atomic read
+                old_word = visited[v / bfs_word_bits];
+
+                if(old_word & bit)
+                    continue;
+
+                #pragma omp atomic capture
+                { old_word = visited[v / bfs_word_bits]; visited[v / bfs_word_bits] |= bit; }
+
+                if(old_word & bit)
+                    continue;
+
+                levels[v] = depth + 1;
+
+                if(track_parents)
+                    parents[v] = u;
+
+                edges += G.row_offsets[v + 1] - G.row_offsets[v];
+                discovered.push_back(v);
+            }
+        }
+
+        thread_offsets[thread_id + 1] = discovered.size();
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            thread_offsets[0] = 0;
+
+            for(int t = 0; t < num_threads; t++)
+                thread_offsets[t + 1] += thread_offsets[t];
+
+            next_size = thread_offsets[num_threads];
+        }
+
+        std::copy(discovered.begin(), discovered.end(), &next[0] + thread_offsets[thread_id]);
+    }
+
+    next_edges = edges;
+
+    return next_size;
+}
+
+// Every unvisited vertex searches its in-edges for a parent in the frontier
+// bitmap and stops at the first one found. Threads own whole bitmap words
+// so the next frontier and visited bitmaps are updated without atomics.
+template <typename MatrixType, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+size_t bfs_bottom_up_step(const MatrixType& G,
+                          const ArrayType1& frontier_bits,
+                          ArrayType1& next_bits,
+                          unsigned int* visited,
+                          ArrayType2& levels,
+                          ArrayType3& parents,
+                          const bool track_parents,
+                          const typename MatrixType::index_type depth,
+                          size_t& next_edges)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const size_t num_rows  = G.num_rows;
+    const int    num_words = (num_rows + bfs_word_bits - 1) / bfs_word_bits;
+
+    size_t awake = 0;
+    size_t edges = 0;
+
+    #pragma omp parallel for reduction(+ : awake, edges) schedule(dynamic, 64)
+    for(int w = 0; w < num_words; w++)
+    {
+        unsigned int next_word = 0;
+
+        const size_t v_begin = w * bfs_word_bits;
+        const size_t v_end   = std::min(v_begin + bfs_word_bits, num_rows);
+
+        for(size_t v = v_begin; v < v_end; v++)
+        {
+            const unsigned int bit = 1u << (v - v_begin);
+
+            if(visited[w] & bit)
+                continue;
+
+            for(VertexId jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+            {
+                const VertexId u = G.column_indices[jj];
+
+                if(frontier_bits[u / bfs_word_bits] & (1u << (u % bfs_word_bits)))
+                {
+                    levels[v] = depth + 1;
+
+                    if(track_parents)
+                        parents[v] = u;
+
+                    next_word |= bit;
+                    awake++;
+                    edges += G.row_offsets[v + 1] - G.row_offsets[v];
+                    break;
+                }
+            }
+        }
+
+        visited[w]  |= next_word;
+        next_bits[w] = next_word;
+    }
+
+    next_edges = edges;
+
+    return awake;
+}
+
+template <typename ArrayType1, typename ArrayType2>
+void bfs_queue_to_bitmap(const ArrayType1& queue, const size_t queue_size, ArrayType2& bits)
+{
+    const int num_words = bits.size();
+    const int num_queue = queue_size;
+
+    #pragma omp parallel for
+    for(int w = 0; w < num_words; w++)
+        bits[w] = 0;
+
+    unsigned int* raw_bits = thrust::raw_pointer_cast(&bits[0]);
+
+    #pragma omp parallel for
+    for(int n = 0; n < num_queue; n++)
+    {
+        const size_t       v   = queue[n];
+        const unsigned int bit = 1u << (v % bfs_word_bits);
+
+        #pragma omp atomic
+        raw_bits[v / bfs_word_bits] |= bit;
+    }
+}
+
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void bfs_bitmap_to_queue(const ArrayType1& bits, ArrayType2& queue, ArrayType3& thread_offsets)
+{
+    typedef typename ArrayType2::value_type VertexId;
+
+    const int num_words = bits.size();
+
+    #pragma omp parallel
+    {
+        const int thread_id   = omp_get_thread_num();
+        const int num_threads = omp_get_num_threads();
+
+        std::vector<VertexId> vertices;
+
+        #pragma omp for schedule(static) nowait
+        for(int w = 0; w < num_words; w++)
+            for(size_t b = 0; b < bfs_word_bits; b++)
+                if(bits[w] & (1u << b))
+                    vertices.push_back(w * bfs_word_bits + b);
+
+        thread_offsets[thread_id + 1] = vertices.size();
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            thread_offsets[0] = 0;
+
+            for(int t = 0; t < num_threads; t++)
+                thread_offsets[t + 1] += thread_offsets[t];
+        }
+
+        std::copy(vertices.begin(), vertices.end(), &queue[0] + thread_offsets[thread_id]);
+    }
+}
+
+// Frontier queues, bitmaps and scan offsets of a search over a graph with
+// num_rows vertices. Searches repeated on the same graph, such as the
+// sweeps of the pseudo-peripheral vertex search, share one workspace and
+// only clear the visited bitmap between searches. The symmetry check of
+// the direction switch is also done at most once.
+template <typename VertexId, typename DerivedPolicy>
+struct bfs_workspace
+{
+    cusp::detail::temporary_array<VertexId, DerivedPolicy>     frontier;
+    cusp::detail::temporary_array<VertexId, DerivedPolicy>     next;
+    cusp::detail::temporary_array<unsigned int, DerivedPolicy> visited;
+    cusp::detail::temporary_array<unsigned int, DerivedPolicy> frontier_bits;
+    cusp::detail::temporary_array<unsigned int, DerivedPolicy> next_bits;
+    cusp::detail::temporary_array<size_t, DerivedPolicy>       thread_offsets;
+
+    bool symmetry_checked;
+    bool symmetric;
+
+    bfs_workspace(omp::execution_policy<DerivedPolicy>& exec, const size_t num_rows)
+        : frontier(exec, num_rows),
+          next(exec, num_rows),
+          visited(exec, (num_rows + bfs_word_bits - 1) / bfs_word_bits),
+          frontier_bits(exec, (num_rows + bfs_word_bits - 1) / bfs_word_bits),
+          next_bits(exec, (num_rows + bfs_word_bits - 1) / bfs_word_bits),
+          thread_offsets(exec, omp_get_max_threads() + 1, size_t(0)),
+          symmetry_checked(false),
+          symmetric(false)
+    {}
+};
+
+// Level-synchronous BFS that records the depth of every vertex in levels
+// and, when track_parents is set, a parent in the previous level in
+// parents. The frontier is kept as a queue during top-down steps and as a
+// bitmap during bottom-up steps. Vertices that are not reached keep their
+// entries in levels. Returns the depth of the last level, the eccentricity
+// of src within its component.
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+typename MatrixType::index_type
+bfs_levels(omp::execution_policy<DerivedPolicy>& exec,
+           const MatrixType& G,
+           const typename MatrixType::index_type src,
+           ArrayType1& levels,
+           ArrayType2& parents,
+           const bool track_parents,
+           bfs_workspace<typename MatrixType::index_type, DerivedPolicy>& workspace)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const size_t num_rows  = G.num_rows;
+    const int    num_words = workspace.visited.size();
+
+    unsigned int* raw_visited = thrust::raw_pointer_cast(&workspace.visited[0]);
+
+    #pragma omp parallel for
+    for(int w = 0; w < num_words; w++)
+        raw_visited[w] = 0;
+
+    levels[src]            = 0;
+    workspace.frontier[0]  = src;
+    raw_visited[src / bfs_word_bits] |= 1u << (src % bfs_word_bits);
+
+    size_t frontier_size  = 1;
+    size_t frontier_edges = G.row_offsets[src + 1] - G.row_offsets[src];
+    size_t unexplored     = G.num_entries - frontier_edges;
+
+    bool bottom_up = false;
+
+    VertexId depth = 0;
+
+    for(; frontier_size > 0; depth++)
+    {
+        if(!bottom_up && frontier_edges > unexplored / bfs_alpha)
+        {
+            if(!workspace.symmetry_checked)
+            {
+                workspace.symmetric        = bfs_symmetric_pattern(G);
+                workspace.symmetry_checked = true;
+            }
+
+            if(workspace.symmetric)
+            {
+                bfs_queue_to_bitmap(workspace.frontier, frontier_size, workspace.frontier_bits);
+                bottom_up = true;
+            }
+        }
+        else if(bottom_up && frontier_size < num_rows / bfs_beta)
+        {
+            bfs_bitmap_to_queue(workspace.frontier_bits, workspace.frontier, workspace.thread_offsets);
+            bottom_up = false;
+        }
+
+        if(bottom_up)
+        {
+            frontier_size = bfs_bottom_up_step(G, workspace.frontier_bits, workspace.next_bits, raw_visited,
+                                               levels, parents, track_parents, depth, frontier_edges);
+            workspace.frontier_bits.swap(workspace.next_bits);
+        }
+        else
+        {
+            frontier_size = bfs_top_down_step(G, workspace.frontier, frontier_size, workspace.next, raw_visited,
+                                              levels, parents, track_parents, workspace.thread_offsets,
+                                              depth, frontier_edges);
+            workspace.frontier.swap(workspace.next);
+        }
+
+        unexplored -= std::min(unexplored, frontier_edges);
+    }
+
+    // the step at the last depth found no vertices
+    return depth - 1;
+}
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+typename MatrixType::index_type
+bfs_levels(omp::execution_policy<DerivedPolicy>& exec,
+           const MatrixType& G,
+           const typename MatrixType::index_type src,
+           ArrayType1& levels,
+           ArrayType2& parents,
+           const bool track_parents)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    bfs_workspace<VertexId, DerivedPolicy> workspace(exec, G.num_rows);
+
+    return bfs_levels(exec, G, src, levels, parents, track_parents, workspace);
+}
+
+// Direction-optimizing breadth-first search. Each level is expanded either
+// top-down from a queue of frontier vertices or, when the frontier is large
+// and the graph is symmetric, bottom-up by letting the unvisited vertices
+// look for a parent in a bitmap of the frontier.
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void breadth_first_search(omp::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const typename MatrixType::index_type src,
+                          ArrayType& labels,
+                          const bool mark_levels,
+                          cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const int num_rows = G.num_rows;
+
+    #pragma omp parallel for
+    for(int i = 0; i < num_rows; i++)
+        labels[i] = -1;
+
+    if(G.num_entries == 0)
+        return;
+
+    if(mark_levels)
+    {
+        bfs_levels(exec, G, src, labels, labels, false);
+    }
+    else
+    {
+        cusp::detail::temporary_array<VertexId, DerivedPolicy> levels(exec, num_rows, VertexId(-1));
+
+        bfs_levels(exec, G, src, levels, labels, true);
+
+        labels[src] = -2;
+    }
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
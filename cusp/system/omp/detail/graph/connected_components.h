@@ -17,5 +17,210 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/system/omp/detail/execution_policy.h>
+#include <cusp/system/omp/detail/format_utils.h>
+
+#include <thrust/memory.h>
+
+#include <algorithm>
+
+#include <omp.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// number of leading neighbors of every vertex linked before the full pass
+const size_t components_neighbor_rounds = 2;
+
+// number of vertices sampled to find the largest intermediate component
+const size_t components_num_samples = 1024;
+
+// Hooks the larger of the two roots reached from u and v onto the smaller
+// one. Concurrent hooks of the same root may overwrite each other, so the
+// caller repeats the pass until no edge joins two different roots. Labels
+// only ever decrease along parent pointers, so no cycles are formed.
+template <typename VertexId>
+bool components_hook(VertexId* parent, const VertexId u, const VertexId v)
+{
+    VertexId pu, pv;
+
+    #pragma omp atomic read
+    pu = parent[u];
+
+    #pragma omp atomic read
+    pv = parent[v];
+
+    if(pu == pv)
+        return false;
+
+    const VertexId high = std::max(pu, pv);
+    const VertexId low  = std::min(pu, pv);
+
+    VertexId parent_high;
+
+    #pragma omp atomic read
+    parent_high = parent[high];
+
+    if(parent_high == high)
+    {
+        #pragma omp atomic write
+        parent[high] = low;
+    }
+
+    return true;
+}
+
+// pointer jumping until every vertex points directly at its root
+template <typename VertexId>
+void components_compress(VertexId* parent, const VertexId num_vertices)
+{
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for(VertexId v = 0; v < num_vertices; v++)
+    {
+        VertexId root, next;
+
+        #pragma omp atomic read
+        root = parent[v];
+
+        while(true)
+        {
+            #pragma omp atomic read
+            next = parent[root];
+
+            if(next == root)
+                break;
+
+            root = next;
+        }
+
+        #pragma omp atomic write
+        parent[v] = root;
+    }
+}
+
+// Afforest-style connected components. A few neighbors of every vertex are
+// linked first, which typically collapses most of the graph into a single
+// large component. The remaining edges are then processed only for vertices
+// outside that component; for a symmetric graph the edges into it are seen
+// from the other endpoint. The root of every component is its smallest
+// vertex, so numbering the roots in order reproduces the sequential labels.
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t connected_components(omp::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            ArrayType& components,
+                            csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const VertexId num_vertices = G.num_rows;
+
+    if(num_vertices == 0)
+        return 0;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> parents(exec, num_vertices);
+
+    VertexId* parent = thrust::raw_pointer_cast(&parents[0]);
+
+    #pragma omp parallel for
+    for(VertexId v = 0; v < num_vertices; v++)
+        parent[v] = v;
+
+    // link a sample of the edges
+    for(size_t r = 0; r < components_neighbor_rounds; r++)
+    {
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for(VertexId v = 0; v < num_vertices; v++)
+        {
+            const VertexId jj = G.row_offsets[v] + r;
+
+            if(jj < G.row_offsets[v + 1])
+                components_hook(parent, v, VertexId(G.column_indices[jj]));
+        }
+
+        components_compress(parent, num_vertices);
+    }
+
+    // find the most frequent root among evenly spaced sample vertices
+    const size_t num_samples = std::min(size_t(num_vertices), components_num_samples);
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> samples(exec, num_samples);
+
+    for(size_t n = 0; n < num_samples; n++)
+        samples[n] = parent[(n * size_t(num_vertices)) / num_samples];
+
+    std::sort(&samples[0], &samples[0] + num_samples);
+
+    VertexId largest   = samples[0];
+    size_t   max_count = 0;
+
+    for(size_t n = 0; n < num_samples;)
+    {
+        size_t m = n + 1;
+
+        while(m < num_samples && samples[m] == samples[n])
+            m++;
+
+        if(m - n > max_count)
+        {
+            largest   = samples[n];
+            max_count = m - n;
+        }
+
+        n = m;
+    }
+
+    // link the remaining edges until every edge joins a single root
+    bool changed = true;
+
+    while(changed)
+    {
+        changed = false;
+
+        #pragma omp parallel for schedule(dynamic, 256) reduction(|| : changed)
+        for(VertexId v = 0; v < num_vertices; v++)
+        {
+            VertexId pv;
+
+            #pragma omp atomic read
+            pv = parent[v];
+
+            if(pv == largest)
+                continue;
+
+            for(VertexId jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+                if(components_hook(parent, v, VertexId(G.column_indices[jj])))
+                    changed = true;
+        }
+
+        components_compress(parent, num_vertices);
+    }
+
+    // number the components in order of their smallest vertex
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> offsets(exec, num_vertices + 1);
+
+    #pragma omp parallel for
+    for(VertexId v = 0; v < num_vertices; v++)
+        offsets[v + 1] = parent[v] == v ? 1 : 0;
+
+    counts_to_offsets(exec, num_vertices, offsets);
+
+    #pragma omp parallel for
+    for(VertexId v = 0; v < num_vertices; v++)
+        components[v] = offsets[parent[v]];
+
+    return offsets[num_vertices];
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
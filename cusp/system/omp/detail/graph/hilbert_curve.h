@@ -17,10 +17,20 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits elementwise
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+#include <cusp/system/omp/detail/sort.h>
+
+// the Hilbert transforms are shared with the sequential system
 #include <cusp/system/detail/sequential/graph/hilbert_curve.h>
 
+#include <algorithm>
+
+#include <omp.h>
+
 namespace cusp
 {
 namespace system
@@ -30,7 +40,98 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::hilbert_curve;
+// perm[k] is the index of the k-th point along the Hilbert curve. The keys
+// are computed in parallel and sorted with the parallel radix sort.
+template <typename DerivedPolicy, typename Array2d, typename Array1d>
+void hilbert_curve_order(omp::execution_policy<DerivedPolicy>& exec,
+                         const Array2d& coord,
+                         Array1d& perm)
+{
+    typedef typename Array2d::value_type ValueType;
+
+    const int num_points = coord.num_rows;
+    const int dims       = coord.num_cols;
+
+    if( (dims != 2) && (dims != 3) )
+        throw cusp::invalid_input_exception("Hilbert curve partitioning only implemented for 2D or 3D data.");
+
+    bool out_of_range = false;
+
+    #pragma omp parallel for reduction(||:out_of_range)
+    for(int i = 0; i < num_points; i++)
+    {
+        for(int d = 0; d < dims; d++)
+        {
+            const ValueType c = coord(i, d);
+
+            if( c < ValueType(0) || c > ValueType(1) )
+                out_of_range = true;
+        }
+    }
+
+    if( out_of_range )
+        throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
+
+    cusp::detail::temporary_array<unsigned long long, DerivedPolicy> hilbert_keys(exec, num_points);
+
+    typedef cusp::system::detail::sequential::detail::hilbert_transform_2d hilbert_transform_2d;
+    typedef cusp::system::detail::sequential::detail::hilbert_transform_3d hilbert_transform_3d;
+
+    // the integer keys keep all 56 (2D) or 57 (3D) bits for the radix sort,
+    // the double keys of the sequential system lose the lowest ones
+    unsigned long long max_key = 0;
+
+    #pragma omp parallel for reduction(max:max_key)
+    for(int i = 0; i < num_points; i++)
+    {
+        const unsigned long long key = dims == 2 ?
+                                       hilbert_transform_2d::key(coord(i, 0), coord(i, 1)) :
+                                       hilbert_transform_3d::key(coord(i, 0), coord(i, 1), coord(i, 2));
+
+        hilbert_keys[i] = key;
+        perm[i]         = i;
+        max_key         = std::max(max_key, key);
+    }
+
+    counting_sort_by_key(exec, hilbert_keys, perm, 0ULL, max_key);
+}
+
+template <typename DerivedPolicy, typename Array2d, typename Array1d>
+void hilbert_curve(omp::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   size_t num_parts,
+                   Array1d& parts)
+{
+    typedef typename Array1d::value_type PartType;
+
+    const int num_points = coord.num_rows;
+
+    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
+    hilbert_curve_order(exec, coord, perm);
+
+    const PartType part_size = std::max(size_t(1), num_points / num_parts);
+
+    #pragma omp parallel for
+    for(int k = 0; k < num_points; k++)
+        parts[perm[k]] = PartType(k) / part_size;
+}
+
+template <typename DerivedPolicy, typename Array2d, typename PermutationType>
+void hilbert_curve_permutation(omp::execution_policy<DerivedPolicy>& exec,
+                               const Array2d& coord,
+                               PermutationType& P)
+{
+    typedef typename PermutationType::index_type IndexType;
+
+    const int num_points = coord.num_rows;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> perm(exec, num_points);
+    hilbert_curve_order(exec, coord, perm);
+
+    #pragma omp parallel for
+    for(int k = 0; k < num_points; k++)
+        P.permutation[perm[k]] = k;
+}
 
 } // end namespace detail
 } // end namespace omp
@@ -17,7 +17,16 @@
 #pragma once
 
 #include <cusp/detail/config.h>
-#include <cusp/system/cpp/detail/graph/maximal_independent_set.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/array1d.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+
+#include <algorithm>
+
+#include <omp.h>
 
 namespace cusp
 {
@@ -28,10 +37,195 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::maximal_independent_set;
+// node states of the randomized MIS
+const unsigned char mis_non_mis_node   = 0;
+const unsigned char mis_undecided_node = 1;
+const unsigned char mis_mis_node       = 2;
+
+// lexicographic order of (state, random value, index) tuples
+template <typename RandomType, typename IndexType>
+bool mis_tuple_less(const unsigned char s1, const RandomType v1, const IndexType i1,
+                    const unsigned char s2, const RandomType v2, const IndexType i2)
+{
+    if(s1 != s2) return s1 < s2;
+    if(v1 != v2) return v1 < v2;
+    return i1 < i2;
+}
+
+// Randomized distance-k MIS. In every round each node finds the largest
+// (state, random value, index) tuple within its k-ring; undecided nodes that
+// are their own maximum join the set and undecided nodes whose maximum
+// joins the set are removed. The random values are the same hashed sequence
+// used by the generic implementation, so the result is deterministic and
+// identical to it for every thread count.
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+size_t luby_mis(omp::execution_policy<DerivedPolicy>& exec,
+                const ArrayType1& row_offsets,
+                const ArrayType2& column_indices,
+                const size_t k,
+                ArrayType3& stencil)
+{
+    typedef typename ArrayType2::value_type IndexType;
+    typedef unsigned int                    RandomType;
+    typedef unsigned char                   NodeStateType;
+
+    const IndexType N = row_offsets.size() - 1;
+
+    cusp::random_array<RandomType> random_values(N);
+
+    cusp::detail::temporary_array<RandomType,    DerivedPolicy> values(exec, N);
+    cusp::detail::temporary_array<NodeStateType, DerivedPolicy> states(exec, N, mis_undecided_node);
+    cusp::detail::temporary_array<NodeStateType, DerivedPolicy> next_states(exec, N);
+
+    // k-ring maxima of the current and previous ring
+    cusp::detail::temporary_array<NodeStateType, DerivedPolicy> max_states(exec, N);
+    cusp::detail::temporary_array<RandomType,    DerivedPolicy> max_values(exec, N);
+    cusp::detail::temporary_array<IndexType,     DerivedPolicy> max_indices(exec, N);
+    cusp::detail::temporary_array<NodeStateType, DerivedPolicy> last_states(exec, k > 1 ? N : 0);
+    cusp::detail::temporary_array<RandomType,    DerivedPolicy> last_values(exec, k > 1 ? N : 0);
+    cusp::detail::temporary_array<IndexType,     DerivedPolicy> last_indices(exec, k > 1 ? N : 0);
+
+    #pragma omp parallel for
+    for(IndexType i = 0; i < N; i++)
+        values[i] = random_values[i];
+
+    size_t active_nodes = N;
+
+    while(active_nodes > 0)
+    {
+        // largest 1-ring neighbor of each node
+        #pragma omp parallel for schedule(dynamic, 256)
+        for(IndexType i = 0; i < N; i++)
+        {
+            NodeStateType s = states[i];
+            RandomType    v = values[i];
+            IndexType     m = i;
+
+            for(IndexType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = column_indices[jj];
+
+                if(mis_tuple_less(s, v, m, states[j], values[j], j))
+                {
+                    s = states[j];
+                    v = values[j];
+                    m = j;
+                }
+            }
+
+            max_states[i]  = s;
+            max_values[i]  = v;
+            max_indices[i] = m;
+        }
+
+        // largest k-ring neighbor of each node
+        for(size_t ring = 1; ring < k; ring++)
+        {
+            max_states.swap(last_states);
+            max_values.swap(last_values);
+            max_indices.swap(last_indices);
+
+            #pragma omp parallel for schedule(dynamic, 256)
+            for(IndexType i = 0; i < N; i++)
+            {
+                NodeStateType s = last_states[i];
+                RandomType    v = last_values[i];
+                IndexType     m = last_indices[i];
+
+                for(IndexType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+                {
+                    const IndexType j = column_indices[jj];
+
+                    if(mis_tuple_less(s, v, m, last_states[j], last_values[j], last_indices[j]))
+                    {
+                        s = last_states[j];
+                        v = last_values[j];
+                        m = last_indices[j];
+                    }
+                }
+
+                max_states[i]  = s;
+                max_values[i]  = v;
+                max_indices[i] = m;
+            }
+        }
+
+        // local maxima join the set and their k-ring neighbors leave it
+        size_t undecided = 0;
+
+        #pragma omp parallel for reduction(+ : undecided)
+        for(IndexType i = 0; i < N; i++)
+        {
+            NodeStateType s = states[i];
+
+            if(s == mis_undecided_node)
+            {
+                const IndexType m = max_indices[i];
+
+                if(m == i)
+                    s = mis_mis_node;
+                else if(states[m] == mis_mis_node || (states[m] == mis_undecided_node && max_indices[m] == m))
+                    s = mis_non_mis_node;
+                else
+                    undecided++;
+            }
+
+            next_states[i] = s;
+        }
+
+        states.swap(next_states);
+
+        active_nodes = undecided;
+    }
+
+    // write output
+    stencil.resize(N);
+
+    size_t set_nodes = 0;
+
+    #pragma omp parallel for reduction(+ : set_nodes)
+    for(IndexType i = 0; i < N; i++)
+    {
+        stencil[i] = states[i] == mis_mis_node;
+        set_nodes += states[i] == mis_mis_node;
+    }
+
+    return set_nodes;
+}
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(omp::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               cusp::csr_format)
+{
+    return luby_mis(exec, G.row_offsets, G.column_indices, k, stencil);
+}
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(omp::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               cusp::coo_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = G.num_rows;
+    const IndexType M = G.num_entries;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, N + 1);
+
+    // the row indices are sorted, so each row starts at its lower bound
+    #pragma omp parallel for
+    for(IndexType i = 0; i <= N; i++)
+        row_offsets[i] = M == 0 ? 0 : std::lower_bound(&G.row_indices[0], &G.row_indices[0] + M, i) - &G.row_indices[0];
+
+    return luby_mis(exec, row_offsets, G.column_indices, k, stencil);
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
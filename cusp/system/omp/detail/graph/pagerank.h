@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/exception.h>
+#include <cusp/transpose.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+
+#include <omp.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Power iteration with two fused passes per iteration. The first scales the
+// rank of every vertex by its out-degree and sums the rank of the dangling
+// vertices, the second pulls the scaled ranks along the rows of the
+// transpose and writes the new ranks and the residual in place.
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType,
+         typename Monitor>
+void pagerank(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& G,
+              ArrayType& ranks,
+              Monitor& monitor,
+              const double damping,
+              csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename ArrayType::value_type  ValueType;
+
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const IndexType N = G.num_rows;
+
+    if(N == 0)
+        return;
+
+    CsrMatrix G_t;
+    cusp::transpose(exec, G, G_t);
+
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> scaled(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> residual(exec, N);
+
+    const ValueType alpha = damping;
+
+    #pragma omp parallel for
+    for(IndexType i = 0; i < N; i++)
+        ranks[i] = ValueType(1) / ValueType(N);
+
+    do
+    {
+        ValueType dangling = 0;
+
+        #pragma omp parallel for reduction(+ : dangling)
+        for(IndexType i = 0; i < N; i++)
+        {
+            const IndexType degree = G.row_offsets[i + 1] - G.row_offsets[i];
+
+            if(degree == 0)
+            {
+                dangling += ranks[i];
+                scaled[i] = ValueType(0);
+            }
+            else
+            {
+                scaled[i] = alpha * ranks[i] / ValueType(degree);
+            }
+        }
+
+        const ValueType teleport = (ValueType(1) - alpha + alpha * dangling) / ValueType(N);
+
+        #pragma omp parallel for schedule(dynamic, 256)
+        for(IndexType i = 0; i < N; i++)
+        {
+            ValueType sum = teleport;
+
+            for(IndexType jj = G_t.row_offsets[i]; jj < G_t.row_offsets[i + 1]; jj++)
+                sum += scaled[G_t.column_indices[jj]];
+
+            residual[i] = sum - ranks[i];
+            ranks[i]    = sum;
+        }
+
+        ++monitor;
+    }
+    while(!monitor.finished(exec, residual));
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -17,5 +17,134 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
 
-// this system has no special version of this algorithm
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+#include <cusp/system/omp/detail/graph/breadth_first_search.h>
+
+#include <cstdlib>
+
+#include <omp.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Vertex of minimum degree, ties broken by the smaller index, among the
+// vertices in the given level. Degree and index are packed into one key so
+// the search is a plain min reduction.
+template <typename MatrixType, typename ArrayType>
+typename MatrixType::index_type
+min_degree_vertex_in_level(const MatrixType& G,
+                           const ArrayType& levels,
+                           const typename MatrixType::index_type level)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const VertexId num_rows = G.num_rows;
+
+    unsigned long long min_key = static_cast<unsigned long long>(-1);
+
+    #pragma omp parallel for reduction(min : min_key)
+    for(VertexId v = 0; v < num_rows; v++)
+    {
+        if(levels[v] != level)
+            continue;
+
+        const unsigned long long degree = G.row_offsets[v + 1] - G.row_offsets[v];
+        const unsigned long long key    = degree * num_rows + v;
+
+        if(key < min_key)
+            min_key = key;
+    }
+
+    return min_key % num_rows;
+}
+
+// George-Liu search. Every sweep is a parallel BFS sharing one workspace
+// and is followed by a parallel search for the minimum degree vertex of
+// the last level, which becomes the root of the next sweep while the
+// eccentricity grows. On return levels holds the level structure rooted
+// at the returned vertex and eccentricity its depth, so callers such as
+// symmetric_rcm need no further search.
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_search(omp::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                         ArrayType& levels,
+                         typename MatrixType::index_type& eccentricity)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const VertexId num_rows = G.num_rows;
+
+    eccentricity = 0;
+
+    if(num_rows == 0)
+        return 0;
+
+    bfs_workspace<VertexId, DerivedPolicy> workspace(exec, num_rows);
+
+    VertexId x = rand() % num_rows;
+
+    #pragma omp parallel for
+    for(VertexId v = 0; v < num_rows; v++)
+        levels[v] = -1;
+
+    eccentricity = bfs_levels(exec, G, x, levels, levels, false, workspace);
+
+    while(eccentricity > 0)
+    {
+        const VertexId y = min_degree_vertex_in_level(G, levels, eccentricity);
+
+        #pragma omp parallel for
+        for(VertexId v = 0; v < num_rows; v++)
+            levels[v] = -1;
+
+        // y lies at distance eccentricity from x, so its own eccentricity
+        // is at least as large and the search stops once it is not larger
+        const VertexId y_eccentricity = bfs_levels(exec, G, y, levels, levels, false, workspace);
+
+        const bool grew = y_eccentricity > eccentricity;
+
+        // levels now describes y, so report y's depth even when stopping
+        x            = y;
+        eccentricity = y_eccentricity;
+
+        if(!grew)
+            break;
+    }
+
+    return x;
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(omp::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                         ArrayType& levels,
+                         cusp::csr_format)
+{
+    typename MatrixType::index_type eccentricity;
+
+    return pseudo_peripheral_search(exec, G, levels, eccentricity);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/exception.h>
+#include <cusp/transpose.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+
+#include <thrust/memory.h>
+
+#include <limits>
+
+#include <omp.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Asynchronous Bellman-Ford. Every round each vertex scans all of its
+// in-edges in G^T and pulls the distances of the in-neighbors that changed
+// in the previous round, so a round costs O(nnz) however small the set of
+// active vertices is. Pulling needs no atomic minimum, which OpenMP does
+// not provide for floating point values. Distances are updated in place
+// and may be read by other threads in the same round; they only decrease,
+// so reading a newer value just speeds up convergence, and every vertex
+// that changes is revisited from its out-neighbors next round.
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+void single_source_shortest_path(omp::execution_policy<DerivedPolicy>& exec,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                 ArrayType& distances,
+                                 csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename ArrayType::value_type  ValueType;
+
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const IndexType N = G.num_rows;
+
+    if(N == 0)
+        return;
+
+    const ValueType infinity = std::numeric_limits<ValueType>::max();
+
+    CsrMatrix G_t;
+    cusp::transpose(exec, G, G_t);
+
+    cusp::detail::temporary_array<char, DerivedPolicy> active(exec, N, 0);
+    cusp::detail::temporary_array<char, DerivedPolicy> next_active(exec, N, 0);
+
+    ValueType* distance = thrust::raw_pointer_cast(&distances[0]);
+
+    #pragma omp parallel for
+    for(IndexType i = 0; i < N; i++)
+        distance[i] = infinity;
+
+    distance[src] = ValueType(0);
+    active[src]   = 1;
+
+    // a shortest path has at most N - 1 edges
+    for(IndexType round = 0; round < N; round++)
+    {
+        bool changed = false;
+
+        #pragma omp parallel for schedule(dynamic, 256) reduction(||:changed)
+        for(IndexType i = 0; i < N; i++)
+        {
+            ValueType current;
+
+            #pragma omp atomic read
+            current = distance[i];
+
+            ValueType best = current;
+
+            for(IndexType jj = G_t.row_offsets[i]; jj < G_t.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = G_t.column_indices[jj];
+
+                if(!active[j])
+                    continue;
+
+                ValueType candidate;
+
+                #pragma omp atomic read
+                candidate = distance[j];
+
+                if(candidate == infinity)
+                    continue;
+
+                candidate += ValueType(G_t.values[jj]);
+
+                if(candidate < best)
+                    best = candidate;
+            }
+
+            if(best < current)
+            {
+                #pragma omp atomic write
+                distance[i] = best;
+
+                next_active[i] = 1;
+                changed        = true;
+            }
+        }
+
+        if(!changed)
+            break;
+
+        active.swap(next_active);
+
+        #pragma omp parallel for
+        for(IndexType i = 0; i < N; i++)
+            next_active[i] = 0;
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
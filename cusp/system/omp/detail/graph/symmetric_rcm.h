@@ -17,5 +17,316 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+#include <cusp/system/omp/detail/sort.h>
+#include <cusp/system/omp/detail/graph/pseudo_peripheral.h>
+
+#include <thrust/memory.h>
+#include <thrust/sort.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <omp.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Orders the vertices of one level by the position of their parent in the
+// previous level, then by degree and finally by index, which is the order
+// a queue-based Cuthill-McKee traversal appends them in.
+template <typename VertexId>
+struct rcm_level_compare
+{
+    const VertexId* parents;
+    const VertexId* row_offsets;
+
+    rcm_level_compare(const VertexId* parents, const VertexId* row_offsets)
+        : parents(parents), row_offsets(row_offsets) {}
+
+    bool operator()(const VertexId u, const VertexId v) const
+    {
+        if(parents[u] != parents[v])
+            return parents[u] < parents[v];
+
+        const VertexId degree_u = row_offsets[u + 1] - row_offsets[u];
+        const VertexId degree_v = row_offsets[v + 1] - row_offsets[v];
+
+        if(degree_u != degree_v)
+            return degree_u < degree_v;
+
+        return u < v;
+    }
+};
+
+// Appends the unvisited neighbors of order[level_begin:level_end] to order
+// starting at level_end and returns their number. Every vertex is claimed
+// by exactly one thread but not necessarily by its Cuthill-McKee parent.
+template <typename MatrixType, typename ArrayType1, typename ArrayType2>
+size_t rcm_expand_level(const MatrixType& G,
+                        ArrayType1& order,
+                        const size_t level_begin,
+                        const size_t level_end,
+                        int* visited,
+                        ArrayType2& thread_offsets)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const int num_level = level_end - level_begin;
+
+    size_t next_size = 0;
+
+    #pragma omp parallel
+    {
+        const int thread_id   = omp_get_thread_num();
+        const int num_threads = omp_get_num_threads();
+
+        std::vector<VertexId> discovered;
+
+        #pragma omp for schedule(dynamic, 64) nowait
+        for(int n = 0; n < num_level; n++)
+        {
+            const VertexId u = order[level_begin + n];
+
+            for(VertexId jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+            {
+                const VertexId v = G.column_indices[jj];
+                int claimed;
+
+                #pragma omp atomic read
+                claimed = visited[v];
+
+                if(claimed)
+                    continue;
+
+                #pragma omp atomic capture
+                { claimed = visited[v]; visited[v] = 1; }
+
+                if(!claimed)
+                    discovered.push_back(v);
+            }
+        }
+
+        thread_offsets[thread_id + 1] = discovered.size();
+
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            thread_offsets[0] = 0;
+
+            for(int t = 0; t < num_threads; t++)
+                thread_offsets[t + 1] += thread_offsets[t];
+
+            next_size = thread_offsets[num_threads];
+        }
+
+        std::copy(discovered.begin(), discovered.end(),
+                  order.begin() + level_end + thread_offsets[thread_id]);
+    }
+
+    return next_size;
+}
+
+// Sorts the level order[level_begin:level_end] into Cuthill-McKee order.
+// Every vertex looks up its parent as the earliest placed neighbor in the
+// previous level order[parent_begin:level_begin] and the level is sorted
+// by (parent, degree, index), which reproduces a queue-based Cuthill-McKee
+// traversal. The generic symmetric_rcm used by the other systems only
+// groups the vertices by level, so the permutations differ between them.
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void rcm_sort_level(omp::execution_policy<DerivedPolicy>& exec,
+                    const MatrixType& G,
+                    ArrayType& order,
+                    const size_t parent_begin,
+                    const size_t level_begin,
+                    const size_t level_end,
+                    typename MatrixType::index_type* positions,
+                    typename MatrixType::index_type* parents)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const VertexId* row_offsets = thrust::raw_pointer_cast(&G.row_offsets[0]);
+
+    const int num_level = level_end - level_begin;
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for(int n = 0; n < num_level; n++)
+    {
+        const VertexId v = order[level_begin + n];
+
+        VertexId parent = G.num_rows;
+
+        for(VertexId jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+        {
+            const VertexId p = positions[G.column_indices[jj]];
+
+            if(size_t(p) >= parent_begin && size_t(p) < level_begin)
+                parent = std::min(parent, p);
+        }
+
+        parents[v] = parent;
+    }
+
+    thrust::sort(exec, order.begin() + level_begin, order.begin() + level_end,
+                 rcm_level_compare<VertexId>(parents, row_offsets));
+
+    #pragma omp parallel for
+    for(int n = 0; n < num_level; n++)
+        positions[order[level_begin + n]] = level_begin + n;
+}
+
+// Level-synchronous Cuthill-McKee ordering of the component containing root,
+// placed at order[begin:]. Each level is discovered in parallel and then
+// sorted by rcm_sort_level, so the traversal is never serialized.
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+size_t rcm_order_component(omp::execution_policy<DerivedPolicy>& exec,
+                           const MatrixType& G,
+                           const typename MatrixType::index_type root,
+                           ArrayType1& order,
+                           const size_t begin,
+                           typename MatrixType::index_type* positions,
+                           typename MatrixType::index_type* parents,
+                           int* visited,
+                           ArrayType2& thread_offsets)
+{
+    order[begin]     = root;
+    positions[root]  = begin;
+    visited[root]    = 1;
+
+    size_t level_begin = begin;
+    size_t level_end   = begin + 1;
+
+    while(level_begin < level_end)
+    {
+        const size_t next_size = rcm_expand_level(G, order, level_begin, level_end, visited, thread_offsets);
+
+        rcm_sort_level(exec, G, order, level_begin, level_end, level_end + next_size, positions, parents);
+
+        level_begin = level_end;
+        level_end  += next_size;
+    }
+
+    return level_end;
+}
+
+// Cuthill-McKee ordering of the component of the pseudo-peripheral root from
+// the level structure computed by its search. A counting sort by level
+// groups the vertices of every level without another traversal and keys
+// unreached vertices past the last level. Returns the size of the component.
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+size_t rcm_order_levels(omp::execution_policy<DerivedPolicy>& exec,
+                        const MatrixType& G,
+                        ArrayType1& levels,
+                        const typename MatrixType::index_type eccentricity,
+                        ArrayType2& order,
+                        typename MatrixType::index_type* positions,
+                        typename MatrixType::index_type* parents,
+                        int* visited)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const VertexId num_vertices = G.num_rows;
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> level_offsets(exec, eccentricity + 2, size_t(num_vertices));
+
+    #pragma omp parallel for
+    for(VertexId v = 0; v < num_vertices; v++)
+    {
+        order[v] = v;
+
+        if(levels[v] < 0)
+        {
+            levels[v] = eccentricity + 1;
+        }
+        else
+        {
+            visited[v] = 1;
+        }
+    }
+
+    // group the vertices by level, each level is then fully ordered by
+    // rcm_sort_level
+    counting_sort_by_key(exec, levels, order, VertexId(0), VertexId(eccentricity + 1));
+
+    #pragma omp parallel for
+    for(VertexId n = 0; n < num_vertices; n++)
+        if(n == 0 || levels[n] != levels[n - 1])
+            level_offsets[levels[n]] = n;
+
+    positions[order[0]] = 0;
+
+    for(VertexId level = 1; level <= eccentricity; level++)
+        rcm_sort_level(exec, G, order, level_offsets[level - 1], level_offsets[level], level_offsets[level + 1],
+                       positions, parents);
+
+    return level_offsets[eccentricity + 1];
+}
+
+// Parallel reverse Cuthill-McKee. The first component is traversed from a
+// pseudo-peripheral vertex, any remaining components from their smallest
+// unvisited vertex, and the concatenated ordering is reversed.
+template<typename DerivedPolicy, typename MatrixType, typename PermutationType>
+void symmetric_rcm(omp::execution_policy<DerivedPolicy>& exec,
+                   const MatrixType& G,
+                   PermutationType& P,
+                   csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const VertexId num_vertices = G.num_rows;
+
+    if(num_vertices == 0)
+        return;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> order(exec, num_vertices);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> positions(exec, num_vertices, num_vertices);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> parents(exec, num_vertices);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> levels(exec, num_vertices);
+    cusp::detail::temporary_array<int, DerivedPolicy>      visited(exec, num_vertices, 0);
+    cusp::detail::temporary_array<size_t, DerivedPolicy>   thread_offsets(exec, omp_get_max_threads() + 1);
+
+    VertexId* raw_positions = thrust::raw_pointer_cast(&positions[0]);
+    VertexId* raw_parents   = thrust::raw_pointer_cast(&parents[0]);
+    int*      raw_visited   = thrust::raw_pointer_cast(&visited[0]);
+
+    // the first component is ordered from the level structure of the search
+    VertexId eccentricity;
+    pseudo_peripheral_search(exec, G, levels, eccentricity);
+
+    size_t num_ordered = rcm_order_levels(exec, G, levels, eccentricity, order,
+                                          raw_positions, raw_parents, raw_visited);
+
+    for(VertexId v = 0; num_ordered < size_t(num_vertices); v++)
+    {
+        if(visited[v])
+            continue;
+
+        num_ordered = rcm_order_component(exec, G, v, order, num_ordered,
+                                          raw_positions, raw_parents, raw_visited, thread_offsets);
+    }
+
+    // reverse the ordering and store the new position of every vertex
+    #pragma omp parallel for
+    for(VertexId n = 0; n < num_vertices; n++)
+        P.permutation[order[n]] = num_vertices - 1 - n;
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+
+#include <omp.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Masked L * L^T on the pattern of L, the strictly lower triangular part
+// of G, without forming L. For every entry (i,j) with j < i the sorted
+// parts of rows i and j below column j are intersected, so each triangle
+// i > j > k is found exactly once. The column indices of every row must
+// be sorted.
+template<typename DerivedPolicy,
+         typename MatrixType>
+size_t triangle_count(omp::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const IndexType N = G.num_rows;
+
+    size_t num_triangles = 0;
+
+    #pragma omp parallel for schedule(dynamic, 64) reduction(+ : num_triangles)
+    for(IndexType i = 0; i < N; i++)
+    {
+        const IndexType row_start = G.row_offsets[i];
+        const IndexType row_end   = G.row_offsets[i + 1];
+
+        for(IndexType jj = row_start; jj < row_end; jj++)
+        {
+            const IndexType j = G.column_indices[jj];
+
+            if(j >= i)
+                break;
+
+            IndexType a     = row_start;
+            IndexType b     = G.row_offsets[j];
+            IndexType b_end = G.row_offsets[j + 1];
+
+            while(a < jj && b < b_end)
+            {
+                const IndexType k_a = G.column_indices[a];
+                const IndexType k_b = G.column_indices[b];
+
+                if(k_b >= j)
+                    break;
+
+                if(k_a == k_b)
+                {
+                    num_triangles++;
+                    a++;
+                    b++;
+                }
+                else if(k_a < k_b)
+                {
+                    a++;
+                }
+                else
+                {
+                    b++;
+                }
+            }
+        }
+    }
+
+    return num_triangles;
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -17,7 +17,19 @@
 #pragma once
 
 #include <cusp/detail/config.h>
-#include <cusp/system/cpp/detail/graph/vertex_coloring.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+
+#include <thrust/memory.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <omp.h>
 
 namespace cusp
 {
@@ -28,10 +40,335 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::vertex_coloring;
+// Appends the vertices collected by each thread to worklist in thread
+// order and returns the new worklist size. Must be called by every thread
+// of the enclosing parallel region.
+template <typename VertexId, typename ArrayType1, typename ArrayType2>
+void coloring_gather_worklist(const std::vector<VertexId>& local,
+                              ArrayType1& worklist,
+                              ArrayType2& thread_offsets,
+                              size_t& worklist_size)
+{
+    const int thread_id   = omp_get_thread_num();
+    const int num_threads = omp_get_num_threads();
+
+    thread_offsets[thread_id + 1] = local.size();
+
+    #pragma omp barrier
+
+    #pragma omp single
+    {
+        thread_offsets[0] = 0;
+
+        for(int t = 0; t < num_threads; t++)
+            thread_offsets[t + 1] += thread_offsets[t];
+
+        worklist_size = thread_offsets[num_threads];
+    }
+
+    std::copy(local.begin(), local.end(), &worklist[0] + thread_offsets[thread_id]);
+}
+
+// Gebremedhin-Manne speculative coloring. Every vertex of the worklist
+// takes the smallest color not used by its neighbors, reading colors that
+// other threads may be writing concurrently. Adjacent vertices that ended
+// up with the same color are detected afterwards and the larger one of
+// each pair is colored again in the next round.
+template <typename DerivedPolicy, typename MatrixType, typename VertexId>
+size_t speculative_coloring(omp::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            VertexId* colors)
+{
+    const VertexId N = G.num_rows;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> worklist(exec, N);
+    cusp::detail::temporary_array<size_t, DerivedPolicy>   thread_offsets(exec, omp_get_max_threads() + 1, size_t(0));
+
+    #pragma omp parallel for
+    for(VertexId v = 0; v < N; v++)
+    {
+        colors[v]   = -1;
+        worklist[v] = v;
+    }
+
+    size_t worklist_size = N;
+
+    while(worklist_size > 0)
+    {
+        const VertexId num_work = worklist_size;
+
+        #pragma omp parallel
+        {
+            // forbidden[c] == v marks color c as used by a neighbor of v
+            std::vector<VertexId> forbidden;
+
+            #pragma omp for schedule(dynamic, 64)
+            for(VertexId n = 0; n < num_work; n++)
+            {
+                const VertexId v      = worklist[n];
+                const VertexId degree = G.row_offsets[v + 1] - G.row_offsets[v];
+
+                // first-fit never needs more than degree + 1 colors
+                if(forbidden.size() < size_t(degree) + 1)
+                    forbidden.resize(degree + 1, -1);
+
+                for(VertexId jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+                {
+                    const VertexId u = G.column_indices[jj];
+                    VertexId color;
+
+                    #pragma omp atomic read
+                    color = colors[u];
+
+                    if(u != v && color >= 0 && color <= degree)
+                        forbidden[color] = v;
+                }
+
+                VertexId color = 0;
+
+                while(forbidden[color] == v)
+                    color++;
+
+                #pragma omp atomic write
+                colors[v] = color;
+            }
+
+            // detect conflicts and keep the larger vertex of each pair
+            std::vector<VertexId> conflicts;
+
+            #pragma omp for schedule(dynamic, 64)
+            for(VertexId n = 0; n < num_work; n++)
+            {
+                const VertexId v = worklist[n];
+
+                for(VertexId jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+                {
+                    const VertexId u = G.column_indices[jj];
+
+                    if(u < v && colors[u] == colors[v])
+                    {
+                        conflicts.push_back(v);
+                        break;
+                    }
+                }
+            }
+
+            coloring_gather_worklist(conflicts, worklist, thread_offsets, worklist_size);
+        }
+    }
+
+    VertexId max_color = -1;
+
+    #pragma omp parallel for reduction(max : max_color)
+    for(VertexId v = 0; v < N; v++)
+        max_color = std::max(max_color, colors[v]);
+
+    return max_color + 1;
+}
+
+// Moves vertices out of color classes larger than N / num_colors. As in the
+// sequential backend, each vertex of an over-full class moves to the
+// smallest permissible class that is still under the target, reserving a
+// slot in it with an atomic update of the class size so no class grows
+// beyond the target. Adjacent vertices
+// that moved into the same class are recolored sequentially afterwards;
+// they are rare and recoloring them may add a color.
+template <typename DerivedPolicy, typename MatrixType, typename VertexId>
+size_t balance_coloring(omp::execution_policy<DerivedPolicy>& exec,
+                        const MatrixType& G,
+                        VertexId* colors,
+                        size_t num_colors)
+{
+    const VertexId N = G.num_rows;
+
+    if(num_colors == 0)
+        return 0;
+
+    const size_t target = (N + num_colors - 1) / num_colors;
+
+    // may grow by a color during the sequential recoloring below
+    std::vector<size_t> class_sizes(num_colors, 0);
+
+    cusp::detail::temporary_array<char, DerivedPolicy>     moved(exec, N, 0);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> conflicts(exec, N);
+    cusp::detail::temporary_array<size_t, DerivedPolicy>   thread_offsets(exec, omp_get_max_threads() + 1, size_t(0));
+
+    size_t* sizes = &class_sizes[0];
+
+    for(VertexId v = 0; v < N; v++)
+        sizes[colors[v]]++;
+
+    size_t num_conflicts = 0;
+
+    #pragma omp parallel
+    {
+        std::vector<VertexId> forbidden(num_colors, -1);
+
+        #pragma omp for schedule(dynamic, 64)
+        for(VertexId v = 0; v < N; v++)
+        {
+            const VertexId color = colors[v];
+
+            size_t color_size;
+
+            #pragma omp atomic read
+            color_size = sizes[color];
+
+            if(color_size <= target)
+                continue;
+
+            for(VertexId jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+            {
+                VertexId neighbor_color;
+
+                #pragma omp atomic read
+                neighbor_color = colors[G.column_indices[jj]];
+
+                forbidden[neighbor_color] = v;
+            }
+
+            // a class that fills up between choosing and reserving it is
+            // excluded, so this retries at most num_colors times
+            for(;;)
+            {
+                size_t best      = num_colors;
+                size_t best_size = target;
+
+                for(size_t c = 0; c < num_colors; c++)
+                {
+                    if(forbidden[c] == v)
+                        continue;
+
+                    size_t c_size;
+
+                    #pragma omp atomic read
+                    c_size = sizes[c];
+
+                    if(c_size < best_size)
+                    {
+                        best      = c;
+                        best_size = c_size;
+                    }
+                }
+
+                if(best == num_colors)
+                    break;
+
+                size_t old_size;
+
+                #pragma omp atomic capture
+                { old_size = sizes[best]; sizes[best]++; }
+
+                if(old_size < target)
+                {
+                    #pragma omp atomic
+                    sizes[color]--;
+
+                    #pragma omp atomic write
+                    colors[v] = best;
+
+                    moved[v] = 1;
+                    break;
+                }
+
+                #pragma omp atomic
+                sizes[best]--;
+
+                forbidden[best] = v;
+            }
+        }
+
+        // adjacent vertices may have moved into the same class
+        std::vector<VertexId> local_conflicts;
+
+        #pragma omp for schedule(dynamic, 64)
+        for(VertexId v = 0; v < N; v++)
+        {
+            if(!moved[v])
+                continue;
+
+            for(VertexId jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+            {
+                const VertexId u = G.column_indices[jj];
+
+                if(u < v && moved[u] && colors[u] == colors[v])
+                {
+                    local_conflicts.push_back(v);
+                    break;
+                }
+            }
+        }
+
+        coloring_gather_worklist(local_conflicts, conflicts, thread_offsets, num_conflicts);
+    }
+
+    // first-fit into the smallest permissible class
+    std::vector<VertexId> forbidden(num_colors, -1);
+
+    for(size_t n = 0; n < num_conflicts; n++)
+    {
+        const VertexId v = conflicts[n];
+
+        sizes[colors[v]]--;
+
+        for(VertexId jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+            forbidden[colors[G.column_indices[jj]]] = v;
+
+        size_t best = num_colors;
+
+        for(size_t c = 0; c < num_colors; c++)
+            if(forbidden[c] != v && (best == num_colors || sizes[c] < sizes[best]))
+                best = c;
+
+        if(best == num_colors)
+        {
+            class_sizes.push_back(0);
+            sizes = &class_sizes[0];
+            num_colors++;
+            forbidden.push_back(-1);
+        }
+
+        sizes[best]++;
+        colors[v] = best;
+    }
+
+    return num_colors;
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t vertex_coloring(omp::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const bool balance,
+                       cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    const VertexId N = G.num_rows;
+
+    if(N == 0)
+        return 0;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> vertex_colors(exec, N);
+
+    VertexId* raw_colors = thrust::raw_pointer_cast(&vertex_colors[0]);
+
+    size_t num_colors = speculative_coloring(exec, G, raw_colors);
+
+    if(balance)
+        num_colors = balance_coloring(exec, G, raw_colors, num_colors);
+
+    #pragma omp parallel for
+    for(VertexId v = 0; v < N; v++)
+        colors[v] = raw_colors[v];
+
+    return num_colors;
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
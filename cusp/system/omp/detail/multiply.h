@@ -18,7 +18,14 @@
 
 #include <cusp/detail/config.h>
 
+#include <cusp/system/omp/detail/multiply/bsr_spmv.h>
+#include <cusp/system/omp/detail/multiply/coo_spmv.h>
 #include <cusp/system/omp/detail/multiply/csr_spmv.h>
+#include <cusp/system/omp/detail/multiply/csr_block_spmv.h>
+#include <cusp/system/omp/detail/multiply/dia_spmv.h>
+#include <cusp/system/omp/detail/multiply/ell_spmv.h>
+#include <cusp/system/omp/detail/multiply/hyb_spmv.h>
+#include <cusp/system/omp/detail/multiply/sell_spmv.h>
 #include <cusp/system/omp/detail/multiply/coo_spgemm.h>
 #include <cusp/system/omp/detail/multiply/csr_spgemm.h>
 
@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/multiply/bsr_spmv.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// number of consecutive block rows processed by one thread at a time
+const size_t bsr_block_strip_size = 16;
+
+template <size_t BLOCK_SIZE,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmv(const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce)
+{
+    using cusp::system::detail::sequential::bsr_spmv_block_row;
+
+    int N = A.row_offsets.size() - 1;
+
+    #pragma omp parallel for
+    for(int i = 0; i < N; i++)
+        bsr_spmv_block_row<BLOCK_SIZE>(A, x, y, i, initialize, combine, reduce);
+}
+
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void bsr_spmv(const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce)
+{
+    using cusp::system::detail::sequential::bsr_spmv_block_row;
+
+    int N = A.row_offsets.size() - 1;
+    const size_t block_size = A.block_size;
+
+    switch (A.block_size)
+    {
+      case 1:  bsr_spmv<1>(A, x, y, initialize, combine, reduce); break;
+      case 2:  bsr_spmv<2>(A, x, y, initialize, combine, reduce); break;
+      case 3:  bsr_spmv<3>(A, x, y, initialize, combine, reduce); break;
+      case 4:  bsr_spmv<4>(A, x, y, initialize, combine, reduce); break;
+      case 5:  bsr_spmv<5>(A, x, y, initialize, combine, reduce); break;
+      case 6:  bsr_spmv<6>(A, x, y, initialize, combine, reduce); break;
+      case 8:  bsr_spmv<8>(A, x, y, initialize, combine, reduce); break;
+      default:
+        #pragma omp parallel for
+        for(int i = 0; i < N; i++)
+            bsr_spmv_block_row(A, x, y, i, block_size, initialize, combine, reduce);
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    if (A.num_rows == 0)
+        return;
+
+    bsr_spmv(A, x, y, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::bsr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    using cusp::system::detail::sequential::bsr_spmm;
+
+    if (A.num_rows == 0)
+        return;
+
+    const size_t num_block_rows = A.row_offsets.size() - 1;
+    const int    num_strips     = (num_block_rows + bsr_block_strip_size - 1) / bsr_block_strip_size;
+
+    // each strip sweeps the blocks of its rows once for all columns of x
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int s = 0; s < num_strips; s++)
+    {
+        const size_t row_start = s * bsr_block_strip_size;
+        const size_t row_end   = std::min(row_start + bsr_block_strip_size, num_block_rows);
+
+        bsr_spmm(A, x, y, row_start, row_end, initialize, combine, reduce);
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
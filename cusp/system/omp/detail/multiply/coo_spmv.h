@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <algorithm>
+
+#include <omp.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Segmented reduction COO SpMV. The entries, which are sorted by row, are
+// split into equal parts, one per thread. Rows that lie entirely within a
+// part are reduced directly into y, while the partial results of rows that
+// cross a part boundary are reduced into y afterwards in entry order.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::coo_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const int num_rows    = A.num_rows;
+    const int num_entries = A.num_entries;
+
+    #pragma omp parallel for
+    for(int i = 0; i < num_rows; i++)
+        y[i] = initialize(y[i]);
+
+    if (num_entries == 0)
+        return;
+
+    const int num_threads        = std::max(1, std::min(omp_get_max_threads(), num_entries));
+    const int entries_per_thread = (num_entries + num_threads - 1) / num_threads;
+
+    // partial results of the first and last row of each part
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> head_rows(exec, num_threads);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> carry_rows(exec, num_threads);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> head_values(exec, num_threads);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> carry_values(exec, num_threads);
+    cusp::detail::temporary_array<char, DerivedPolicy>      head_valid(exec, num_threads, 0);
+    cusp::detail::temporary_array<char, DerivedPolicy>      carry_valid(exec, num_threads, 0);
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int t = 0; t < num_threads; t++)
+    {
+        const int n_start = std::min(t * entries_per_thread, num_entries);
+        const int n_end   = std::min(n_start + entries_per_thread, num_entries);
+
+        int n = n_start;
+
+        while (n < n_end)
+        {
+            const IndexType i        = A.row_indices[n];
+            const bool      is_first = n == n_start;
+
+            ValueType partial = combine(A.values[n], x[A.column_indices[n]]);
+
+            for (n++; n < n_end && A.row_indices[n] == i; n++)
+                partial = reduce(partial, combine(A.values[n], x[A.column_indices[n]]));
+
+            const bool continues = n == n_end && n_end < num_entries && A.row_indices[n_end] == i;
+            const bool started   = is_first && n_start > 0 && A.row_indices[n_start - 1] == i;
+
+            if (continues)
+            {
+                carry_rows[t]   = i;
+                carry_values[t] = partial;
+                carry_valid[t]  = 1;
+            }
+            else if (started)
+            {
+                head_rows[t]   = i;
+                head_values[t] = partial;
+                head_valid[t]  = 1;
+            }
+            else
+            {
+                y[i] = reduce(y[i], partial);
+            }
+        }
+    }
+
+    // reduce the rows that cross part boundaries in entry order
+    for(int t = 0; t < num_threads; t++)
+    {
+        if (head_valid[t])
+            y[head_rows[t]] = reduce(y[head_rows[t]], head_values[t]);
+
+        if (carry_valid[t])
+            y[carry_rows[t]] = reduce(y[carry_rows[t]], carry_values[t]);
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
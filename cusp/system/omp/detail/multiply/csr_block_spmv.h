@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/multiply/csr_block_spmv.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// number of consecutive rows processed by one thread at a time
+const size_t csr_block_strip_size = 64;
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    using cusp::system::detail::sequential::csr_block_spmv_rows;
+
+    const size_t num_rows   = A.num_rows;
+    const int    num_strips = (num_rows + csr_block_strip_size - 1) / csr_block_strip_size;
+
+    // rows differ in length, so strips are handed out dynamically
+    #pragma omp parallel for schedule(dynamic, 1)
+    for(int s = 0; s < num_strips; s++)
+    {
+        const size_t row_start = s * csr_block_strip_size;
+        const size_t row_end   = std::min(row_start + csr_block_strip_size, num_rows);
+
+        csr_block_spmv_rows(A, x, y, row_start, row_end, initialize, combine, reduce);
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -19,8 +19,15 @@
 
 #include <cusp/detail/temporary_array.h>
 
-#include <iostream>
-#include <list>
+#include <cusp/system/omp/detail/format_utils.h>
+
+#include <thrust/functional.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
 
 namespace cusp
 {
@@ -31,6 +38,184 @@ namespace omp
 namespace detail
 {
 
+// rows whose symbolic upper bound does not exceed this size are accumulated
+// by sorting their products, larger rows use a hash table
+const size_t spmm_csr_small_row_size = 32;
+
+// Number of products formed for row i of C = A * B, which bounds the number
+// of entries in that row of C.
+template <typename Array1, typename Array2, typename Array3>
+size_t spmm_csr_row_bound(const size_t i, const size_t num_cols,
+                          const Array1& A_row_offsets, const Array2& A_column_indices,
+                          const Array3& B_row_offsets)
+{
+    typedef typename Array1::value_type IndexType;
+
+    size_t bound = 0;
+
+    for(IndexType jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+    {
+        const IndexType j = A_column_indices[jj];
+        bound += B_row_offsets[j + 1] - B_row_offsets[j];
+    }
+
+    return std::min(bound, num_cols);
+}
+
+// Per-thread accumulator for one row of C. Its storage is sized from the
+// symbolic upper bound of the rows it has processed rather than from the
+// number of columns of C, and it is reused across the rows of a thread.
+// Rows are dispatched by their upper bound: short rows collect their
+// products and sort them, longer rows insert into an open addressing hash
+// table of at least twice the bound. Both produce the entries of the row
+// sorted by column, combining duplicates in the order they were formed.
+template <typename IndexType, typename ValueType>
+class spmm_csr_accumulator
+{
+    typedef std::pair<IndexType,ValueType> EntryType;
+
+    static const IndexType empty = static_cast<IndexType>(-1);
+
+    std::vector<IndexType> keys;
+    std::vector<ValueType> sums;
+    std::vector<size_t>    slots;
+    std::vector<EntryType> entries;
+
+    size_t mask;
+    bool   use_hash;
+
+    static bool less_column(const EntryType& a, const EntryType& b)
+    {
+        return a.first < b.first;
+    }
+
+    size_t hash_slot(const IndexType k) const
+    {
+        size_t h = (size_t(k) * size_t(2654435761u)) & mask;
+
+        while(keys[h] != empty && keys[h] != k)
+            h = (h + 1) & mask;
+
+        return h;
+    }
+
+public:
+
+    spmm_csr_accumulator(void) : mask(0), use_hash(false) {}
+
+    void begin_row(const size_t bound)
+    {
+        entries.clear();
+
+        use_hash = bound > spmm_csr_small_row_size;
+
+        if(use_hash)
+        {
+            size_t capacity = 2 * spmm_csr_small_row_size;
+
+            while(capacity < 2 * bound)
+                capacity *= 2;
+
+            if(keys.size() < capacity)
+            {
+                keys.resize(capacity, empty);
+                sums.resize(capacity);
+            }
+
+            mask = capacity - 1;
+            slots.clear();
+        }
+    }
+
+    template <typename BinaryFunction>
+    void insert(const IndexType k, const ValueType v, BinaryFunction reduce)
+    {
+        if(use_hash)
+        {
+            const size_t h = hash_slot(k);
+
+            if(keys[h] == empty)
+            {
+                keys[h] = k;
+                sums[h] = reduce(ValueType(0), v);
+                slots.push_back(h);
+            }
+            else
+            {
+                sums[h] = reduce(sums[h], v);
+            }
+        }
+        else
+        {
+            entries.push_back(EntryType(k, v));
+        }
+    }
+
+    // leaves the unique entries of the row in entries sorted by column and
+    // returns their number
+    template <typename BinaryFunction>
+    size_t end_row(BinaryFunction reduce)
+    {
+        if(use_hash)
+        {
+            for(size_t n = 0; n < slots.size(); n++)
+            {
+                const size_t h = slots[n];
+
+                entries.push_back(EntryType(keys[h], sums[h]));
+
+                // clear table
+                keys[h] = empty;
+            }
+
+            std::sort(entries.begin(), entries.end(), less_column);
+
+            return entries.size();
+        }
+
+        // insertion sort keeps duplicates in the order they were formed
+        for(size_t n = 1; n < entries.size(); n++)
+        {
+            const EntryType entry = entries[n];
+
+            size_t m = n;
+
+            for(; m > 0 && entry.first < entries[m - 1].first; m--)
+                entries[m] = entries[m - 1];
+
+            entries[m] = entry;
+        }
+
+        size_t length = 0;
+
+        for(size_t n = 0; n < entries.size(); n++)
+        {
+            if(length > 0 && entries[length - 1].first == entries[n].first)
+            {
+                entries[length - 1].second = reduce(entries[length - 1].second, entries[n].second);
+            }
+            else
+            {
+                entries[length].first  = entries[n].first;
+                entries[length].second = reduce(ValueType(0), entries[n].second);
+                length++;
+            }
+        }
+
+        entries.resize(length);
+
+        return length;
+    }
+
+    const EntryType& operator[](const size_t n) const
+    {
+        return entries[n];
+    }
+};
+
+template <typename IndexType, typename ValueType>
+const IndexType spmm_csr_accumulator<IndexType,ValueType>::empty;
+
 //MW: note that this function is also used by coo.h
 //MW: computes the total number of nonzeors of C
 template <typename DerivedPolicy,
@@ -44,42 +229,40 @@ size_t spmm_csr_pass1(omp::execution_policy<DerivedPolicy>& exec,
                       Array5& C_row_offsets)
 {
     typedef typename Array1::value_type IndexType1;
-    typedef typename Array2::value_type IndexType2;
-
-    C_row_offsets[0] = 0;
+    typedef typename Array3::value_type IndexType2;
+    typedef typename Array5::value_type IndexType;
 
     #pragma omp parallel
     {
-        cusp::detail::temporary_array<int, DerivedPolicy> mask(exec, num_cols, -1);
+        spmm_csr_accumulator<IndexType, char> accumulator;
 
         // Compute nnz in C (including explicit zeros)
-        #pragma omp for
+        #pragma omp for schedule(dynamic, 64)
         for(int i = 0; i < int(num_rows); i++)
         {
-            size_t num_nonzeros = 0;
+            const size_t bound = spmm_csr_row_bound(i, num_cols, A_row_offsets, A_column_indices, B_row_offsets);
+
+            if(bound <= 1)
+            {
+                C_row_offsets[i + 1] = bound;
+                continue;
+            }
+
+            accumulator.begin_row(bound);
 
             for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
             {
-                IndexType1 j = A_column_indices[jj];
+                const IndexType1 j = A_column_indices[jj];
 
                 for(IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
-                {
-                    IndexType2 k = B_column_indices[kk];
-
-                    if(mask[k] != i)
-                    {
-                        mask[k] = i;
-                        num_nonzeros++;
-                    }
-                }
+                    accumulator.insert(B_column_indices[kk], char(0), thrust::project2nd<char,char>());
             }
 
-            C_row_offsets[i + 1] = num_nonzeros;
+            C_row_offsets[i + 1] = accumulator.end_row(thrust::project2nd<char,char>());
         } // end for loop
     }// end omp parallel
 
-    for(int i = 1; i < int(num_rows + 1); i++)
-      C_row_offsets[i] += C_row_offsets[i - 1];
+    counts_to_offsets(exec, num_rows, C_row_offsets);
 
     return C_row_offsets[num_rows];
 }
@@ -97,65 +280,42 @@ void spmm_csr_pass2(omp::execution_policy<DerivedPolicy>& exec,
                     Array7& C_row_offsets,       Array8& C_column_indices,       Array9& C_values,
                     UnaryFunction initialize,    BinaryFunction1 combine,        BinaryFunction2 reduce)
 {
+    typedef typename Array1::value_type IndexType1;
+    typedef typename Array4::value_type IndexType2;
     typedef typename Array7::value_type IndexType;
     typedef typename Array9::value_type ValueType;
 
-    const IndexType unseen = static_cast<IndexType>(-1);
-    const IndexType init   = static_cast<IndexType>(-2);
-
     #pragma omp parallel
     {
         // Compute entries of C
-        cusp::detail::temporary_array<IndexType, DerivedPolicy> next(exec, num_cols, unseen);
-        cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, num_cols, ValueType(0));
+        spmm_csr_accumulator<IndexType, ValueType> accumulator;
 
-        #pragma omp for
+        #pragma omp for schedule(dynamic, 64)
         for (int i = 0; i < int(num_rows); i++)
         {
-            IndexType head   = init;
-            IndexType length = 0;
-
-            IndexType jj_start = A_row_offsets[i];
-            IndexType jj_end   = A_row_offsets[i + 1];
-
-            for (IndexType jj = jj_start; jj < jj_end; jj++)
-            {
-                IndexType j = A_column_indices[jj];
-                ValueType v = A_values[jj];
+            const IndexType offset = C_row_offsets[i];
+            const IndexType length = C_row_offsets[i + 1] - offset;
 
-                IndexType kk_start = B_row_offsets[j];
-                IndexType kk_end   = B_row_offsets[j + 1];
+            if (length == 0)
+                continue;
 
-                for (IndexType kk = kk_start; kk < kk_end; kk++)
-                {
-                    IndexType k = B_column_indices[kk];
-                    ValueType b = B_values[kk];
+            accumulator.begin_row(spmm_csr_row_bound(i, num_cols, A_row_offsets, A_column_indices, B_row_offsets));
 
-                    sums[k] = reduce(sums[k], combine(v, b));
+            for (IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+            {
+                const IndexType1 j = A_column_indices[jj];
+                const ValueType  v = A_values[jj];
 
-                    if (next[k] == unseen)
-                    {
-                        next[k] = head;
-                        head = k;
-                        length++;
-                    }
-                }
+                for (IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                    accumulator.insert(B_column_indices[kk], combine(v, B_values[kk]), reduce);
             }
 
-            size_t offset = C_row_offsets[i];
+            accumulator.end_row(reduce);
 
-            for (IndexType jj = 0; jj < length; jj++)
+            for (IndexType n = 0; n < length; n++)
             {
-                C_column_indices[offset] = head;
-                C_values[offset] = sums[head];
-                offset++;
-
-                IndexType temp = head;
-                head = next[head];
-
-                // clear arrays
-                next[temp] = unseen;
-                sums[temp] = ValueType(0);
+                C_column_indices[offset + n] = accumulator[n].first;
+                C_values[offset + n]         = accumulator[n].second;
             }
         } // end for loop
     } //omp parallel
@@ -197,6 +357,232 @@ void multiply(omp::execution_policy<DerivedPolicy>& exec,
                    initialize, combine, reduce);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void spgemm_symbolic(omp::execution_policy<DerivedPolicy>& exec,
+                     const MatrixType1& A,
+                     const MatrixType2& B,
+                     MatrixType3& C,
+                     cusp::csr_format,
+                     cusp::csr_format,
+                     cusp::csr_format)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType2;
+    typedef typename MatrixType3::index_type IndexType;
+
+    C.resize(A.num_rows, B.num_cols, 0);
+
+    size_t num_nonzeros =
+        spmm_csr_pass1(exec, A.num_rows, B.num_cols,
+                       A.row_offsets, A.column_indices,
+                       B.row_offsets, B.column_indices,
+                       C.row_offsets);
+
+    C.resize(A.num_rows, B.num_cols, num_nonzeros);
+
+    #pragma omp parallel
+    {
+        spmm_csr_accumulator<IndexType, char> accumulator;
+
+        // record the column of every structural entry of C, sorted within rows
+        #pragma omp for schedule(dynamic, 64)
+        for(int i = 0; i < int(A.num_rows); i++)
+        {
+            const IndexType offset = C.row_offsets[i];
+            const IndexType length = C.row_offsets[i + 1] - offset;
+
+            if(length == 0)
+                continue;
+
+            accumulator.begin_row(spmm_csr_row_bound(i, B.num_cols, A.row_offsets, A.column_indices, B.row_offsets));
+
+            for(IndexType1 jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType1 j = A.column_indices[jj];
+
+                for(IndexType2 kk = B.row_offsets[j]; kk < B.row_offsets[j + 1]; kk++)
+                    accumulator.insert(B.column_indices[kk], char(0), thrust::project2nd<char,char>());
+            }
+
+            accumulator.end_row(thrust::project2nd<char,char>());
+
+            for(IndexType n = 0; n < length; n++)
+                C.column_indices[offset + n] = accumulator[n].first;
+        }
+    }
+}
+
+// The structure of C already fixes where every product lands, so each row
+// is computed independently by locating the column of each product in the
+// sorted row of C. No scan or per-thread accumulator is needed.
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spgemm_numeric(omp::execution_policy<DerivedPolicy>& exec,
+                    const MatrixType1& A,
+                    const MatrixType2& B,
+                    MatrixType3& C,
+                    UnaryFunction   initialize,
+                    BinaryFunction1 combine,
+                    BinaryFunction2 reduce,
+                    cusp::csr_format,
+                    cusp::csr_format,
+                    cusp::csr_format)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType2;
+    typedef typename MatrixType3::index_type IndexType;
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for(int i = 0; i < int(A.num_rows); i++)
+    {
+        const IndexType row_start = C.row_offsets[i];
+        const IndexType row_end   = C.row_offsets[i + 1];
+
+        for(IndexType n = row_start; n < row_end; n++)
+            C.values[n] = initialize(C.values[n]);
+
+        for(IndexType1 jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType1 j = A.column_indices[jj];
+
+            for(IndexType2 kk = B.row_offsets[j]; kk < B.row_offsets[j + 1]; kk++)
+            {
+                const IndexType k = B.column_indices[kk];
+
+                IndexType lo = row_start;
+                IndexType hi = row_end;
+
+                while(lo < hi)
+                {
+                    const IndexType mid = lo + (hi - lo) / 2;
+
+                    if(C.column_indices[mid] < k)
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+
+                C.values[lo] = reduce(C.values[lo], combine(A.values[jj], B.values[kk]));
+            }
+        }
+    }
+}
+
+// The rows of C are computed independently into scratch arrays laid out
+// like M, each thread marking the columns of its current row of M in a
+// private dense position array. The number of entries hit in every row
+// then gives the row offsets of C and a second parallel pass compacts the
+// hit entries.
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename MatrixType4,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void masked_spgemm(omp::execution_policy<DerivedPolicy>& exec,
+                   const MatrixType1& A,
+                   const MatrixType2& B,
+                   const MatrixType3& M,
+                   MatrixType4& C,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce,
+                   cusp::csr_format,
+                   cusp::csr_format,
+                   cusp::csr_format,
+                   cusp::csr_format)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType2;
+    typedef typename MatrixType3::index_type IndexType3;
+    typedef typename MatrixType4::index_type IndexType;
+    typedef typename MatrixType4::value_type ValueType;
+
+    const IndexType3 unmarked = static_cast<IndexType3>(-1);
+
+    C.resize(M.num_rows, M.num_cols, 0);
+
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, M.num_entries);
+    cusp::detail::temporary_array<char, DerivedPolicy>      hit(exec, M.num_entries, 0);
+
+    #pragma omp parallel
+    {
+        std::vector<IndexType3> position(M.num_cols, unmarked);
+
+        #pragma omp for schedule(dynamic, 64)
+        for(int i = 0; i < int(M.num_rows); i++)
+        {
+            const IndexType3 row_start = M.row_offsets[i];
+            const IndexType3 row_end   = M.row_offsets[i + 1];
+
+            IndexType length = 0;
+
+            if(row_start < row_end)
+            {
+                for(IndexType3 n = row_start; n < row_end; n++)
+                {
+                    position[M.column_indices[n]] = n;
+                    sums[n] = initialize(M.values[n]);
+                }
+
+                for(IndexType1 jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+                {
+                    const IndexType1 j = A.column_indices[jj];
+
+                    for(IndexType2 kk = B.row_offsets[j]; kk < B.row_offsets[j + 1]; kk++)
+                    {
+                        const IndexType3 n = position[B.column_indices[kk]];
+
+                        if(n == unmarked)
+                            continue;
+
+                        sums[n] = reduce(sums[n], combine(A.values[jj], B.values[kk]));
+                        hit[n]  = 1;
+                    }
+                }
+
+                for(IndexType3 n = row_start; n < row_end; n++)
+                {
+                    position[M.column_indices[n]] = unmarked;
+                    length += hit[n];
+                }
+            }
+
+            C.row_offsets[i + 1] = length;
+        }
+    }
+
+    counts_to_offsets(exec, M.num_rows, C.row_offsets);
+
+    C.resize(M.num_rows, M.num_cols, C.row_offsets[M.num_rows]);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for(int i = 0; i < int(M.num_rows); i++)
+    {
+        IndexType offset = C.row_offsets[i];
+
+        for(IndexType3 n = M.row_offsets[i]; n < M.row_offsets[i + 1]; n++)
+        {
+            if(hit[n])
+            {
+                C.column_indices[offset] = M.column_indices[n];
+                C.values[offset]         = sums[n];
+                offset++;
+            }
+        }
+    }
+}
+
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
@@ -29,9 +29,14 @@
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 
+#include <cusp/detail/temporary_array.h>
 #include <cusp/detail/utils.h>
 #include <cusp/detail/array2d_format_utils.h>
 
+#include <algorithm>
+
+#include <omp.h>
+
 namespace cusp
 {
 namespace system
@@ -41,8 +46,39 @@ namespace omp
 namespace detail
 {
 
+// Locate the intersection of a merge-path diagonal with the merge of the
+// row end offsets (row_offsets[1:]) and the nonzero indices [0, num_entries).
+// Returns the number of row ends consumed; diagonal minus the result is the
+// number of nonzeros consumed.
+template <typename ArrayType>
+size_t merge_path_search(const ArrayType& row_offsets,
+                         const size_t diagonal,
+                         const size_t num_rows,
+                         const size_t num_entries)
+{
+    size_t lo = diagonal > num_entries ? diagonal - num_entries : 0;
+    size_t hi = std::min(diagonal, num_rows);
+
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+
+        if (size_t(row_offsets[mid + 1]) <= diagonal - 1 - mid)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+// Merge-path CSR SpMV. The merged sequence of row ends and nonzeros is split
+// into equal parts, one per thread, so rows with many nonzeros are shared
+// between threads instead of serializing on one of them. Rows split across
+// thread boundaries are finished in a sequential fixup pass that applies
+// initialize once and reduces the partial results in nonzero order.
 template <typename DerivedPolicy,
-		      typename MatrixType,
+          typename MatrixType,
           typename VectorType1,
           typename VectorType2,
           typename UnaryFunction,
@@ -62,26 +98,124 @@ void multiply(omp::execution_policy<DerivedPolicy>& exec,
     typedef typename MatrixType::index_type  IndexType;
     typedef typename VectorType2::value_type ValueType;
 
-	int N = A.num_rows;
+    const size_t num_rows    = A.num_rows;
+    const size_t num_entries = A.row_offsets[num_rows];
+
+    if (num_rows == 0)
+        return;
 
-    #pragma omp parallel for
-    for(int i = 0; i < N; i++)
+    const int    num_threads      = std::max(1, omp_get_max_threads());
+    const size_t num_merge_items  = num_rows + num_entries;
+    const size_t items_per_thread = (num_merge_items + num_threads - 1) / num_threads;
+
+    // partial results of the rows that begin or end inside another thread's part
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> head_rows(exec, num_threads);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> carry_rows(exec, num_threads);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> carry_values(exec, num_threads);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> head_values(exec, num_threads);
+    cusp::detail::temporary_array<char, DerivedPolicy>      carry_valid(exec, num_threads, 0);
+    cusp::detail::temporary_array<char, DerivedPolicy>      head_valid(exec, num_threads, 0);
+    cusp::detail::temporary_array<char, DerivedPolicy>      has_head(exec, num_threads, 0);
+
+    #pragma omp parallel for schedule(static, 1)
+    for (int t = 0; t < num_threads; t++)
     {
-        const IndexType row_start = A.row_offsets[i];
-        const IndexType row_end   = A.row_offsets[i+1];
+        const size_t diagonal_start = std::min(t * items_per_thread, num_merge_items);
+        const size_t diagonal_end   = std::min(diagonal_start + items_per_thread, num_merge_items);
+
+        const size_t row_start = merge_path_search(A.row_offsets, diagonal_start, num_rows, num_entries);
+        const size_t row_end   = merge_path_search(A.row_offsets, diagonal_end,   num_rows, num_entries);
+        const size_t nz_start  = diagonal_start - row_start;
+        const size_t nz_end    = diagonal_end   - row_end;
 
-        ValueType accumulator = initialize(y[i]);
+        size_t jj = nz_start;
 
-        for (IndexType jj = row_start; jj < row_end; jj++)
+        for (size_t i = row_start; i < row_end; i++)
         {
-            const IndexType j   = A.column_indices[jj];
-            const ValueType Aij = A.values[jj];
-            const ValueType xj  = x[j];
+            const size_t jj_end = A.row_offsets[i + 1];
+
+            if (i == row_start && nz_start > size_t(A.row_offsets[i]))
+            {
+                // the head of this row belongs to a previous thread
+                head_rows[t] = i;
+                has_head[t]  = 1;
+
+                if (jj < jj_end)
+                {
+                    ValueType partial = combine(A.values[jj], x[A.column_indices[jj]]);
+
+                    for (jj++; jj < jj_end; jj++)
+                        partial = reduce(partial, combine(A.values[jj], x[A.column_indices[jj]]));
+
+                    head_values[t] = partial;
+                    head_valid[t]  = 1;
+                }
+
+                continue;
+            }
+
+            ValueType accumulator = initialize(y[i]);
+
+            for (; jj < jj_end; jj++)
+                accumulator = reduce(accumulator, combine(A.values[jj], x[A.column_indices[jj]]));
 
-            accumulator = reduce(accumulator, combine(Aij, xj));
+            y[i] = accumulator;
         }
 
-        y[i] = accumulator;
+        // carry-out for the row that continues into the next thread
+        carry_rows[t] = row_end;
+
+        if (jj < nz_end)
+        {
+            ValueType partial = combine(A.values[jj], x[A.column_indices[jj]]);
+
+            for (jj++; jj < nz_end; jj++)
+                partial = reduce(partial, combine(A.values[jj], x[A.column_indices[jj]]));
+
+            carry_values[t] = partial;
+            carry_valid[t]  = 1;
+        }
+    }
+
+    // fixup rows that were split across threads
+    size_t    pending_row   = num_rows;
+    bool      pending_valid = false;
+    ValueType pending_value = ValueType(0);
+
+    for (int t = 0; t < num_threads; t++)
+    {
+        if (has_head[t])
+        {
+            const size_t row = head_rows[t];
+
+            ValueType accumulator = initialize(y[row]);
+
+            if (pending_valid && pending_row == row)
+                accumulator = reduce(accumulator, pending_value);
+
+            if (head_valid[t])
+                accumulator = reduce(accumulator, head_values[t]);
+
+            y[row] = accumulator;
+
+            pending_valid = false;
+        }
+
+        if (carry_valid[t])
+        {
+            const size_t row = carry_rows[t];
+
+            if (pending_valid && pending_row == row)
+            {
+                pending_value = reduce(pending_value, carry_values[t]);
+            }
+            else
+            {
+                pending_row   = row;
+                pending_value = carry_values[t];
+                pending_valid = true;
+            }
+        }
     }
 }
 
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// number of consecutive rows processed by one thread at a time
+const size_t dia_strip_size = 256;
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::dia_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const size_t num_diagonals = A.values.num_cols;
+    const size_t num_rows      = A.num_rows;
+    const size_t num_cols      = A.num_cols;
+    const int    num_strips    = (num_rows + dia_strip_size - 1) / dia_strip_size;
+
+    // each thread sweeps every diagonal over a strip of rows, so the
+    // column-major values are read contiguously and y stays in cache
+    #pragma omp parallel for
+    for(int s = 0; s < num_strips; s++)
+    {
+        const size_t row_start = s * dia_strip_size;
+        const size_t row_end   = std::min(row_start + dia_strip_size, num_rows);
+
+        for(size_t i = row_start; i < row_end; i++)
+            y[i] = initialize(y[i]);
+
+        for(size_t d = 0; d < num_diagonals; d++)
+        {
+            const IndexType k = A.diagonal_offsets[d];
+
+            // rows of the strip for which 0 <= i + k < num_cols
+            const IndexType i_start = std::max<IndexType>(IndexType(row_start), -k);
+            const IndexType i_end   = std::min<IndexType>(IndexType(row_end), IndexType(num_cols) - k);
+
+            for(IndexType i = i_start; i < i_end; i++)
+            {
+                const ValueType Aij = A.values(i, d);
+                const ValueType xj  = x[i + k];
+
+                y[i] = reduce(y[i], combine(Aij, xj));
+            }
+        }
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// number of consecutive rows processed by one thread at a time
+const size_t ell_strip_size = 256;
+
+// y[row_start:row_end] = A[row_start:row_end,:] * x, traversing the strip one
+// column of the column-major ELL arrays at a time so accesses are contiguous
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void ell_spmv_strip(const MatrixType& A,
+                    const VectorType1& x,
+                    VectorType2& y,
+                    const size_t row_start,
+                    const size_t row_end,
+                    UnaryFunction   initialize,
+                    BinaryFunction1 combine,
+                    BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const size_t num_entries_per_row = A.column_indices.num_cols;
+
+    const IndexType invalid_index = MatrixType::invalid_index;
+
+    for(size_t i = row_start; i < row_end; i++)
+        y[i] = initialize(y[i]);
+
+    for(size_t n = 0; n < num_entries_per_row; n++)
+    {
+        for(size_t i = row_start; i < row_end; i++)
+        {
+            const IndexType j   = A.column_indices(i, n);
+            const ValueType Aij = A.values(i, n);
+
+            if (j != invalid_index)
+                y[i] = reduce(y[i], combine(Aij, x[j]));
+        }
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::ell_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    const size_t num_rows   = A.num_rows;
+    const int    num_strips = (num_rows + ell_strip_size - 1) / ell_strip_size;
+
+    #pragma omp parallel for
+    for(int s = 0; s < num_strips; s++)
+    {
+        const size_t row_start = s * ell_strip_size;
+        const size_t row_end   = std::min(row_start + ell_strip_size, num_rows);
+
+        ell_spmv_strip(A, x, y, row_start, row_end, initialize, combine, reduce);
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
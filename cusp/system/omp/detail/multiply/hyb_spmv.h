@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/omp/detail/multiply/ell_spmv.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// index of the first COO entry whose row is not less than row
+template <typename ArrayType>
+size_t coo_row_lower_bound(const ArrayType& row_indices, const size_t row)
+{
+    size_t lo = 0;
+    size_t hi = row_indices.size();
+
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+
+        if (size_t(row_indices[mid]) < row)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+// Fused HYB SpMV. Each thread owns a strip of rows and applies both the ELL
+// part and the COO entries of those rows while the strip of y is in cache.
+// The COO part must be sorted by row, as produced by the conversions.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::hyb_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    const size_t num_rows   = A.num_rows;
+    const int    num_strips = (num_rows + ell_strip_size - 1) / ell_strip_size;
+
+    #pragma omp parallel for
+    for(int s = 0; s < num_strips; s++)
+    {
+        const size_t row_start = s * ell_strip_size;
+        const size_t row_end   = std::min(row_start + ell_strip_size, num_rows);
+
+        ell_spmv_strip(A.ell, x, y, row_start, row_end, initialize, combine, reduce);
+
+        const size_t n_start = coo_row_lower_bound(A.coo.row_indices, row_start);
+        const size_t n_end   = coo_row_lower_bound(A.coo.row_indices, row_end);
+
+        for(size_t n = n_start; n < n_end; n++)
+        {
+            const size_t i = A.coo.row_indices[n];
+
+            y[i] = reduce(y[i], combine(A.coo.values[n], x[A.coo.column_indices[n]]));
+        }
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/multiply/sell_spmv.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+template <size_t CHUNK_SIZE,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void sell_spmv(const MatrixType& A,
+               const VectorType1& x,
+               VectorType2& y,
+               UnaryFunction   initialize,
+               BinaryFunction1 combine,
+               BinaryFunction2 reduce)
+{
+    using cusp::system::detail::sequential::sell_spmv_chunk;
+
+    int N = A.chunk_offsets.size() - 1;
+
+    // chunks are sorted by length within each sigma window only, so their
+    // widths vary and dynamic scheduling balances the work across threads
+    #pragma omp parallel for schedule(dynamic, 64)
+    for(int c = 0; c < N; c++)
+        sell_spmv_chunk<CHUNK_SIZE>(A, x, y, c, initialize, combine, reduce);
+}
+
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void sell_spmv(const MatrixType& A,
+               const VectorType1& x,
+               VectorType2& y,
+               UnaryFunction   initialize,
+               BinaryFunction1 combine,
+               BinaryFunction2 reduce)
+{
+    using cusp::system::detail::sequential::sell_spmv_chunk;
+
+    int N = A.chunk_offsets.size() - 1;
+    const size_t chunk_size = A.chunk_size;
+
+    switch (A.chunk_size)
+    {
+      case 1:  sell_spmv<1>(A, x, y, initialize, combine, reduce); break;
+      case 2:  sell_spmv<2>(A, x, y, initialize, combine, reduce); break;
+      case 4:  sell_spmv<4>(A, x, y, initialize, combine, reduce); break;
+      case 8:  sell_spmv<8>(A, x, y, initialize, combine, reduce); break;
+      case 16: sell_spmv<16>(A, x, y, initialize, combine, reduce); break;
+      case 32: sell_spmv<32>(A, x, y, initialize, combine, reduce); break;
+      default:
+        #pragma omp parallel for schedule(dynamic, 64)
+        for(int c = 0; c < N; c++)
+            sell_spmv_chunk(A, x, y, c, chunk_size, initialize, combine, reduce);
+    }
+}
+
+template <typename MatrixType,
+          typename ColumnView1,
+          typename ColumnView2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void sell_spmv_column(const MatrixType& A,
+                      const ColumnView1& x,
+                      ColumnView2 y,
+                      UnaryFunction   initialize,
+                      BinaryFunction1 combine,
+                      BinaryFunction2 reduce)
+{
+    sell_spmv(A, x, y, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::sell_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    if (A.num_rows == 0)
+        return;
+
+    sell_spmv(A, x, y, initialize, combine, reduce);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::sell_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    if (A.num_rows == 0)
+        return;
+
+    for (size_t k = 0; k < x.num_cols; k++)
+        sell_spmv_column(A, x.column(k), y.column(k), initialize, combine, reduce);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
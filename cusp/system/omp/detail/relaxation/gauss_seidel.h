@@ -18,8 +18,7 @@
 
 #include <cusp/detail/config.h>
 
-// this system inherits gauss_seidel relaxation
-#include <cusp/system/cpp/detail/relaxation/gauss_seidel.h>
+#include <cusp/system/omp/detail/execution_policy.h>
 
 namespace cusp
 {
@@ -30,7 +29,56 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::gauss_seidel_indexed;
+// Relaxes the rows indices[row_start:row_stop:row_step] in parallel. The
+// relaxation calls this once per color of a multicolor ordering, so the
+// rows of one range share no off-diagonal entries and can be updated
+// concurrently with the same result as a sequential sweep.
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2>
+void gauss_seidel_indexed(omp::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& A,
+                                ArrayType1&  x,
+                          const ArrayType1&  b,
+                          const ArrayType2& indices,
+                          const int row_start,
+                          const int row_stop,
+                          const int row_step)
+{
+    typedef typename ArrayType1::value_type V;
+    typedef typename ArrayType2::value_type I;
+
+    const int num_rows = (row_stop - row_start) / row_step;
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for(int n = 0; n < num_rows; n++)
+    {
+        I inew  = indices[row_start + n * row_step];
+        I start = A.row_offsets[inew];
+        I end   = A.row_offsets[inew + 1];
+        V rsum  = 0;
+        V diag  = 0;
+
+        for(I jj = start; jj < end; ++jj)
+        {
+            I j = A.column_indices[jj];
+            if (inew == j)
+            {
+                diag = A.values[jj];
+            }
+            else
+            {
+                rsum += A.values[jj]*x[j];
+            }
+        }
+
+        if (diag != 0)
+        {
+            x[inew] = (b[inew] - rsum)/diag;
+        }
+    }
+}
 
 } // end namespace detail
 } // end namespace omp
@@ -17,6 +17,15 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/exception.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+#include <cusp/system/detail/generic/radix_sort.h>
+
+#include <algorithm>
+
+#include <omp.h>
 
 // this system inherits sort
 #include <cusp/system/cpp/detail/sort.h>
@@ -30,11 +39,142 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::counting_sort;
-using cusp::system::detail::sequential::counting_sort_by_key;
+// Computes the destination of every key in a stable sort by the digit
+// ((key - min) >> shift) & (2^digit_bits - 1). Each thread counts the
+// digits of a contiguous part of the keys, the histograms are scanned in
+// digit-major order, and each thread then ranks its part in order.
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+void radix_sort_ranks(omp::execution_policy<DerivedPolicy>& exec,
+                      const ArrayType1& keys,
+                      const size_t min,
+                      const size_t shift,
+                      const size_t digit_bits,
+                      ArrayType2& ranks)
+{
+    const size_t num_keys    = keys.size();
+    const size_t num_buckets = size_t(1) << digit_bits;
+    const size_t mask        = num_buckets - 1;
+    const int    num_parts   = std::max(1, omp_get_max_threads());
+    const size_t part_size   = (num_keys + num_parts - 1) / num_parts;
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> counts(exec, num_parts * num_buckets, size_t(0));
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int p = 0; p < num_parts; p++)
+    {
+        const size_t start = std::min(num_keys, p * part_size);
+        const size_t end   = std::min(num_keys, start + part_size);
+        const size_t base  = p * num_buckets;
+
+        for(size_t n = start; n < end; n++)
+            counts[base + (((size_t(keys[n]) - min) >> shift) & mask)]++;
+    }
+
+    size_t running = 0;
+
+    for(size_t d = 0; d < num_buckets; d++)
+    {
+        for(int p = 0; p < num_parts; p++)
+        {
+            const size_t count = counts[p * num_buckets + d];
+            counts[p * num_buckets + d] = running;
+            running += count;
+        }
+    }
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int p = 0; p < num_parts; p++)
+    {
+        const size_t start = std::min(num_keys, p * part_size);
+        const size_t end   = std::min(num_keys, start + part_size);
+        const size_t base  = p * num_buckets;
+
+        for(size_t n = start; n < end; n++)
+            ranks[n] = counts[base + (((size_t(keys[n]) - min) >> shift) & mask)]++;
+    }
+}
+
+// output[ranks[n]] = input[n]
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void radix_sort_scatter(const ArrayType1& input, const ArrayType2& ranks, ArrayType3& output)
+{
+    const int N = input.size();
+
+    #pragma omp parallel for
+    for(int n = 0; n < N; n++)
+        output[ranks[n]] = input[n];
+}
+
+// parallel histogram and scatter steps of the shared radix sort drivers
+template <typename DerivedPolicy>
+struct radix_pass
+{
+    omp::execution_policy<DerivedPolicy>& exec;
+
+    radix_pass(omp::execution_policy<DerivedPolicy>& exec) : exec(exec) {}
+
+    template <typename ArrayType1, typename ArrayType2>
+    void ranks(const ArrayType1& keys, const size_t min, const size_t shift, const size_t digit_bits, ArrayType2& ranks)
+    {
+        radix_sort_ranks(exec, keys, min, shift, digit_bits, ranks);
+    }
+
+    template <typename ArrayType1, typename ArrayType2, typename ArrayType3>
+    void scatter(const ArrayType1& input, const ArrayType2& ranks, ArrayType3& output)
+    {
+        radix_sort_scatter(input, ranks, output);
+    }
+};
+
+template <typename DerivedPolicy, typename ArrayType>
+void counting_sort(omp::execution_policy<DerivedPolicy>& exec,
+                   ArrayType& keys,
+                   typename ArrayType::value_type min,
+                   typename ArrayType::value_type max)
+{
+    radix_pass<DerivedPolicy> radix(exec);
+
+    cusp::system::detail::generic::radix_counting_sort(exec, radix, keys, min, max);
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+void counting_sort_by_key(omp::execution_policy<DerivedPolicy>& exec,
+                          ArrayType1& keys, ArrayType2& vals,
+                          typename ArrayType1::value_type min,
+                          typename ArrayType1::value_type max)
+{
+    radix_pass<DerivedPolicy> radix(exec);
+
+    cusp::system::detail::generic::radix_counting_sort_by_key(exec, radix, keys, vals, min, max);
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void sort_by_row(omp::execution_policy<DerivedPolicy>& exec,
+                 ArrayType1& row_indices, ArrayType2& column_indices, ArrayType3& values,
+                 typename ArrayType1::value_type min_row,
+                 typename ArrayType1::value_type max_row)
+{
+    radix_pass<DerivedPolicy> radix(exec);
+
+    cusp::system::detail::generic::radix_sort_by_row(exec, radix, row_indices, column_indices, values,
+                                                     min_row, max_row);
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void sort_by_row_and_column(omp::execution_policy<DerivedPolicy>& exec,
+                            ArrayType1& row_indices, ArrayType2& column_indices, ArrayType3& values,
+                            typename ArrayType1::value_type min_row,
+                            typename ArrayType1::value_type max_row,
+                            typename ArrayType2::value_type min_col,
+                            typename ArrayType2::value_type max_col)
+{
+    radix_pass<DerivedPolicy> radix(exec);
+
+    cusp::system::detail::generic::radix_sort_by_row_and_column(exec, radix, row_indices, column_indices, values,
+                                                                min_row, max_row, min_col, max_col);
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
@@ -17,6 +17,15 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+#include <cusp/system/omp/detail/format_utils.h>
+
+#include <algorithm>
+
+#include <omp.h>
 
 // this system inherits transpose
 #include <cusp/system/cpp/detail/transpose.h>
@@ -30,10 +39,152 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::transpose;
+// number of contiguous parts of the entries that are histogrammed
+// independently, limited so the histograms take about as much storage as
+// the entries themselves
+inline int transpose_num_parts(const size_t num_entries, const size_t num_cols)
+{
+    const size_t max_parts = std::max(1, omp_get_max_threads());
+
+    if(num_cols == 0)
+        return 1;
+
+    return int(std::max(size_t(1), std::min(max_parts, 2 * num_entries / num_cols)));
+}
+
+// Counts the columns of each part into its own histogram, turns the
+// histograms into the starting position of every (part, column) pair
+// relative to the start of the column, and writes the column offsets of
+// the transpose. Scattering each part in order through its histogram then
+// keeps the entries of every column in their original order.
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void transpose_column_offsets(omp::execution_policy<DerivedPolicy>& exec,
+                              const ArrayType1& column_indices,
+                              const size_t num_cols,
+                              const int num_parts,
+                              ArrayType2& counts,
+                              ArrayType3& offsets)
+{
+    typedef typename ArrayType2::value_type IndexType;
+
+    const size_t num_entries = column_indices.size();
+    const size_t part_size   = (num_entries + num_parts - 1) / num_parts;
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int p = 0; p < num_parts; p++)
+    {
+        const size_t start = std::min(num_entries, p * part_size);
+        const size_t end   = std::min(num_entries, start + part_size);
+        const size_t base  = p * num_cols;
+
+        for(size_t n = start; n < end; n++)
+            counts[base + column_indices[n]]++;
+    }
+
+    #pragma omp parallel for
+    for(int col = 0; col < int(num_cols); col++)
+    {
+        IndexType running = 0;
+
+        for(int p = 0; p < num_parts; p++)
+        {
+            const IndexType count = counts[p * num_cols + col];
+            counts[p * num_cols + col] = running;
+            running += count;
+        }
+
+        offsets[col + 1] = running;
+    }
+
+    counts_to_offsets(exec, num_cols, offsets);
+}
+
+// COO format
+template <typename DerivedPolicy, typename MatrixType1, typename MatrixType2>
+void transpose(omp::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A, MatrixType2& At,
+               cusp::coo_format, cusp::coo_format)
+{
+    typedef typename MatrixType2::index_type IndexType;
+
+    At.resize(A.num_cols, A.num_rows, A.num_entries);
+
+    const size_t num_entries = A.num_entries;
+    const size_t num_cols    = A.num_cols;
+    const int    num_parts   = transpose_num_parts(num_entries, num_cols);
+    const size_t part_size   = (num_entries + num_parts - 1) / num_parts;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> counts(exec, num_parts * num_cols, IndexType(0));
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> offsets(exec, num_cols + 1);
+
+    transpose_column_offsets(exec, A.column_indices, num_cols, num_parts, counts, offsets);
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int p = 0; p < num_parts; p++)
+    {
+        const size_t start = std::min(num_entries, p * part_size);
+        const size_t end   = std::min(num_entries, start + part_size);
+        const size_t base  = p * num_cols;
+
+        for(size_t n = start; n < end; n++)
+        {
+            const IndexType col = A.column_indices[n];
+            const IndexType j   = offsets[col] + counts[base + col]++;
+
+            At.row_indices[j]    = col;
+            At.column_indices[j] = A.row_indices[n];
+            At.values[j]         = A.values[n];
+        }
+    }
+}
+
+// CSR format
+template <typename DerivedPolicy, typename MatrixType1, typename MatrixType2>
+void transpose(omp::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A, MatrixType2& At,
+               cusp::csr_format, cusp::csr_format)
+{
+    typedef typename MatrixType2::index_type IndexType;
+
+    At.resize(A.num_cols, A.num_rows, A.num_entries);
+
+    const size_t num_entries = A.num_entries;
+    const size_t num_cols    = A.num_cols;
+    const int    num_parts   = transpose_num_parts(num_entries, num_cols);
+    const size_t part_size   = (num_entries + num_parts - 1) / num_parts;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> counts(exec, num_parts * num_cols, IndexType(0));
+
+    transpose_column_offsets(exec, A.column_indices, num_cols, num_parts, counts, At.row_offsets);
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int p = 0; p < num_parts; p++)
+    {
+        const size_t start = std::min(num_entries, p * part_size);
+        const size_t end   = std::min(num_entries, start + part_size);
+        const size_t base  = p * num_cols;
+
+        if(start == end)
+            continue;
+
+        // find the row containing the first entry of the part
+        size_t row = std::upper_bound(A.row_offsets.begin(), A.row_offsets.end(), IndexType(start)) - A.row_offsets.begin() - 1;
+
+        for(size_t n = start; n < end; n++)
+        {
+            while(size_t(A.row_offsets[row + 1]) <= n)
+                row++;
+
+            const IndexType col = A.column_indices[n];
+            const IndexType j   = At.row_offsets[col] + counts[base + col]++;
+
+            At.column_indices[j] = row;
+            At.values[j]         = A.values[n];
+        }
+    }
+}
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
-
@@ -17,5 +17,224 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/array1d.h>
+
+#include <cusp/system/tbb/detail/execution_policy.h>
+
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/functional.h>
+#include <thrust/sequence.h>
+#include <thrust/transform.h>
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// node states of the randomized MIS
+const unsigned char mis_non_mis_node   = 0;
+const unsigned char mis_undecided_node = 1;
+const unsigned char mis_mis_node       = 2;
+
+// replace each (state, value, index) tuple with the largest one in its 1-ring
+template <typename ArrayType1, typename ArrayType2, typename StateArray, typename ValueArray, typename IndexArray>
+struct mis_ring_body
+{
+    typedef typename ArrayType2::value_type IndexType;
+
+    const ArrayType1& row_offsets;
+    const ArrayType2& column_indices;
+    const StateArray& last_states;
+    const ValueArray& last_values;
+    const IndexArray& last_indices;
+    StateArray&       max_states;
+    ValueArray&       max_values;
+    IndexArray&       max_indices;
+
+    mis_ring_body(const ArrayType1& row_offsets, const ArrayType2& column_indices,
+                  const StateArray& last_states, const ValueArray& last_values, const IndexArray& last_indices,
+                  StateArray& max_states, ValueArray& max_values, IndexArray& max_indices)
+        : row_offsets(row_offsets), column_indices(column_indices),
+          last_states(last_states), last_values(last_values), last_indices(last_indices),
+          max_states(max_states), max_values(max_values), max_indices(max_indices) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& rows) const
+    {
+        for(size_t i = rows.begin(); i < rows.end(); i++)
+        {
+            unsigned char s = last_states[i];
+            unsigned int  v = last_values[i];
+            IndexType     m = last_indices[i];
+
+            for(IndexType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = column_indices[jj];
+
+                const unsigned char sj = last_states[j];
+                const unsigned int  vj = last_values[j];
+                const IndexType     mj = last_indices[j];
+
+                if(s < sj || (s == sj && (v < vj || (v == vj && m < mj))))
+                {
+                    s = sj;
+                    v = vj;
+                    m = mj;
+                }
+            }
+
+            max_states[i]  = s;
+            max_values[i]  = v;
+            max_indices[i] = m;
+        }
+    }
+};
+
+// local maxima join the set and their k-ring neighbors leave it
+template <typename StateArray, typename IndexArray>
+struct mis_update_body
+{
+    const StateArray& states;
+    const IndexArray& max_indices;
+    StateArray&       next_states;
+
+    mis_update_body(const StateArray& states, const IndexArray& max_indices, StateArray& next_states)
+        : states(states), max_indices(max_indices), next_states(next_states) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& rows) const
+    {
+        for(size_t i = rows.begin(); i < rows.end(); i++)
+        {
+            unsigned char s = states[i];
+
+            if(s == mis_undecided_node)
+            {
+                const size_t m = max_indices[i];
+
+                if(m == i)
+                    s = mis_mis_node;
+                else if(states[m] == mis_mis_node || (states[m] == mis_undecided_node && size_t(max_indices[m]) == m))
+                    s = mis_non_mis_node;
+            }
+
+            next_states[i] = s;
+        }
+    }
+};
+
+// Randomized distance-k MIS over the k-ring maxima of (state, random value,
+// index) tuples, using the same hashed random values as the generic
+// implementation so the result is deterministic and identical to it.
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+size_t luby_mis(tbb::execution_policy<DerivedPolicy>& exec,
+                const ArrayType1& row_offsets,
+                const ArrayType2& column_indices,
+                const size_t k,
+                ArrayType3& stencil)
+{
+    typedef typename ArrayType2::value_type                             IndexType;
+    typedef cusp::detail::temporary_array<unsigned char, DerivedPolicy> StateArray;
+    typedef cusp::detail::temporary_array<unsigned int,  DerivedPolicy> ValueArray;
+    typedef cusp::detail::temporary_array<IndexType,     DerivedPolicy> IndexArray;
+
+    const size_t N = row_offsets.size() - 1;
+
+    cusp::random_array<unsigned int> random_values(N);
+
+    ValueArray values(exec, random_values.begin(), random_values.end());
+    StateArray states(exec, N, mis_undecided_node);
+    StateArray next_states(exec, N);
+
+    StateArray max_states(exec, N);
+    ValueArray max_values(exec, N);
+    IndexArray max_indices(exec, N);
+    StateArray last_states(exec, N);
+    ValueArray last_values(exec, N);
+    IndexArray last_indices(exec, N);
+
+    size_t active_nodes = N;
+
+    while(active_nodes > 0)
+    {
+        thrust::copy(exec, states.begin(), states.end(), max_states.begin());
+        thrust::copy(exec, values.begin(), values.end(), max_values.begin());
+        thrust::sequence(exec, max_indices.begin(), max_indices.end());
+
+        // largest k-ring neighbor of each node
+        for(size_t ring = 0; ring < k; ring++)
+        {
+            max_states.swap(last_states);
+            max_values.swap(last_values);
+            max_indices.swap(last_indices);
+
+            mis_ring_body<ArrayType1, ArrayType2, StateArray, ValueArray, IndexArray>
+                ring_body(row_offsets, column_indices, last_states, last_values, last_indices,
+                          max_states, max_values, max_indices);
+            ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, N), ring_body, ::tbb::auto_partitioner());
+        }
+
+        mis_update_body<StateArray, IndexArray> update_body(states, max_indices, next_states);
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, N), update_body);
+
+        states.swap(next_states);
+
+        active_nodes = thrust::count(exec, states.begin(), states.end(), mis_undecided_node);
+    }
+
+    // write output
+    stencil.resize(N);
+
+    thrust::transform(exec, states.begin(), states.end(),
+                      thrust::constant_iterator<unsigned char>(mis_mis_node),
+                      stencil.begin(), thrust::equal_to<unsigned char>());
+
+    return thrust::count(exec, states.begin(), states.end(), mis_mis_node);
+}
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(tbb::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               cusp::csr_format)
+{
+    return luby_mis(exec, G.row_offsets, G.column_indices, k, stencil);
+}
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(tbb::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               cusp::coo_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, G.num_rows + 1);
+
+    thrust::lower_bound(exec,
+                        G.row_indices.begin(), G.row_indices.end(),
+                        thrust::counting_iterator<IndexType>(0),
+                        thrust::counting_iterator<IndexType>(G.num_rows + 1),
+                        row_offsets.begin());
+
+    return luby_mis(exec, row_offsets, G.column_indices, k, stencil);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
@@ -18,5 +18,9 @@
 
 #include <cusp/detail/config.h>
 
+#include <cusp/system/tbb/detail/multiply/coo_spmv.h>
+#include <cusp/system/tbb/detail/multiply/csr_spmv.h>
+#include <cusp/system/tbb/detail/multiply/csr_spgemm.h>
+
 // this system inherits multiply
 #include <cusp/system/cpp/detail/multiply.h>
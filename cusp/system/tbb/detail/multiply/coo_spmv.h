@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/tbb/detail/execution_policy.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// index of the first entry whose row is not less than row
+template <typename ArrayType>
+size_t coo_row_lower_bound(const ArrayType& row_indices, const size_t num_entries, const size_t row)
+{
+    size_t lo = 0;
+    size_t hi = num_entries;
+
+    while (lo < hi)
+    {
+        const size_t mid = (lo + hi) / 2;
+
+        if (size_t(row_indices[mid]) < row)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+// Each task owns a range of rows and locates the matching range of the
+// row-sorted entries with a binary search, so no two tasks update the
+// same entry of y.
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+struct coo_spmv_body
+{
+    const MatrixType&  A;
+    const VectorType1& x;
+    VectorType2&       y;
+    UnaryFunction      initialize;
+    BinaryFunction1    combine;
+    BinaryFunction2    reduce;
+
+    coo_spmv_body(const MatrixType& A, const VectorType1& x, VectorType2& y,
+                  UnaryFunction initialize, BinaryFunction1 combine, BinaryFunction2 reduce)
+        : A(A), x(x), y(y), initialize(initialize), combine(combine), reduce(reduce) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& rows) const
+    {
+        for(size_t i = rows.begin(); i < rows.end(); i++)
+            y[i] = initialize(y[i]);
+
+        const size_t n_start = coo_row_lower_bound(A.row_indices, A.num_entries, rows.begin());
+        const size_t n_end   = coo_row_lower_bound(A.row_indices, A.num_entries, rows.end());
+
+        for(size_t n = n_start; n < n_end; n++)
+        {
+            const size_t i = A.row_indices[n];
+
+            y[i] = reduce(y[i], combine(A.values[n], x[A.column_indices[n]]));
+        }
+    }
+};
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(tbb::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::coo_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    coo_spmv_body<MatrixType,VectorType1,VectorType2,UnaryFunction,BinaryFunction1,BinaryFunction2>
+        body(A, x, y, initialize, combine, reduce);
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, A.num_rows), body, ::tbb::auto_partitioner());
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
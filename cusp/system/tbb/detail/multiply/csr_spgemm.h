@@ -0,0 +1,230 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/tbb/detail/execution_policy.h>
+
+#include <thrust/scan.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// counts the entries of each row of C = A * B (including explicit zeros)
+template <typename MatrixType1, typename MatrixType2, typename ArrayType>
+struct spmm_csr_pass1_body
+{
+    typedef typename ArrayType::value_type                  IndexType;
+    typedef ::tbb::enumerable_thread_specific< std::vector<IndexType> > MaskType;
+
+    const MatrixType1& A;
+    const MatrixType2& B;
+    ArrayType&         C_row_offsets;
+    MaskType&          masks;
+
+    spmm_csr_pass1_body(const MatrixType1& A, const MatrixType2& B, ArrayType& C_row_offsets, MaskType& masks)
+        : A(A), B(B), C_row_offsets(C_row_offsets), masks(masks) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& rows) const
+    {
+        std::vector<IndexType>& mask = masks.local();
+
+        for(size_t i = rows.begin(); i < rows.end(); i++)
+        {
+            IndexType num_nonzeros = 0;
+
+            for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = A.column_indices[jj];
+
+                for(IndexType kk = B.row_offsets[j]; kk < B.row_offsets[j + 1]; kk++)
+                {
+                    const IndexType k = B.column_indices[kk];
+
+                    if(mask[k] != IndexType(i))
+                    {
+                        mask[k] = i;
+                        num_nonzeros++;
+                    }
+                }
+            }
+
+            C_row_offsets[i + 1] = num_nonzeros;
+        }
+    }
+};
+
+// per-thread linked list and dense accumulator used to form the rows of C
+template <typename IndexType, typename ValueType>
+struct spmm_csr_workspace
+{
+    std::vector<IndexType> next;
+    std::vector<ValueType> sums;
+
+    spmm_csr_workspace(const size_t num_cols)
+        : next(num_cols, IndexType(-1)), sums(num_cols, ValueType(0)) {}
+};
+
+template <typename MatrixType1, typename MatrixType2, typename MatrixType3,
+          typename UnaryFunction, typename BinaryFunction1, typename BinaryFunction2>
+struct spmm_csr_pass2_body
+{
+    typedef typename MatrixType3::index_type                         IndexType;
+    typedef typename MatrixType3::value_type                         ValueType;
+    typedef spmm_csr_workspace<IndexType,ValueType>                  WorkspaceType;
+    typedef ::tbb::enumerable_thread_specific<WorkspaceType>         WorkspacesType;
+
+    const MatrixType1& A;
+    const MatrixType2& B;
+    MatrixType3&       C;
+    WorkspacesType&    workspaces;
+    UnaryFunction      initialize;
+    BinaryFunction1    combine;
+    BinaryFunction2    reduce;
+
+    spmm_csr_pass2_body(const MatrixType1& A, const MatrixType2& B, MatrixType3& C, WorkspacesType& workspaces,
+                        UnaryFunction initialize, BinaryFunction1 combine, BinaryFunction2 reduce)
+        : A(A), B(B), C(C), workspaces(workspaces), initialize(initialize), combine(combine), reduce(reduce) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& rows) const
+    {
+        const IndexType unseen = static_cast<IndexType>(-1);
+        const IndexType init   = static_cast<IndexType>(-2);
+
+        WorkspaceType& workspace = workspaces.local();
+
+        std::vector<IndexType>& next = workspace.next;
+        std::vector<ValueType>& sums = workspace.sums;
+
+        for(size_t i = rows.begin(); i < rows.end(); i++)
+        {
+            IndexType head   = init;
+            IndexType length = 0;
+
+            for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = A.column_indices[jj];
+                const ValueType v = A.values[jj];
+
+                for(IndexType kk = B.row_offsets[j]; kk < B.row_offsets[j + 1]; kk++)
+                {
+                    const IndexType k = B.column_indices[kk];
+
+                    sums[k] = reduce(sums[k], combine(v, B.values[kk]));
+
+                    if(next[k] == unseen)
+                    {
+                        next[k] = head;
+                        head    = k;
+                        length++;
+                    }
+                }
+            }
+
+            IndexType offset = C.row_offsets[i];
+
+            for(IndexType jj = 0; jj < length; jj++)
+            {
+                C.column_indices[offset] = head;
+                C.values[offset]         = sums[head];
+                offset++;
+
+                IndexType temp = head;
+                head = next[head];
+
+                // clear arrays
+                next[temp] = unseen;
+                sums[temp] = ValueType(0);
+            }
+        }
+    }
+};
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(tbb::execution_policy<DerivedPolicy>& exec,
+              const MatrixType1& A,
+              const MatrixType2& B,
+              MatrixType3& C,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::csr_format,
+              cusp::csr_format)
+{
+    typedef typename MatrixType3::index_type IndexType;
+    typedef typename MatrixType3::value_type ValueType;
+
+    typedef typename MatrixType3::row_offsets_array_type                       RowOffsetsType;
+    typedef ::tbb::enumerable_thread_specific< std::vector<IndexType> >         MaskType;
+    typedef ::tbb::enumerable_thread_specific< spmm_csr_workspace<IndexType,ValueType> > WorkspacesType;
+
+    C.resize(A.num_rows, B.num_cols, 0);
+
+    C.row_offsets[0] = 0;
+
+    // count the entries of each row of C
+    {
+        MaskType masks(std::vector<IndexType>(B.num_cols, IndexType(-1)));
+
+        spmm_csr_pass1_body<MatrixType1,MatrixType2,RowOffsetsType> body(A, B, C.row_offsets, masks);
+
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, A.num_rows), body, ::tbb::auto_partitioner());
+    }
+
+    thrust::inclusive_scan(exec, C.row_offsets.begin(), C.row_offsets.end(), C.row_offsets.begin());
+
+    const size_t num_nonzeros = C.row_offsets[A.num_rows];
+
+    // resize output
+    C.resize(A.num_rows, B.num_cols, num_nonzeros);
+
+    // compute the entries of C
+    {
+        WorkspacesType workspaces(spmm_csr_workspace<IndexType,ValueType>(B.num_cols));
+
+        spmm_csr_pass2_body<MatrixType1,MatrixType2,MatrixType3,UnaryFunction,BinaryFunction1,BinaryFunction2>
+            body(A, B, C, workspaces, initialize, combine, reduce);
+
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, A.num_rows), body, ::tbb::auto_partitioner());
+    }
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
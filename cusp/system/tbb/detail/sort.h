@@ -17,6 +17,264 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/exception.h>
 
-// this system inherits transpose
-#include <cusp/system/cpp/detail/sort.h>
+#include <cusp/system/tbb/detail/execution_policy.h>
+#include <cusp/system/detail/generic/radix_sort.h>
+
+#include <thrust/fill.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// count the key digits of each block into its own row of the histogram
+template <typename ArrayType, typename CountsType>
+struct counting_sort_histogram_body
+{
+    const ArrayType& keys;
+    CountsType&      counts;
+    const size_t     num_bins;
+    const size_t     block_size;
+    const size_t     min;
+    const size_t     shift;
+    const size_t     mask;
+
+    counting_sort_histogram_body(const ArrayType& keys, CountsType& counts, const size_t num_bins, const size_t block_size,
+                                 const size_t min, const size_t shift, const size_t mask)
+        : keys(keys), counts(counts), num_bins(num_bins), block_size(block_size), min(min), shift(shift), mask(mask) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& blocks) const
+    {
+        for(size_t b = blocks.begin(); b < blocks.end(); b++)
+        {
+            const size_t base  = b * num_bins;
+            const size_t start = b * block_size;
+            const size_t end   = std::min(start + block_size, size_t(keys.size()));
+
+            for(size_t i = start; i < end; i++)
+                counts[base + (((size_t(keys[i]) - min) >> shift) & mask)]++;
+        }
+    }
+};
+
+// exclusive scan of each bin across the blocks, recording the bin totals
+template <typename CountsType, typename ArrayType>
+struct counting_sort_bin_scan_body
+{
+    CountsType&  counts;
+    ArrayType&   totals;
+    const size_t num_bins;
+    const size_t num_blocks;
+
+    counting_sort_bin_scan_body(CountsType& counts, ArrayType& totals, const size_t num_bins, const size_t num_blocks)
+        : counts(counts), totals(totals), num_bins(num_bins), num_blocks(num_blocks) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& bins) const
+    {
+        for(size_t bin = bins.begin(); bin < bins.end(); bin++)
+        {
+            size_t running = 0;
+
+            for(size_t b = 0; b < num_blocks; b++)
+            {
+                const size_t count = counts[b * num_bins + bin];
+                counts[b * num_bins + bin] = running;
+                running += count;
+            }
+
+            totals[bin + 1] = running;
+        }
+    }
+};
+
+// assign each key its position in the output stably sorted by digit
+template <typename ArrayType1, typename CountsType, typename ArrayType2, typename ArrayType3>
+struct counting_sort_rank_body
+{
+    const ArrayType1& keys;
+    CountsType&       counts;
+    const ArrayType2& offsets;
+    ArrayType3&       ranks;
+    const size_t      num_bins;
+    const size_t      block_size;
+    const size_t      min;
+    const size_t      shift;
+    const size_t      mask;
+
+    counting_sort_rank_body(const ArrayType1& keys, CountsType& counts, const ArrayType2& offsets, ArrayType3& ranks,
+                            const size_t num_bins, const size_t block_size, const size_t min, const size_t shift,
+                            const size_t mask)
+        : keys(keys), counts(counts), offsets(offsets), ranks(ranks), num_bins(num_bins), block_size(block_size),
+          min(min), shift(shift), mask(mask) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& blocks) const
+    {
+        for(size_t b = blocks.begin(); b < blocks.end(); b++)
+        {
+            const size_t base  = b * num_bins;
+            const size_t start = b * block_size;
+            const size_t end   = std::min(start + block_size, size_t(keys.size()));
+
+            for(size_t i = start; i < end; i++)
+            {
+                const size_t digit = ((size_t(keys[i]) - min) >> shift) & mask;
+                ranks[i] = offsets[digit] + counts[base + digit]++;
+            }
+        }
+    }
+};
+
+// Computes the position of each key after a stable sort by the digit
+// ((key - min) >> shift) & mask in [0, num_bins) and the starting offset of each
+// bin. The keys are split into blocks that are histogrammed independently,
+// so the work is parallel over both the keys and the bins while matching
+// the output of the sequential counting sort exactly.
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void counting_sort_ranks(tbb::execution_policy<DerivedPolicy>& exec,
+                         const ArrayType1& keys,
+                         const size_t num_bins,
+                         const size_t min,
+                         const size_t shift,
+                         const size_t mask,
+                         ArrayType2& ranks,
+                         ArrayType3& offsets)
+{
+    typedef typename ArrayType3::value_type OffsetType;
+
+    const size_t num_keys = keys.size();
+
+    thrust::fill(exec, offsets.begin(), offsets.end(), OffsetType(0));
+
+    if(num_keys == 0)
+        return;
+
+    // limit the histogram storage to roughly the size of the keys
+    const size_t max_blocks = 64;
+    const size_t min_block  = 1024;
+    const size_t num_blocks = std::max(size_t(1), std::min(max_blocks, std::min(num_keys / min_block, num_keys / std::max(num_bins, size_t(1)))));
+    const size_t block_size = (num_keys + num_blocks - 1) / num_blocks;
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> counts(exec, num_blocks * num_bins, size_t(0));
+
+    counting_sort_histogram_body<ArrayType1, cusp::detail::temporary_array<size_t, DerivedPolicy> >
+        histogram(keys, counts, num_bins, block_size, min, shift, mask);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_blocks), histogram, ::tbb::auto_partitioner());
+
+    counting_sort_bin_scan_body<cusp::detail::temporary_array<size_t, DerivedPolicy>, ArrayType3>
+        bin_scan(counts, offsets, num_bins, num_blocks);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_bins), bin_scan, ::tbb::auto_partitioner());
+
+    thrust::inclusive_scan(exec, offsets.begin(), offsets.end(), offsets.begin());
+
+    counting_sort_rank_body<ArrayType1, cusp::detail::temporary_array<size_t, DerivedPolicy>, ArrayType3, ArrayType2>
+        rank(keys, counts, offsets, ranks, num_bins, block_size, min, shift, mask);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_blocks), rank, ::tbb::auto_partitioner());
+}
+
+// ranks of keys in [0, num_bins) sorted by their full value
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void counting_sort_ranks(tbb::execution_policy<DerivedPolicy>& exec,
+                         const ArrayType1& keys,
+                         const size_t num_bins,
+                         ArrayType2& ranks,
+                         ArrayType3& offsets)
+{
+    counting_sort_ranks(exec, keys, num_bins, 0, 0, ~size_t(0), ranks, offsets);
+}
+
+// parallel histogram and scatter steps of the shared radix sort drivers
+template <typename DerivedPolicy>
+struct radix_pass
+{
+    tbb::execution_policy<DerivedPolicy>& exec;
+
+    // bin offsets of the widest digit, reused by every pass
+    cusp::detail::temporary_array<size_t, DerivedPolicy> offsets;
+
+    radix_pass(tbb::execution_policy<DerivedPolicy>& exec)
+        : exec(exec),
+          offsets(exec, (size_t(1) << cusp::system::detail::generic::radix_sort_max_digit_bits) + 1) {}
+
+    // ranks of the keys stably sorted by the digit_bits wide digit at shift
+    // of their offset key - min
+    template <typename ArrayType1, typename ArrayType2>
+    void ranks(const ArrayType1& keys, const size_t min, const size_t shift, const size_t digit_bits, ArrayType2& ranks)
+    {
+        const size_t num_bins = size_t(1) << digit_bits;
+
+        counting_sort_ranks(exec, keys, num_bins, min, shift, num_bins - 1, ranks, offsets);
+    }
+
+    template <typename ArrayType1, typename ArrayType2, typename ArrayType3>
+    void scatter(const ArrayType1& input, const ArrayType2& ranks, ArrayType3& output)
+    {
+        thrust::scatter(exec, input.begin(), input.end(), ranks.begin(), output.begin());
+    }
+};
+
+template <typename DerivedPolicy, typename ArrayType>
+void counting_sort(tbb::execution_policy<DerivedPolicy>& exec,
+                   ArrayType& keys,
+                   typename ArrayType::value_type min,
+                   typename ArrayType::value_type max)
+{
+    radix_pass<DerivedPolicy> radix(exec);
+
+    cusp::system::detail::generic::radix_counting_sort(exec, radix, keys, min, max);
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2>
+void counting_sort_by_key(tbb::execution_policy<DerivedPolicy>& exec,
+                          ArrayType1& keys, ArrayType2& vals,
+                          typename ArrayType1::value_type min,
+                          typename ArrayType1::value_type max)
+{
+    radix_pass<DerivedPolicy> radix(exec);
+
+    cusp::system::detail::generic::radix_counting_sort_by_key(exec, radix, keys, vals, min, max);
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void sort_by_row(tbb::execution_policy<DerivedPolicy>& exec,
+                 ArrayType1& row_indices, ArrayType2& column_indices, ArrayType3& values,
+                 typename ArrayType1::value_type min_row,
+                 typename ArrayType1::value_type max_row)
+{
+    radix_pass<DerivedPolicy> radix(exec);
+
+    cusp::system::detail::generic::radix_sort_by_row(exec, radix, row_indices, column_indices, values,
+                                                     min_row, max_row);
+}
+
+template <typename DerivedPolicy, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void sort_by_row_and_column(tbb::execution_policy<DerivedPolicy>& exec,
+                            ArrayType1& row_indices, ArrayType2& column_indices, ArrayType3& values,
+                            typename ArrayType1::value_type min_row,
+                            typename ArrayType1::value_type max_row,
+                            typename ArrayType2::value_type min_col,
+                            typename ArrayType2::value_type max_col)
+{
+    radix_pass<DerivedPolicy> radix(exec);
+
+    cusp::system::detail::generic::radix_sort_by_row_and_column(exec, radix, row_indices, column_indices, values,
+                                                                min_row, max_row, min_col, max_col);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
@@ -17,6 +17,96 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/tbb/detail/execution_policy.h>
+#include <cusp/system/tbb/detail/sort.h>
+
+#include <thrust/scatter.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 // this system inherits transpose
 #include <cusp/system/cpp/detail/transpose.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template <typename MatrixType1, typename MatrixType2, typename ArrayType>
+struct csr_transpose_body
+{
+    const MatrixType1& A;
+    MatrixType2&       At;
+    const ArrayType&   ranks;
+
+    csr_transpose_body(const MatrixType1& A, MatrixType2& At, const ArrayType& ranks)
+        : A(A), At(At), ranks(ranks) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& rows) const
+    {
+        typedef typename MatrixType1::index_type IndexType;
+
+        for(size_t row = rows.begin(); row < rows.end(); row++)
+        {
+            for(IndexType jj = A.row_offsets[row]; jj < A.row_offsets[row + 1]; jj++)
+            {
+                const size_t j = ranks[jj];
+
+                At.column_indices[j] = row;
+                At.values[j]         = A.values[jj];
+            }
+        }
+    }
+};
+
+// COO format
+template <typename DerivedPolicy, typename MatrixType1, typename MatrixType2>
+void transpose(tbb::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A, MatrixType2& At,
+               cusp::coo_format, cusp::coo_format)
+{
+    typedef typename MatrixType2::index_type IndexType;
+
+    At.resize(A.num_cols, A.num_rows, A.num_entries);
+
+    cusp::detail::temporary_array<size_t,    DerivedPolicy> ranks(exec, A.num_entries);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> offsets(exec, A.num_cols + 1);
+
+    // stable destination of each entry, grouped by column
+    counting_sort_ranks(exec, A.column_indices, A.num_cols, ranks, offsets);
+
+    thrust::scatter(exec, A.column_indices.begin(), A.column_indices.end(), ranks.begin(), At.row_indices.begin());
+    thrust::scatter(exec, A.row_indices.begin(),    A.row_indices.end(),    ranks.begin(), At.column_indices.begin());
+    thrust::scatter(exec, A.values.begin(),         A.values.end(),         ranks.begin(), At.values.begin());
+}
+
+// CSR format
+template <typename DerivedPolicy, typename MatrixType1, typename MatrixType2>
+void transpose(tbb::execution_policy<DerivedPolicy>& exec,
+               const MatrixType1& A, MatrixType2& At,
+               cusp::csr_format, cusp::csr_format)
+{
+    At.resize(A.num_cols, A.num_rows, A.num_entries);
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> ranks(exec, A.num_entries);
+
+    // the column offsets of A are the row offsets of At
+    counting_sort_ranks(exec, A.column_indices, A.num_cols, ranks, At.row_offsets);
+
+    csr_transpose_body<MatrixType1, MatrixType2, cusp::detail::temporary_array<size_t, DerivedPolicy> > body(A, At, ranks);
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, A.num_rows), body, ::tbb::auto_partitioner());
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
@@ -1,4 +1,5 @@
 #include <cusp/csr_matrix.h>
+#include <cusp/format_utils.h>
 #include <cusp/permutation_matrix.h>
 #include <cusp/print.h>
 
@@ -10,7 +11,7 @@
 #include "../timer.h"
 
 template<typename MatrixType>
-size_t bandwidth(const MatrixType& G)
+void report(const MatrixType& G)
 {
     typedef typename MatrixType::index_type IndexType;
     typedef typename MatrixType::value_type ValueType;
@@ -18,27 +19,8 @@ size_t bandwidth(const MatrixType& G)
 
     cusp::coo_matrix<IndexType,ValueType,MemorySpace> G_coo(G);
 
-    cusp::array1d<IndexType, MemorySpace> min_column(G.num_rows, 0);
-    cusp::array1d<IndexType, MemorySpace> max_column(G.num_rows, 0);
-    cusp::array1d<IndexType, MemorySpace> rowwise_bandwidth(G.num_rows, 0);
-
-    thrust::reduce_by_key(G_coo.row_indices.begin(),
-                          G_coo.row_indices.end(),
-                          G_coo.column_indices.begin(),
-                          thrust::make_discard_iterator(),
-                          min_column.begin(),
-                          thrust::equal_to<IndexType>(),
-                          thrust::minimum<IndexType>());
-    thrust::reduce_by_key(G_coo.row_indices.begin(),
-                          G_coo.row_indices.end(),
-                          G_coo.column_indices.begin(),
-                          thrust::make_discard_iterator(),
-                          max_column.begin(),
-                          thrust::equal_to<IndexType>(),
-                          thrust::maximum<IndexType>());
-
-    thrust::transform(max_column.begin(), max_column.end(), min_column.begin(), rowwise_bandwidth.begin(), thrust::minus<IndexType>());
-    return *thrust::max_element(rowwise_bandwidth.begin(), rowwise_bandwidth.end()) + 1;
+    std::cout << "Bandwidth : " << cusp::compute_bandwidth(G_coo.row_indices, G_coo.column_indices)
+              << ", Profile : " << cusp::compute_profile(G_coo.row_indices, G_coo.column_indices) << std::endl;
 }
 
 template<typename MemorySpace, typename MatrixType>
@@ -56,7 +38,8 @@ void RCM(const MatrixType& G)
     std::cout << " RCM time : " << t.milliseconds_elapsed() << " (ms)." << std::endl;
 
     P.symmetric_permute(G_rcm);
-    std::cout << " Bandwidth after RCM : " << bandwidth(G_rcm) << std::endl;
+    std::cout << " After RCM ";
+    report(G_rcm);
 }
 
 int main(int argc, char*argv[])
@@ -86,7 +69,8 @@ int main(int argc, char*argv[])
     std::cout << "with shape ("  << A.num_rows << "," << A.num_cols << ") and "
               << A.num_entries << " entries" << "\n\n";
 
-    std::cout << "Bandwidth before RCM : " << bandwidth(A) << std::endl;
+    std::cout << "Before RCM ";
+    report(A);
 
     std::cout << " Device ";
     RCM<cusp::device_memory>(A);
@@ -0,0 +1,139 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/block_cg.h>
+#include <cusp/krylov/cg.h>
+
+#include <vector>
+
+template <class LinearOperator,
+          class Array2d1,
+          class Array2d2,
+          class Monitors,
+          class Preconditioner>
+void block_cg(my_system& system,
+              const LinearOperator& A,
+                    Array2d1& X,
+              const Array2d2& B,
+                    Monitors& monitors,
+                    Preconditioner& M)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestBlockConjugateGradientDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array2d<float, cusp::device_memory> X(A.num_rows, 2, 0.0f);
+    std::vector< cusp::monitor<float> > monitors(2, cusp::monitor<float>(X.column(0), 20, 1e-4));
+    cusp::identity_operator<float,cusp::device_memory> M(A.num_rows, A.num_cols);
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::krylov::block_cg(sys, A, X, X, monitors, M);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestBlockConjugateGradientDispatch);
+
+template <class MemorySpace>
+void TestBlockConjugateGradient(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    // column 0 is zero and column 3 gets too few iterations, so both are
+    // deflated before the others
+    cusp::array2d<float, cusp::host_memory> B_host(A.num_rows, 5, 0.0f);
+
+    for (size_t i = 0; i < A.num_rows; i++)
+    {
+        B_host(i, 1) = 1.0f;
+        B_host(i, 2) = (i % 7) + 1.0f;
+        B_host(i, 3) = 1.0f;
+        B_host(i, 4) = i < A.num_rows / 2 ? 1.0f : -1.0f;
+    }
+
+    cusp::array2d<float, MemorySpace> B(B_host);
+    cusp::array2d<float, MemorySpace> X(A.num_rows, 5, 0.0f);
+
+    std::vector< cusp::monitor<float> > monitors;
+
+    for (size_t j = 0; j < B.num_cols; j++)
+        monitors.push_back(cusp::monitor<float>(B.column(j), j == 3 ? 3 : 100, 1e-5));
+
+    cusp::krylov::block_cg(A, X, B, monitors);
+
+    // check residual norm of every column
+    cusp::array2d<float, MemorySpace> AX(A.num_rows, 5, 0.0f);
+    cusp::multiply(A, X, AX);
+
+    for (size_t j = 0; j < B.num_cols; j++)
+    {
+        cusp::array1d<float, MemorySpace> b(B.column(j));
+        cusp::array1d<float, MemorySpace> residual(AX.column(j));
+        cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+        if (j == 3)
+        {
+            ASSERT_EQUAL(monitors[j].converged(),       false);
+            ASSERT_EQUAL(monitors[j].iteration_count(),     3);
+        }
+        else
+        {
+            ASSERT_EQUAL(monitors[j].converged(), true);
+            ASSERT_EQUAL(cusp::blas::nrm2(residual) <= 1e-4 * cusp::blas::nrm2(b), true);
+        }
+    }
+
+    ASSERT_EQUAL(monitors[0].iteration_count(), 0);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockConjugateGradient)
+
+template <class MemorySpace>
+void TestBlockConjugateGradientMatchesCG(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 8, 6);
+
+    cusp::array2d<double, MemorySpace> B(A.num_rows, 3, 1.0);
+    cusp::array2d<double, MemorySpace> X(A.num_rows, 3, 0.0);
+
+    B(5, 1) = 4.0;
+    B(9, 2) = -3.0;
+
+    std::vector< cusp::monitor<double> > monitors;
+
+    for (size_t j = 0; j < B.num_cols; j++)
+        monitors.push_back(cusp::monitor<double>(B.column(j), 100, 1e-10));
+
+    cusp::krylov::block_cg(A, X, B, monitors);
+
+    // every column follows the recurrences of cg
+    for (size_t j = 0; j < B.num_cols; j++)
+    {
+        cusp::array1d<double, MemorySpace> b(B.column(j));
+        cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+        cusp::array1d<double, MemorySpace> x_block(X.column(j));
+
+        cusp::monitor<double> monitor(b, 100, 1e-10);
+        cusp::krylov::cg(A, x, b, monitor);
+
+        ASSERT_EQUAL(monitors[j].iteration_count(), monitor.iteration_count());
+        ASSERT_ALMOST_EQUAL(x_block, x);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockConjugateGradientMatchesCG)
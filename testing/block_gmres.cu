@@ -0,0 +1,110 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/block_gmres.h>
+
+#include <vector>
+
+template <class LinearOperator,
+          class Array2d1,
+          class Array2d2,
+          class Monitors,
+          class Preconditioner>
+void block_gmres(my_system& system,
+                 const LinearOperator& A,
+                       Array2d1& X,
+                 const Array2d2& B,
+                 const size_t restart,
+                       Monitors& monitors,
+                       Preconditioner& M)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestBlockGmresDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array2d<float, cusp::device_memory> X(A.num_rows, 2, 0.0f);
+    std::vector< cusp::monitor<float> > monitors(2, cusp::monitor<float>(X.column(0), 20, 1e-4));
+    cusp::identity_operator<float,cusp::device_memory> M(A.num_rows, A.num_cols);
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::krylov::block_gmres(sys, A, X, X, 10, monitors, M);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestBlockGmresDispatch);
+
+template <class MemorySpace>
+void TestBlockGmres(void)
+{
+    // nonsymmetric operator, the Poisson matrix with a weaker coupling to
+    // the next unknown
+    cusp::csr_matrix<int, float, cusp::host_memory> A_host;
+    cusp::gallery::poisson5pt(A_host, 10, 10);
+
+    for (size_t i = 0; i < A_host.num_rows; i++)
+        for (int jj = A_host.row_offsets[i]; jj < A_host.row_offsets[i + 1]; jj++)
+            if (size_t(A_host.column_indices[jj]) == i + 1)
+                A_host.values[jj] = -0.5f;
+
+    cusp::csr_matrix<int, float, MemorySpace> A(A_host);
+
+    // column 0 is zero and column 2 gets too few iterations, so both are
+    // deflated before the others
+    cusp::array2d<float, cusp::host_memory> B_host(A.num_rows, 4, 0.0f);
+
+    for (size_t i = 0; i < A.num_rows; i++)
+    {
+        B_host(i, 1) = 1.0f;
+        B_host(i, 2) = 1.0f;
+        B_host(i, 3) = (i % 5) - 2.0f;
+    }
+
+    cusp::array2d<float, MemorySpace> B(B_host);
+    cusp::array2d<float, MemorySpace> X(A.num_rows, 4, 0.0f);
+
+    std::vector< cusp::monitor<float> > monitors;
+
+    for (size_t j = 0; j < B.num_cols; j++)
+        monitors.push_back(cusp::monitor<float>(B.column(j), j == 2 ? 4 : 200, 1e-5));
+
+    cusp::krylov::block_gmres(A, X, B, 20, monitors);
+
+    // check residual norm of every column
+    cusp::array2d<float, MemorySpace> AX(A.num_rows, 4, 0.0f);
+    cusp::multiply(A, X, AX);
+
+    for (size_t j = 0; j < B.num_cols; j++)
+    {
+        cusp::array1d<float, MemorySpace> b(B.column(j));
+        cusp::array1d<float, MemorySpace> residual(AX.column(j));
+        cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+        if (j == 2)
+        {
+            ASSERT_EQUAL(monitors[j].converged(),       false);
+            ASSERT_EQUAL(monitors[j].iteration_count(),     4);
+        }
+        else
+        {
+            ASSERT_EQUAL(monitors[j].converged(), true);
+            ASSERT_EQUAL(cusp::blas::nrm2(residual) <= 1e-4 * cusp::blas::nrm2(b), true);
+        }
+    }
+
+    ASSERT_EQUAL(monitors[0].iteration_count(), 0);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockGmres)
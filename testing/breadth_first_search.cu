@@ -160,6 +160,41 @@ void TestBreadthFirstSearch(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestBreadthFirstSearch)
 
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+void TestBreadthFirstSearchParallel(void)
+{
+    // the frontier of a 100x100 grid grows large enough to switch to
+    // bottom-up steps from a corner and from the center
+    cusp::csr_matrix<int,float,cusp::host_memory> G;
+    cusp::gallery::poisson5pt(G, 100, 100);
+
+    int sources[2] = {0, 5050};
+
+    for(int i = 0; i < 2; i++)
+    {
+        cusp::array1d<int,cusp::host_memory> levels(G.num_rows);
+        cusp::array1d<int,cusp::host_memory> reference_levels(G.num_rows);
+
+        cusp::graph::breadth_first_search(thrust::omp::par, G, sources[i], levels, true);
+        cusp::graph::breadth_first_search(thrust::cpp::par, G, sources[i], reference_levels, true);
+
+        ASSERT_EQUAL(levels, reference_levels);
+
+        cusp::array1d<int,cusp::host_memory> tree(G.num_rows);
+        cusp::array1d<int,cusp::host_memory> reference_tree(G.num_rows);
+
+        cusp::graph::breadth_first_search(thrust::omp::par, G, sources[i], tree, false);
+        cusp::graph::breadth_first_search(thrust::cpp::par, G, sources[i], reference_tree, false);
+
+        // a vertex may have several parents in the previous level, so the
+        // parallel tree is checked against the sequential levels instead
+        ASSERT_EQUAL(tree[sources[i]], reference_tree[sources[i]]);
+        ASSERT_EQUAL(is_valid_level_set(G, tree, reference_levels), true);
+    }
+}
+DECLARE_UNITTEST(TestBreadthFirstSearchParallel);
+#endif
+
 template <typename MatrixType, typename ArrayType>
 void breadth_first_search(my_system& system,
                           const MatrixType& G,
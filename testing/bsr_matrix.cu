@@ -0,0 +1,353 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/bsr_matrix.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/gallery/random.h>
+
+#include <cusp/io/matrix_market.h>
+
+#include <stdio.h>
+
+template <typename MatrixType>
+void InitializeBsrMatrix(MatrixType& matrix)
+{
+    // initialize (4,4) matrix with 10 nonzeros stored in three 2x2 blocks
+    //    [10 20 50  0]
+    //    [30 40 60  0]
+    //    [ 0  0 70 80]
+    //    [ 0  0 90 99]
+    matrix.resize(4, 4, 10, 3, 2);
+
+    matrix.row_offsets[0] = 0;
+    matrix.row_offsets[1] = 2;
+    matrix.row_offsets[2] = 3;
+
+    matrix.column_indices[0] = 0;
+    matrix.column_indices[1] = 1;
+    matrix.column_indices[2] = 1;
+
+    matrix.values[ 0] = 10; matrix.values[ 1] = 20; matrix.values[ 2] = 30; matrix.values[ 3] = 40;
+    matrix.values[ 4] = 50; matrix.values[ 5] =  0; matrix.values[ 6] = 60; matrix.values[ 7] =  0;
+    matrix.values[ 8] = 70; matrix.values[ 9] = 80; matrix.values[10] = 90; matrix.values[11] = 99;
+}
+
+template <typename ValueType>
+void InitializeBsrDense(cusp::array2d<ValueType, cusp::host_memory>& dense)
+{
+    dense.resize(4, 4);
+
+    dense(0,0) = 10; dense(0,1) = 20; dense(0,2) = 50; dense(0,3) =  0;
+    dense(1,0) = 30; dense(1,1) = 40; dense(1,2) = 60; dense(1,3) =  0;
+    dense(2,0) =  0; dense(2,1) =  0; dense(2,2) = 70; dense(2,3) = 80;
+    dense(3,0) =  0; dense(3,1) =  0; dense(3,2) = 90; dense(3,3) = 99;
+}
+
+template <class Space>
+void TestBsrMatrixBasicConstructor(void)
+{
+    cusp::bsr_matrix<int, float, Space> matrix(6, 4, 20, 3, 2);
+
+    ASSERT_EQUAL(matrix.num_rows,              6);
+    ASSERT_EQUAL(matrix.num_cols,              4);
+    ASSERT_EQUAL(matrix.num_entries,           20);
+    ASSERT_EQUAL(matrix.block_size,            2);
+    ASSERT_EQUAL(matrix.row_offsets.size(),    4);
+    ASSERT_EQUAL(matrix.column_indices.size(), 3);
+    ASSERT_EQUAL(matrix.values.size(),         12);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixBasicConstructor);
+
+template <class Space>
+void TestBsrMatrixCopyConstructor(void)
+{
+    cusp::bsr_matrix<int, float, Space> matrix;
+    InitializeBsrMatrix(matrix);
+
+    cusp::bsr_matrix<int, float, Space> copy_of_matrix(matrix);
+
+    ASSERT_EQUAL(copy_of_matrix.num_rows,              4);
+    ASSERT_EQUAL(copy_of_matrix.num_cols,              4);
+    ASSERT_EQUAL(copy_of_matrix.num_entries,           10);
+    ASSERT_EQUAL(copy_of_matrix.block_size,            2);
+    ASSERT_EQUAL(copy_of_matrix.row_offsets,    matrix.row_offsets);
+    ASSERT_EQUAL(copy_of_matrix.column_indices, matrix.column_indices);
+    ASSERT_EQUAL(copy_of_matrix.values,         matrix.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixCopyConstructor);
+
+template <class Space>
+void TestBsrMatrixResize(void)
+{
+    cusp::bsr_matrix<int, float, Space> matrix;
+
+    matrix.resize(9, 6, 30, 4, 3);
+
+    ASSERT_EQUAL(matrix.num_rows,              9);
+    ASSERT_EQUAL(matrix.num_cols,              6);
+    ASSERT_EQUAL(matrix.num_entries,           30);
+    ASSERT_EQUAL(matrix.block_size,            3);
+    ASSERT_EQUAL(matrix.row_offsets.size(),    4);
+    ASSERT_EQUAL(matrix.column_indices.size(), 4);
+    ASSERT_EQUAL(matrix.values.size(),         36);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixResize);
+
+template <class Space>
+void TestBsrMatrixSwap(void)
+{
+    cusp::bsr_matrix<int, float, Space> A(2, 2, 4, 1, 2);
+    cusp::bsr_matrix<int, float, Space> B(3, 3, 2, 2, 1);
+
+    A.row_offsets[0] = 0;  A.row_offsets[1] = 1;
+    A.column_indices[0] = 0;
+    A.values[0] = 1; A.values[1] = 2; A.values[2] = 3; A.values[3] = 4;
+
+    B.row_offsets[0] = 0;  B.row_offsets[1] = 1;  B.row_offsets[2] = 1;  B.row_offsets[3] = 2;
+    B.column_indices[0] = 1; B.column_indices[1] = 2;
+    B.values[0] = 5; B.values[1] = 6;
+
+    cusp::bsr_matrix<int, float, Space> A_copy(A);
+    cusp::bsr_matrix<int, float, Space> B_copy(B);
+
+    A.swap(B);
+
+    ASSERT_EQUAL(A.num_rows,       B_copy.num_rows);
+    ASSERT_EQUAL(A.num_cols,       B_copy.num_cols);
+    ASSERT_EQUAL(A.num_entries,    B_copy.num_entries);
+    ASSERT_EQUAL(A.block_size,     B_copy.block_size);
+    ASSERT_EQUAL(A.row_offsets,    B_copy.row_offsets);
+    ASSERT_EQUAL(A.column_indices, B_copy.column_indices);
+    ASSERT_EQUAL(A.values,         B_copy.values);
+
+    ASSERT_EQUAL(B.num_rows,       A_copy.num_rows);
+    ASSERT_EQUAL(B.num_cols,       A_copy.num_cols);
+    ASSERT_EQUAL(B.num_entries,    A_copy.num_entries);
+    ASSERT_EQUAL(B.block_size,     A_copy.block_size);
+    ASSERT_EQUAL(B.row_offsets,    A_copy.row_offsets);
+    ASSERT_EQUAL(B.column_indices, A_copy.column_indices);
+    ASSERT_EQUAL(B.values,         A_copy.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixSwap);
+
+template <class Space>
+void TestBsrMatrixView(void)
+{
+    typedef cusp::bsr_matrix<int, float, Space> Matrix;
+    typedef typename Matrix::view                View;
+
+    Matrix M;
+    InitializeBsrMatrix(M);
+
+    View V = cusp::make_bsr_matrix_view(M);
+
+    ASSERT_EQUAL(V.num_rows,    4);
+    ASSERT_EQUAL(V.num_cols,    4);
+    ASSERT_EQUAL(V.num_entries, 10);
+    ASSERT_EQUAL(V.block_size,  2);
+
+    V.values[0] = -1;
+
+    ASSERT_EQUAL(M.values[0], -1);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixView);
+
+template <class Space>
+void TestBsrMatrixConvertFromDense(void)
+{
+    cusp::array2d<float, cusp::host_memory> dense;
+    InitializeBsrDense(dense);
+
+    cusp::bsr_matrix<int, float, Space> A(dense, 2);
+
+    cusp::bsr_matrix<int, float, cusp::host_memory> B;
+    InitializeBsrMatrix(B);
+
+    ASSERT_EQUAL(A.num_rows,       B.num_rows);
+    ASSERT_EQUAL(A.num_cols,       B.num_cols);
+    ASSERT_EQUAL(A.num_entries,    B.num_entries);
+    ASSERT_EQUAL(A.block_size,     B.block_size);
+    ASSERT_EQUAL(A.row_offsets,    B.row_offsets);
+    ASSERT_EQUAL(A.column_indices, B.column_indices);
+    ASSERT_EQUAL(A.values,         B.values);
+
+    // default block size is one
+    cusp::bsr_matrix<int, float, Space> C(dense);
+
+    ASSERT_EQUAL(C.block_size,            1);
+    ASSERT_EQUAL(C.num_entries,           10);
+    ASSERT_EQUAL(C.column_indices.size(), 10);
+
+    // convert back to dense
+    cusp::array2d<float, cusp::host_memory> dense_A(A);
+    cusp::array2d<float, cusp::host_memory> dense_C(C);
+
+    ASSERT_EQUAL(dense_A == dense, true);
+    ASSERT_EQUAL(dense_C == dense, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixConvertFromDense);
+
+template <class Space>
+void TestBsrMatrixConvertCsr(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    cusp::gallery::poisson5pt(A, 6, 6);
+
+    for (size_t block_size = 1; block_size <= 12; block_size++)
+    {
+        if (A.num_rows % block_size != 0) continue;
+
+        cusp::bsr_matrix<int, float, Space> B(A, block_size);
+
+        ASSERT_EQUAL(B.block_size,  block_size);
+        ASSERT_EQUAL(B.num_entries, A.num_entries);
+
+        cusp::csr_matrix<int, float, Space> C(B);
+
+        ASSERT_EQUAL(C.num_entries,    A.num_entries);
+        ASSERT_EQUAL(C.row_offsets,    A.row_offsets);
+        ASSERT_EQUAL(C.column_indices, A.column_indices);
+        ASSERT_EQUAL(C.values,         A.values);
+
+        cusp::coo_matrix<int, float, Space> D(B);
+        cusp::coo_matrix<int, float, Space> E(A);
+
+        ASSERT_EQUAL(D.row_indices,    E.row_indices);
+        ASSERT_EQUAL(D.column_indices, E.column_indices);
+        ASSERT_EQUAL(D.values,         E.values);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixConvertCsr);
+
+template <class Space>
+void TestBsrMatrixConvertIncompatibleBlockSize(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    cusp::gallery::poisson5pt(A, 5, 5);
+
+    cusp::bsr_matrix<int, float, Space> B;
+    B.block_size = 2;
+
+    ASSERT_THROWS(cusp::convert(A, B), cusp::format_conversion_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixConvertIncompatibleBlockSize);
+
+template <class Space>
+void TestBsrMatrixMultiply(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    cusp::gallery::poisson5pt(A, 6, 6);
+
+    cusp::array1d<float, Space> x(A.num_cols);
+    for (size_t i = 0; i < x.size(); i++)
+        x[i] = float(i % 7) - 3;
+
+    cusp::array1d<float, Space> y_ref(A.num_rows, 0);
+    cusp::multiply(A, x, y_ref);
+
+    // exercises the fixed size kernels and the runtime block size path
+    for (size_t block_size = 1; block_size <= 12; block_size++)
+    {
+        if (A.num_rows % block_size != 0) continue;
+
+        cusp::bsr_matrix<int, float, Space> B(A, block_size);
+
+        cusp::array1d<float, Space> y(A.num_rows, 10);
+        cusp::multiply(B, x, y);
+
+        ASSERT_EQUAL(y, y_ref);
+
+        typename cusp::bsr_matrix<int, float, Space>::view B_view(B);
+
+        cusp::array1d<float, Space> y_view(A.num_rows, 10);
+        cusp::multiply(B_view, x, y_view);
+
+        ASSERT_EQUAL(y_view, y_ref);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixMultiply);
+
+template <class Space>
+void TestBsrMatrixMultiplyRandom(void)
+{
+    cusp::coo_matrix<int, float, Space> A;
+    cusp::gallery::random(A, 120, 120, 900);
+
+    cusp::array1d<float, Space> x(A.num_cols);
+    for (size_t i = 0; i < x.size(); i++)
+        x[i] = float((3 * i) % 11) - 5;
+
+    cusp::array1d<float, Space> y_ref(A.num_rows, 0);
+    cusp::multiply(A, x, y_ref);
+
+    size_t block_sizes[] = {2, 3, 4, 5, 6, 8, 10};
+
+    for (size_t n = 0; n < sizeof(block_sizes) / sizeof(size_t); n++)
+    {
+        cusp::bsr_matrix<int, float, Space> B(A, block_sizes[n]);
+
+        cusp::array1d<float, Space> y(A.num_rows, 0);
+        cusp::multiply(B, x, y);
+
+        ASSERT_ALMOST_EQUAL(y, y_ref);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixMultiplyRandom);
+
+template <class Space>
+void TestBsrMatrixMultiplyArray2d(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    cusp::gallery::poisson5pt(A, 4, 6);
+
+    // 11 columns cover the tiles of width 8, 2 and 1
+    cusp::array2d<float, Space> X(A.num_cols, 11);
+    for (size_t i = 0; i < X.num_rows; i++)
+        for (size_t j = 0; j < X.num_cols; j++)
+            X(i,j) = float((i + 2 * j) % 5) - 2;
+
+    cusp::array2d<float, Space> Y_ref(A.num_rows, 11, 0);
+    cusp::multiply(A, X, Y_ref);
+
+    size_t block_sizes[] = {2, 3, 4, 12};
+
+    for (size_t n = 0; n < sizeof(block_sizes) / sizeof(size_t); n++)
+    {
+        cusp::bsr_matrix<int, float, Space> B(A, block_sizes[n]);
+
+        cusp::array2d<float, Space> Y(A.num_rows, 11, 0);
+        cusp::multiply(B, X, Y);
+
+        ASSERT_EQUAL(Y.values, Y_ref.values);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBsrMatrixMultiplyArray2d);
+
+void TestBsrMatrixReadWriteMatrixMarket(void)
+{
+    const char random_file_name[] = "test_82741093746101.mtx";
+
+    cusp::bsr_matrix<int, float, cusp::host_memory> A;
+    InitializeBsrMatrix(A);
+
+    cusp::io::write_matrix_market_file(A, random_file_name);
+
+    cusp::bsr_matrix<int, float, cusp::host_memory> B;
+    B.block_size = 2;
+    cusp::io::read_matrix_market_file(B, random_file_name);
+
+    remove(random_file_name);
+
+    ASSERT_EQUAL(B.num_rows,       A.num_rows);
+    ASSERT_EQUAL(B.num_cols,       A.num_cols);
+    ASSERT_EQUAL(B.num_entries,    A.num_entries);
+    ASSERT_EQUAL(B.block_size,     A.block_size);
+    ASSERT_EQUAL(B.row_offsets,    A.row_offsets);
+    ASSERT_EQUAL(B.column_indices, A.column_indices);
+    ASSERT_EQUAL(B.values,         A.values);
+}
+DECLARE_UNITTEST(TestBsrMatrixReadWriteMatrixMarket);
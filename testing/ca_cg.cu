@@ -0,0 +1,81 @@
+#include <unittest/unittest.h>
+
+#include <cusp/csr_matrix.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/ca_cg.h>
+#include <cusp/precond/diagonal.h>
+
+template <class LinearOperator,
+          class VectorType1,
+          class VectorType2,
+          class Monitor,
+          class Preconditioner>
+void ca_cg(my_system& system,
+           const LinearOperator& A,
+                 VectorType1& x,
+           const VectorType2& b,
+           const size_t s,
+           const cusp::krylov::s_step_basis basis,
+                 Monitor& monitor,
+                 Preconditioner& M)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestCommunicationAvoidingConjugateGradientDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0.0f);
+    cusp::monitor<float> monitor(x, 20, 1e-4);
+    cusp::identity_operator<float,cusp::device_memory> M(A.num_rows, A.num_cols);
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::krylov::ca_cg(sys, A, x, x, 4, cusp::krylov::newton_basis, monitor, M);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestCommunicationAvoidingConjugateGradientDispatch);
+
+template <class MemorySpace>
+void TestCommunicationAvoidingConjugateGradient(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 12, 8);
+
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1.0);
+
+    cusp::precond::diagonal<double, MemorySpace> M(A);
+
+    const cusp::krylov::s_step_basis bases[3] = {cusp::krylov::monomial_basis,
+                                                 cusp::krylov::newton_basis,
+                                                 cusp::krylov::chebyshev_basis};
+
+    for (int i = 0; i < 3; i++)
+    {
+        cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+
+        cusp::monitor<double> monitor(b, 100, 1e-8);
+
+        cusp::krylov::ca_cg(A, x, b, 4, bases[i], monitor, M);
+
+        // check residual norm
+        cusp::array1d<double, MemorySpace> residual(A.num_rows, 0.0);
+        cusp::multiply(A, x, residual);
+        cusp::blas::axpby(residual, b, residual, -1.0, 1.0);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-7 * cusp::blas::nrm2(b), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestCommunicationAvoidingConjugateGradient)
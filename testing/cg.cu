@@ -98,3 +98,33 @@ void TestConjugateGradientZeroResidual(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestConjugateGradientZeroResidual)
 
+
+template <class MemorySpace>
+void TestConjugateGradientSolver(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    cusp::array1d<float, MemorySpace> x0(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> x1(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+
+    cusp::monitor<float> monitor0(b, 20, 1e-4);
+    cusp::krylov::cg(A, x0, b, monitor0);
+
+    cusp::krylov::cg_solver<float, MemorySpace> solver(A);
+
+    // repeated solves reuse the workspace and match cg
+    for (int i = 0; i < 2; i++)
+    {
+        cusp::blas::fill(x1, 0.0f);
+        cusp::monitor<float> monitor1(b, 20, 1e-4);
+
+        solver.solve(A, x1, b, monitor1);
+
+        ASSERT_EQUAL(monitor1.iteration_count(), monitor0.iteration_count());
+        ASSERT_ALMOST_EQUAL(x1, x0);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestConjugateGradientSolver)
@@ -2,8 +2,47 @@
 
 #include <cusp/graph/connected_components.h>
 
+#include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 
+template <class MemorySpace>
+void TestConnectedComponents(void)
+{
+    // ten disjoint paths of ten vertices each, stored symmetrically
+    const int num_paths   = 10;
+    const int path_length = 10;
+    const int N           = num_paths * path_length;
+
+    cusp::coo_matrix<int, float, cusp::host_memory> A(N, N, 2 * num_paths * (path_length - 1));
+
+    int n = 0;
+    for(int i = 0; i < N; i++)
+    {
+        if(i > 0 && i % path_length != 0)
+        {
+            A.row_indices[n] = i; A.column_indices[n] = i - 1; A.values[n] = 1; n++;
+        }
+        if(i % path_length != path_length - 1)
+        {
+            A.row_indices[n] = i; A.column_indices[n] = i + 1; A.values[n] = 1; n++;
+        }
+    }
+
+    cusp::csr_matrix<int, float, MemorySpace> G(A);
+    cusp::array1d<int, MemorySpace> components(N);
+
+    size_t num_components = cusp::graph::connected_components(G, components);
+
+    ASSERT_EQUAL(num_components, size_t(num_paths));
+
+    cusp::array1d<int, cusp::host_memory> h_components(components);
+
+    for(int i = 0; i < N; i++)
+        for(int j = 0; j < N; j++)
+            ASSERT_EQUAL(h_components[i] == h_components[j], i / path_length == j / path_length);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestConnectedComponents);
+
 template <typename MatrixType, typename ArrayType>
 size_t connected_components(my_system& system,
                             const MatrixType& G,
@@ -74,6 +74,24 @@ void TestIndicesToOffsets(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestIndicesToOffsets);
 
+
+template <class Space>
+void TestComputeBandwidthAndProfile(void)
+{
+    cusp::coo_matrix<int, float, Space> A(4, 4, 7);
+    A.row_indices[0] = 0; A.column_indices[0] = 0;
+    A.row_indices[1] = 0; A.column_indices[1] = 2;
+    A.row_indices[2] = 1; A.column_indices[2] = 1;
+    A.row_indices[3] = 2; A.column_indices[3] = 0;
+    A.row_indices[4] = 2; A.column_indices[4] = 2;
+    A.row_indices[5] = 3; A.column_indices[5] = 1;
+    A.row_indices[6] = 3; A.column_indices[6] = 3;
+
+    ASSERT_EQUAL(cusp::compute_bandwidth(A.row_indices, A.column_indices), size_t(2));
+    ASSERT_EQUAL(cusp::compute_profile(A.row_indices, A.column_indices), size_t(4));
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestComputeBandwidthAndProfile);
+
 template <class Matrix>
 void TestExtractDiagonal(void)
 {
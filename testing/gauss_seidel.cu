@@ -8,6 +8,7 @@
 #include <cusp/dia_matrix.h>
 #include <cusp/ell_matrix.h>
 #include <cusp/hyb_matrix.h>
+#include <cusp/gallery/poisson.h>
 
 template <typename Space>
 void TestGaussSeidelRelaxation(void)
@@ -96,3 +97,57 @@ void TestGaussSeidelRelaxationSweeps(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestGaussSeidelRelaxationSweeps);
 
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+void TestGaussSeidelRelaxationParallel(void)
+{
+    typedef cusp::csr_matrix<int,float,cusp::host_memory>   HostMatrix;
+    typedef cusp::csr_matrix<int,float,cusp::device_memory> DeviceMatrix;
+
+    HostMatrix A;
+    cusp::gallery::poisson5pt(A, 100, 100);
+
+    DeviceMatrix A_d(A);
+
+    // color on the OpenMP system and share the ordering with the host
+    cusp::relaxation::gauss_seidel<float, cusp::device_memory> relax_d(A_d);
+    cusp::relaxation::gauss_seidel<float, cusp::host_memory>   relax(relax_d);
+
+    ASSERT_EQUAL(relax.color_offsets[0], 0);
+    ASSERT_EQUAL(relax.color_offsets[relax.color_offsets.size() - 1], A.num_rows);
+
+    // rows of one color must not be coupled
+    cusp::array1d<int, cusp::host_memory> row_colors(A.num_rows);
+
+    for(size_t c = 0; c + 1 < relax.color_offsets.size(); c++)
+        for(int n = relax.color_offsets[c]; n < relax.color_offsets[c + 1]; n++)
+            row_colors[relax.ordering[n]] = c;
+
+    for(int i = 0; i < A.num_rows; i++)
+        for(int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            if(A.column_indices[jj] != i)
+                ASSERT_EQUAL(row_colors[A.column_indices[jj]] != row_colors[i], true);
+
+    cusp::array1d<float, cusp::host_memory>   b = unittest::random_samples<float>(A.num_rows);
+    cusp::array1d<float, cusp::device_memory> b_d(b);
+
+    cusp::relaxation::sweep sweeps[3] = {cusp::relaxation::FORWARD,
+                                         cusp::relaxation::BACKWARD,
+                                         cusp::relaxation::SYMMETRIC};
+
+    // one sweep of each direction, the device one under thrust::omp::par
+    for(int i = 0; i < 3; i++)
+    {
+        cusp::array1d<float, cusp::host_memory>   x(A.num_rows, 1.0f);
+        cusp::array1d<float, cusp::device_memory> x_d(A.num_rows, 1.0f);
+
+        relax(A, b, x, sweeps[i]);
+        relax_d(A_d, b_d, x_d, sweeps[i]);
+
+        cusp::array1d<float, cusp::host_memory> result(x_d);
+
+        ASSERT_ALMOST_EQUAL(result, x);
+    }
+}
+DECLARE_UNITTEST(TestGaussSeidelRelaxationParallel);
+#endif
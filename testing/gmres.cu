@@ -60,3 +60,62 @@ void TestGeneralizedMinRes(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedMinRes);
 
+
+template <class MemorySpace>
+void TestGeneralizedMinResSolver(void)
+{
+    size_t restart = 20;
+
+    cusp::csr_matrix<int, float, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    cusp::array1d<float, MemorySpace> x0(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> x1(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+
+    cusp::monitor<float> monitor0(b, 20, 1e-4);
+    cusp::krylov::gmres(A, x0, b, restart, monitor0);
+
+    cusp::krylov::gmres_solver<float, MemorySpace> solver(A, restart);
+
+    // repeated solves reuse the workspace and match gmres
+    for (int i = 0; i < 2; i++)
+    {
+        cusp::blas::fill(x1, 0.0f);
+        cusp::monitor<float> monitor1(b, 20, 1e-4);
+
+        solver.solve(A, x1, b, monitor1);
+
+        ASSERT_EQUAL(monitor1.iteration_count(), monitor0.iteration_count());
+        ASSERT_ALMOST_EQUAL(x1, x0);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedMinResSolver);
+
+template <class MemorySpace>
+void TestGeneralizedMinResSolverDefault(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    cusp::array1d<float, MemorySpace> x0(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> x1(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+
+    cusp::monitor<float> monitor0(b, 20, 1e-4);
+    cusp::krylov::gmres(A, x0, b, 50, monitor0);
+
+    // the first solve allocates the workspace with the default restart
+    cusp::krylov::gmres_solver<float, MemorySpace> solver;
+
+    cusp::monitor<float> monitor1(b, 20, 1e-4);
+    solver.solve(A, x1, b, monitor1);
+
+    ASSERT_EQUAL(monitor1.iteration_count(), monitor0.iteration_count());
+    ASSERT_ALMOST_EQUAL(x1, x0);
+
+    ASSERT_THROWS(solver.setup(A, 0), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGeneralizedMinResSolverDefault);
@@ -3,6 +3,9 @@
 #include <cusp/graph/hilbert_curve.h>
 
 #include <cusp/array2d.h>
+#include <cusp/permutation_matrix.h>
+
+#include <cstdlib>
 
 template <typename Array2dType, typename ArrayType>
 void hilbert_curve(my_system& system, const Array2dType& coord, const size_t num_parts, ArrayType& parts)
@@ -27,3 +30,71 @@ void TestHilbertCurveDispatch()
 }
 DECLARE_UNITTEST(TestHilbertCurveDispatch);
 
+template <typename Array2dType, typename PermutationType>
+void hilbert_curve_permutation(my_system& system, const Array2dType& coord, PermutationType& P)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestHilbertCurvePermutationDispatch()
+{
+    // initialize testing variables
+    cusp::array2d<float, cusp::device_memory> coords;
+    cusp::permutation_matrix<int, cusp::device_memory> P;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::hilbert_curve_permutation(sys, coords, P);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestHilbertCurvePermutationDispatch);
+
+
+template <class MemorySpace>
+void TestHilbertCurvePermutation(void)
+{
+    // cell centers of a 16x16 lattice
+    const int N = 16;
+
+    cusp::array2d<float, cusp::host_memory> h_coords(N * N, 2);
+    for(int j = 0; j < N; j++)
+    {
+        for(int i = 0; i < N; i++)
+        {
+            h_coords(j * N + i, 0) = (i + 0.5f) / N;
+            h_coords(j * N + i, 1) = (j + 0.5f) / N;
+        }
+    }
+
+    cusp::array2d<float, MemorySpace> coords(h_coords);
+    cusp::permutation_matrix<int, MemorySpace> P(N * N);
+
+    cusp::graph::hilbert_curve_permutation(coords, P);
+
+    cusp::array1d<int, cusp::host_memory> positions(P.permutation);
+    cusp::array1d<int, cusp::host_memory> order(N * N, -1);
+    for(int n = 0; n < N * N; n++)
+        order[positions[n]] = n;
+
+    // consecutive points along the curve are neighboring lattice cells
+    for(int n = 1; n < N * N; n++)
+    {
+        const int a = order[n - 1];
+        const int b = order[n];
+
+        ASSERT_EQUAL(std::abs(a % N - b % N) + std::abs(a / N - b / N), 1);
+    }
+
+    // partitions are contiguous pieces of the curve
+    cusp::array1d<int, MemorySpace> parts(N * N);
+    cusp::graph::hilbert_curve(coords, 4, parts);
+
+    cusp::array1d<int, cusp::host_memory> h_parts(parts);
+    for(int n = 0; n < N * N; n++)
+        ASSERT_EQUAL(h_parts[order[n]], n / (N * N / 4));
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestHilbertCurvePermutation);
@@ -0,0 +1,75 @@
+#include <unittest/unittest.h>
+
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/iterative_refinement.h>
+
+template <class InnerValueType,
+          class LinearOperator,
+          class VectorType1,
+          class VectorType2,
+          class Monitor>
+void iterative_refinement(my_system& system,
+                          const LinearOperator& A,
+                                VectorType1& x,
+                          const VectorType2& b,
+                                Monitor& monitor,
+                          const size_t restart,
+                          const bool use_smoothed_aggregation)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestIterativeRefinementDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, double, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array1d<double, cusp::device_memory> x(A.num_rows, 0.0);
+    cusp::monitor<double> monitor(x, 20, 1e-4);
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::krylov::iterative_refinement<float>(sys, A, x, x, monitor, 0, false);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestIterativeRefinementDispatch);
+
+template <class MemorySpace>
+void TestIterativeRefinement(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 20, 20);
+
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1.0);
+
+    // inner CG, inner GMRES(20) and inner CG with smoothed aggregation
+    const size_t restart[3]          = {0, 20, 0};
+    const bool   use_aggregation[3]  = {false, false, true};
+
+    for (int i = 0; i < 3; i++)
+    {
+        cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+
+        cusp::monitor<double> monitor(b, 20, 1e-12);
+
+        cusp::krylov::iterative_refinement<float>(A, x, b, monitor, restart[i], use_aggregation[i]);
+
+        // check residual norm, which is below what float alone can reach
+        cusp::array1d<double, MemorySpace> residual(A.num_rows, 0.0);
+        cusp::multiply(A, x, residual);
+        cusp::blas::axpby(residual, b, residual, -1.0, 1.0);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-12 * cusp::blas::nrm2(b), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestIterativeRefinement)
@@ -181,3 +181,47 @@ void TestMaximalIndependentSet(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestMaximalIndependentSet);
 
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+template <typename ExecutionPolicy>
+void _TestMaximalIndependentSetParallel(ExecutionPolicy& exec, const size_t k)
+{
+    cusp::coo_matrix<int,float,cusp::host_memory> G_coo;
+    cusp::gallery::poisson5pt(G_coo, 105, 107);
+    thrust::fill(G_coo.values.begin(), G_coo.values.end(), 1.0f);
+
+    cusp::csr_matrix<int,float,cusp::host_memory> G_csr(G_coo);
+
+    // the COO format selects the generic randomized MIS on the sequential system
+    cusp::array1d<int,cusp::host_memory> reference;
+    size_t reference_nodes = cusp::graph::maximal_independent_set(thrust::cpp::par, G_coo, reference, k);
+
+    {
+        cusp::array1d<int,cusp::host_memory> stencil;
+        size_t num_nodes = cusp::graph::maximal_independent_set(exec, G_csr, stencil, k);
+
+        ASSERT_EQUAL(num_nodes, reference_nodes);
+        ASSERT_EQUAL(stencil, reference);
+    }
+
+    {
+        cusp::array1d<int,cusp::host_memory> stencil;
+        size_t num_nodes = cusp::graph::maximal_independent_set(exec, G_coo, stencil, k);
+
+        ASSERT_EQUAL(num_nodes, reference_nodes);
+        ASSERT_EQUAL(stencil, reference);
+    }
+}
+
+void TestMaximalIndependentSetParallel(void)
+{
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+    _TestMaximalIndependentSetParallel(thrust::omp::par, 1);
+    _TestMaximalIndependentSetParallel(thrust::omp::par, 2);
+#else
+    _TestMaximalIndependentSetParallel(thrust::tbb::par, 1);
+    _TestMaximalIndependentSetParallel(thrust::tbb::par, 2);
+#endif
+}
+DECLARE_UNITTEST(TestMaximalIndependentSetParallel);
+#endif
@@ -67,3 +67,28 @@ void TestMonitorSimple(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestMonitorSimple);
 
+
+template <typename MemorySpace>
+void TestMonitorFinishedNorm(void)
+{
+    cusp::array1d<float,MemorySpace> b(2);
+    b[0] = 10;
+    b[1] =  0;
+
+    cusp::monitor<float> monitor(b, 2, 0.5, 1.0);
+
+    ASSERT_EQUAL(monitor.finished_norm(10.0f), false);
+    ASSERT_EQUAL(monitor.residual_norm(), 10.0);
+
+    ASSERT_EQUAL(monitor.finished_norm(2.0f), true);
+    ASSERT_EQUAL(monitor.converged(), true);
+    ASSERT_EQUAL(monitor.residual_norm(), 2.0);
+
+    ++monitor;
+    ++monitor;
+
+    ASSERT_EQUAL(monitor.finished_norm(7.0f), true);
+    ASSERT_EQUAL(monitor.converged(), false);
+    ASSERT_EQUAL(monitor.residual_norm(), 7.0);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMonitorFinishedNorm);
@@ -127,6 +127,119 @@ void TestSparseMatrixMatrixMultiply(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixMatrixMultiply);
 
+template <typename SparseMatrixType, typename DenseMatrixType>
+void CompareSpgemmSymbolicNumeric(DenseMatrixType A, DenseMatrixType B)
+{
+    typedef typename SparseMatrixType::value_type ValueType;
+
+    SparseMatrixType _A(A), _B(B), _C;
+    cusp::spgemm_symbolic(_A, _B, _C);
+
+    // the values of A change while its structure and the structure of C stay fixed
+    for(int step = 0; step < 3; step++)
+    {
+        cusp::blas::scal(_A.values, ValueType(2));
+
+        cusp::spgemm_numeric(_A, _B, _C);
+
+        DenseMatrixType C;
+        cusp::multiply(DenseMatrixType(_A), B, C);
+
+        ASSERT_EQUAL(C == DenseMatrixType(_C), true);
+    }
+}
+
+template <class MemorySpace>
+void TestSpgemmSymbolicNumeric(void)
+{
+    typedef cusp::array2d<float,cusp::host_memory> DenseMatrix;
+
+    DenseMatrix A;
+    cusp::gallery::random(A, 24, 24, 50);
+
+    DenseMatrix B;
+    cusp::gallery::poisson5pt(B, 4, 6);
+
+    CompareSpgemmSymbolicNumeric< cusp::csr_matrix<int,float,MemorySpace> >(A, B);
+    CompareSpgemmSymbolicNumeric< cusp::coo_matrix<int,float,MemorySpace> >(A, B);
+
+    // entries that cancel numerically are part of the pattern
+    DenseMatrix C(1, 2);
+    C(0,0) =  1.0;
+    C(0,1) =  1.0;
+
+    DenseMatrix D(2, 1);
+    D(0,0) =  1.0;
+    D(1,0) = -1.0;
+
+    cusp::csr_matrix<int,float,MemorySpace> _C(C), _D(D), _E;
+    cusp::spgemm_symbolic(_C, _D, _E);
+    cusp::spgemm_numeric(_C, _D, _E);
+
+    ASSERT_EQUAL(_E.num_entries, 1);
+    ASSERT_EQUAL(_E.values[0], 0.0f);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSpgemmSymbolicNumeric);
+
+template <typename SparseMatrixType, typename DenseMatrixType>
+void CompareMaskedSpgemm(DenseMatrixType A, DenseMatrixType B, DenseMatrixType M)
+{
+    DenseMatrixType C;
+    cusp::multiply(A, B, C);
+
+    // keep the entries of the product that lie on the pattern of M
+    for(size_t i = 0; i < C.num_rows; i++)
+        for(size_t j = 0; j < C.num_cols; j++)
+            if(M(i,j) == 0)
+                C(i,j) = 0;
+
+    SparseMatrixType _A(A), _B(B), _M(M), _C;
+    cusp::masked_spgemm(_A, _B, _M, _C);
+
+    ASSERT_EQUAL(C == DenseMatrixType(_C), true);
+}
+
+template <class MemorySpace>
+void TestMaskedSpgemm(void)
+{
+    typedef cusp::array2d<float,cusp::host_memory> DenseMatrix;
+
+    DenseMatrix A;
+    cusp::gallery::random(A, 24, 24, 50);
+
+    DenseMatrix B;
+    cusp::gallery::poisson5pt(B, 4, 6);
+
+    DenseMatrix M;
+    cusp::gallery::random(M, 24, 24, 80);
+
+    CompareMaskedSpgemm< cusp::csr_matrix<int,float,MemorySpace> >(A, B, M);
+    CompareMaskedSpgemm< cusp::coo_matrix<int,float,MemorySpace> >(A, B, M);
+
+    // entries of the mask without products are dropped, the values of the
+    // mask are passed to initialize
+    DenseMatrix C(2, 2, 0);
+    C(0,0) = 2;
+
+    DenseMatrix D(2, 2, 0);
+    D(0,0) = 3;
+    D(0,1) = 4;
+
+    DenseMatrix N(2, 2, 1);
+
+    cusp::csr_matrix<int,float,MemorySpace> _C(C), _D(D), _N(N), _E;
+    cusp::masked_spgemm(_C, _D, _N, _E, thrust::identity<float>(), thrust::multiplies<float>(), thrust::plus<float>());
+
+    cusp::csr_matrix<int,float,cusp::host_memory> E(_E);
+
+    ASSERT_EQUAL(E.num_entries, 2);
+    ASSERT_EQUAL(E.column_indices[0], 0);
+    ASSERT_EQUAL(E.column_indices[1], 1);
+    ASSERT_EQUAL(E.values[0], 7.0f);
+    ASSERT_EQUAL(E.values[1], 9.0f);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMaskedSpgemm);
+
 template <typename SparseMatrixType, typename DenseMatrixType>
 void CompareScaledSparseMatrixMatrixMultiply(DenseMatrixType A, DenseMatrixType B)
 {
@@ -375,6 +488,50 @@ void TestSparseMatrixDenseMatrixMultiply(void)
 }
 /* DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixDenseMatrixMultiply); */
 
+template <typename MemorySpace, typename Orientation>
+void CompareCsrMatrixDenseMatrixMultiply(const cusp::csr_matrix<int, float, cusp::host_memory>& A, const size_t num_vectors)
+{
+    cusp::array2d<float, cusp::host_memory, Orientation> X(A.num_cols, num_vectors);
+    for(size_t i = 0; i < X.num_rows; i++)
+        for(size_t k = 0; k < X.num_cols; k++)
+            X(i,k) = float((3 * i + k) % 7) - 3;
+
+    // compute reference output one column at a time
+    cusp::array2d<float, cusp::host_memory, Orientation> Y_ref(A.num_rows, num_vectors);
+    for(size_t i = 0; i < A.num_rows; i++)
+    {
+        for(size_t k = 0; k < num_vectors; k++)
+        {
+            float sum = 0;
+            for(int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+                sum += A.values[jj] * X(A.column_indices[jj], k);
+            Y_ref(i,k) = sum;
+        }
+    }
+
+    cusp::csr_matrix<int, float, MemorySpace> _A(A);
+    cusp::array2d<float, MemorySpace, Orientation> _X(X);
+    cusp::array2d<float, MemorySpace, Orientation> _Y(A.num_rows, num_vectors, 10);
+
+    cusp::multiply(_A, _X, _Y);
+
+    ASSERT_EQUAL(Y_ref == cusp::array2d<float, cusp::host_memory, Orientation>(_Y), true);
+}
+
+void TestCsrMatrixDenseMatrixMultiply(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 7, 5);
+
+    // every combination of the 16, 8, 4, 2 and 1 wide column tiles
+    for(size_t num_vectors = 1; num_vectors < 20; num_vectors++)
+    {
+        CompareCsrMatrixDenseMatrixMultiply<cusp::host_memory, cusp::row_major>(A, num_vectors);
+        CompareCsrMatrixDenseMatrixMultiply<cusp::host_memory, cusp::column_major>(A, num_vectors);
+    }
+}
+DECLARE_UNITTEST(TestCsrMatrixDenseMatrixMultiply);
+
 
 /////////////////////////////////////////
 // Sparse Matrix-Vector Multiplication //
@@ -511,6 +668,88 @@ void TestSparseMatrixVectorMultiply()
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixVectorMultiply);
 
+template <class MemorySpace>
+void TestSparseMatrixVectorMultiplySkewedRows(void)
+{
+    // a few very long rows among many short and empty rows, so that
+    // load-balanced kernels must split rows between workers
+    cusp::csr_matrix<int, float, cusp::host_memory> A(200, 150, 0);
+
+    cusp::array1d<int,   cusp::host_memory> column_indices;
+    cusp::array1d<float, cusp::host_memory> values;
+
+    A.row_offsets[0] = 0;
+    for(size_t i = 0; i < A.num_rows; i++)
+    {
+        size_t row_length = (i % 67 == 3) ? 150 : (i % 3);
+
+        for(size_t j = 0; j < row_length; j++)
+        {
+            column_indices.push_back((i + 7 * j) % A.num_cols);
+            values.push_back(float((i + j) % 5) - 2);
+        }
+
+        A.row_offsets[i + 1] = column_indices.size();
+    }
+
+    A.resize(A.num_rows, A.num_cols, column_indices.size());
+    A.column_indices = column_indices;
+    A.values         = values;
+
+    cusp::array1d<float, cusp::host_memory> x(A.num_cols);
+    for(size_t i = 0; i < x.size(); i++)
+        x[i] = float(i % 9) - 4;
+
+    // compute reference output
+    cusp::array1d<float, cusp::host_memory> y_ref(A.num_rows, 10);
+    for(size_t i = 0; i < A.num_rows; i++)
+    {
+        float sum = 0;
+        for(int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            sum += A.values[jj] * x[A.column_indices[jj]];
+        y_ref[i] = sum;
+    }
+
+    cusp::array1d<float, MemorySpace> _x(x);
+
+    {
+        cusp::csr_matrix<int, float, MemorySpace> _A(A);
+        cusp::array1d<float, MemorySpace> _y(A.num_rows, 10);
+
+        cusp::multiply(_A, _x, _y);
+
+        ASSERT_EQUAL(_y, y_ref);
+    }
+
+    {
+        cusp::coo_matrix<int, float, MemorySpace> _A(A);
+        cusp::array1d<float, MemorySpace> _y(A.num_rows, 10);
+
+        cusp::multiply(_A, _x, _y);
+
+        ASSERT_EQUAL(_y, y_ref);
+    }
+
+    {
+        cusp::ell_matrix<int, float, MemorySpace> _A(A);
+        cusp::array1d<float, MemorySpace> _y(A.num_rows, 10);
+
+        cusp::multiply(_A, _x, _y);
+
+        ASSERT_EQUAL(_y, y_ref);
+    }
+
+    {
+        cusp::hyb_matrix<int, float, MemorySpace> _A(A);
+        cusp::array1d<float, MemorySpace> _y(A.num_rows, 10);
+
+        cusp::multiply(_A, _x, _y);
+
+        ASSERT_EQUAL(_y, y_ref);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSparseMatrixVectorMultiplySkewedRows);
+
 template <typename SparseMatrixType, typename DenseMatrixType>
 void CompareScaledSparseMatrixVectorMultiply(DenseMatrixType A)
 {
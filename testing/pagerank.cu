@@ -0,0 +1,107 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/pagerank.h>
+
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+
+#include <cusp/gallery/grid.h>
+
+template <class MemorySpace>
+void TestPagerank(void)
+{
+    // a directed cycle, every vertex has the same rank
+    {
+        const int N = 10;
+
+        cusp::coo_matrix<int, float, cusp::host_memory> A(N, N, N);
+
+        for(int i = 0; i < N; i++)
+        {
+            A.row_indices[i] = i; A.column_indices[i] = (i + 1) % N; A.values[i] = 1;
+        }
+
+        cusp::csr_matrix<int, float, MemorySpace> G(A);
+        cusp::array1d<float, MemorySpace> ranks(N);
+
+        cusp::graph::pagerank(G, ranks);
+
+        cusp::array1d<float, cusp::host_memory> h_ranks(ranks);
+
+        for(int i = 0; i < N; i++)
+            ASSERT_ALMOST_EQUAL(h_ranks[i], 1.0f / N);
+    }
+
+    // a vertex without outgoing edges and one without incoming edges
+    {
+        cusp::coo_matrix<int, float, cusp::host_memory> A(3, 3, 2);
+        A.row_indices[0] = 0; A.column_indices[0] = 1; A.values[0] = 1;
+        A.row_indices[1] = 1; A.column_indices[1] = 2; A.values[1] = 1;
+
+        cusp::csr_matrix<int, float, MemorySpace> G(A);
+        cusp::array1d<float, MemorySpace> ranks(3);
+
+        cusp::array1d<float, MemorySpace> uniform(3, 1.0f / 3);
+        cusp::monitor<float> monitor(uniform, 200, 1e-6);
+
+        cusp::graph::pagerank(G, ranks, monitor, 0.5);
+
+        cusp::array1d<float, cusp::host_memory> h_ranks(ranks);
+
+        // the stationary distribution is proportional to [4, 6, 7]
+        ASSERT_ALMOST_EQUAL(h_ranks[0],  4.0f / 17);
+        ASSERT_ALMOST_EQUAL(h_ranks[1],  6.0f / 17);
+        ASSERT_ALMOST_EQUAL(h_ranks[2],  7.0f / 17);
+    }
+
+    // a 2D grid, the ranks sum to one and follow the symmetry of the grid
+    {
+        cusp::csr_matrix<int, float, MemorySpace> G;
+        cusp::gallery::grid2d(G, 5, 5);
+
+        cusp::array1d<float, MemorySpace> ranks(G.num_rows);
+
+        cusp::graph::pagerank(G, ranks);
+
+        cusp::array1d<float, cusp::host_memory> h_ranks(ranks);
+
+        float sum = 0;
+        for(size_t i = 0; i < h_ranks.size(); i++)
+            sum += h_ranks[i];
+
+        ASSERT_ALMOST_EQUAL(sum, 1.0f);
+        ASSERT_ALMOST_EQUAL(h_ranks[0], h_ranks[24]);
+        ASSERT_ALMOST_EQUAL(h_ranks[4], h_ranks[20]);
+        ASSERT_EQUAL(h_ranks[12] > h_ranks[0], true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestPagerank);
+
+template <typename MatrixType, typename ArrayType, typename Monitor>
+void pagerank(my_system& system,
+              const MatrixType& G,
+              ArrayType& ranks,
+              Monitor& monitor,
+              const double damping)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestPagerankDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::array1d<float, cusp::device_memory> ranks;
+    cusp::monitor<float> monitor(ranks);
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::pagerank(sys, A, ranks, monitor, 0.85);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestPagerankDispatch);
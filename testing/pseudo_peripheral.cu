@@ -4,6 +4,10 @@
 
 #include <cusp/csr_matrix.h>
 
+#include <cusp/gallery/grid.h>
+
+#include <thrust/extrema.h>
+
 template <typename MatrixType>
 typename MatrixType::index_type
 pseudo_peripheral_vertex(my_system& system, const MatrixType& G)
@@ -27,3 +31,23 @@ void TestPseudoPeripheralDispatch()
 }
 DECLARE_UNITTEST(TestPseudoPeripheralDispatch);
 
+
+template <class MemorySpace>
+void TestPseudoPeripheral(void)
+{
+    // the farthest vertex from any vertex of a 6x4 grid is a unique corner,
+    // so every search ends at a corner of eccentricity 5 + 3
+    cusp::csr_matrix<int, float, MemorySpace> G;
+    cusp::gallery::grid2d(G, 6, 4);
+
+    cusp::array1d<int, MemorySpace> levels(G.num_rows);
+
+    int vertex = cusp::graph::pseudo_peripheral_vertex(G, levels);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> h_G(G);
+    cusp::array1d<int, cusp::host_memory> h_levels(levels);
+
+    ASSERT_EQUAL(h_G.row_offsets[vertex + 1] - h_G.row_offsets[vertex], 2);
+    ASSERT_EQUAL(*thrust::max_element(h_levels.begin(), h_levels.end()), 8);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestPseudoPeripheral);
@@ -0,0 +1,319 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+#include <cusp/sell_matrix.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/gallery/random.h>
+
+template <typename MatrixType>
+void InitializeSellMatrix(MatrixType& matrix)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType X = MatrixType::invalid_index;
+
+    // initialize (4,3) matrix with 6 nonzeros in two chunks of 2 rows
+    //    [10  0 20]
+    //    [ 0  0  0]
+    //    [ 0  0 30]
+    //    [40 50 60]
+    matrix.resize(4, 3, 6, 10, 2, 1);
+
+    matrix.chunk_offsets[0] = 0;
+    matrix.chunk_offsets[1] = 4;
+    matrix.chunk_offsets[2] = 10;
+
+    matrix.row_permutation[0] = 0;
+    matrix.row_permutation[1] = 1;
+    matrix.row_permutation[2] = 2;
+    matrix.row_permutation[3] = 3;
+
+    matrix.column_indices[0] = 0; matrix.values[0] = 10;
+    matrix.column_indices[1] = X; matrix.values[1] =  0;
+    matrix.column_indices[2] = 2; matrix.values[2] = 20;
+    matrix.column_indices[3] = X; matrix.values[3] =  0;
+    matrix.column_indices[4] = 2; matrix.values[4] = 30;
+    matrix.column_indices[5] = 0; matrix.values[5] = 40;
+    matrix.column_indices[6] = X; matrix.values[6] =  0;
+    matrix.column_indices[7] = 1; matrix.values[7] = 50;
+    matrix.column_indices[8] = X; matrix.values[8] =  0;
+    matrix.column_indices[9] = 2; matrix.values[9] = 60;
+}
+
+template <typename ValueType>
+void InitializeSellDense(cusp::array2d<ValueType, cusp::host_memory>& dense)
+{
+    dense.resize(4, 3);
+
+    dense(0,0) = 10; dense(0,1) =  0; dense(0,2) = 20;
+    dense(1,0) =  0; dense(1,1) =  0; dense(1,2) =  0;
+    dense(2,0) =  0; dense(2,1) =  0; dense(2,2) = 30;
+    dense(3,0) = 40; dense(3,1) = 50; dense(3,2) = 60;
+}
+
+template <class Space>
+void TestSellMatrixBasicConstructor(void)
+{
+    cusp::sell_matrix<int, float, Space> matrix(5, 4, 10, 24, 4, 8);
+
+    ASSERT_EQUAL(matrix.num_rows,               5);
+    ASSERT_EQUAL(matrix.num_cols,               4);
+    ASSERT_EQUAL(matrix.num_entries,            10);
+    ASSERT_EQUAL(matrix.chunk_size,             4);
+    ASSERT_EQUAL(matrix.sigma,                  8);
+    ASSERT_EQUAL(matrix.chunk_offsets.size(),   3);
+    ASSERT_EQUAL(matrix.row_permutation.size(), 5);
+    ASSERT_EQUAL(matrix.column_indices.size(),  24);
+    ASSERT_EQUAL(matrix.values.size(),          24);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixBasicConstructor);
+
+template <class Space>
+void TestSellMatrixCopyConstructor(void)
+{
+    cusp::sell_matrix<int, float, Space> matrix;
+    InitializeSellMatrix(matrix);
+
+    cusp::sell_matrix<int, float, Space> copy_of_matrix(matrix);
+
+    ASSERT_EQUAL(copy_of_matrix.num_rows,               4);
+    ASSERT_EQUAL(copy_of_matrix.num_cols,               3);
+    ASSERT_EQUAL(copy_of_matrix.num_entries,            6);
+    ASSERT_EQUAL(copy_of_matrix.chunk_size,             2);
+    ASSERT_EQUAL(copy_of_matrix.sigma,                  1);
+    ASSERT_EQUAL(copy_of_matrix.chunk_offsets,   matrix.chunk_offsets);
+    ASSERT_EQUAL(copy_of_matrix.row_permutation, matrix.row_permutation);
+    ASSERT_EQUAL(copy_of_matrix.column_indices,  matrix.column_indices);
+    ASSERT_EQUAL(copy_of_matrix.values,          matrix.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixCopyConstructor);
+
+template <class Space>
+void TestSellMatrixResize(void)
+{
+    cusp::sell_matrix<int, float, Space> matrix;
+
+    matrix.resize(9, 6, 30, 48, 8, 32);
+
+    ASSERT_EQUAL(matrix.num_rows,               9);
+    ASSERT_EQUAL(matrix.num_cols,               6);
+    ASSERT_EQUAL(matrix.num_entries,            30);
+    ASSERT_EQUAL(matrix.chunk_size,             8);
+    ASSERT_EQUAL(matrix.sigma,                  32);
+    ASSERT_EQUAL(matrix.chunk_offsets.size(),   3);
+    ASSERT_EQUAL(matrix.row_permutation.size(), 9);
+    ASSERT_EQUAL(matrix.column_indices.size(),  48);
+    ASSERT_EQUAL(matrix.values.size(),          48);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixResize);
+
+template <class Space>
+void TestSellMatrixSwap(void)
+{
+    cusp::sell_matrix<int, float, Space> A;
+    cusp::sell_matrix<int, float, Space> B(2, 2, 2, 2, 2, 1);
+
+    InitializeSellMatrix(A);
+
+    B.chunk_offsets[0] = 0;  B.chunk_offsets[1] = 2;
+    B.row_permutation[0] = 0;  B.row_permutation[1] = 1;
+    B.column_indices[0] = 1; B.column_indices[1] = 0;
+    B.values[0] = 5; B.values[1] = 6;
+
+    cusp::sell_matrix<int, float, Space> A_copy(A);
+    cusp::sell_matrix<int, float, Space> B_copy(B);
+
+    A.swap(B);
+
+    ASSERT_EQUAL(A.num_rows,        B_copy.num_rows);
+    ASSERT_EQUAL(A.num_cols,        B_copy.num_cols);
+    ASSERT_EQUAL(A.num_entries,     B_copy.num_entries);
+    ASSERT_EQUAL(A.chunk_size,      B_copy.chunk_size);
+    ASSERT_EQUAL(A.sigma,           B_copy.sigma);
+    ASSERT_EQUAL(A.chunk_offsets,   B_copy.chunk_offsets);
+    ASSERT_EQUAL(A.row_permutation, B_copy.row_permutation);
+    ASSERT_EQUAL(A.column_indices,  B_copy.column_indices);
+    ASSERT_EQUAL(A.values,          B_copy.values);
+
+    ASSERT_EQUAL(B.num_rows,        A_copy.num_rows);
+    ASSERT_EQUAL(B.num_cols,        A_copy.num_cols);
+    ASSERT_EQUAL(B.num_entries,     A_copy.num_entries);
+    ASSERT_EQUAL(B.chunk_size,      A_copy.chunk_size);
+    ASSERT_EQUAL(B.sigma,           A_copy.sigma);
+    ASSERT_EQUAL(B.chunk_offsets,   A_copy.chunk_offsets);
+    ASSERT_EQUAL(B.row_permutation, A_copy.row_permutation);
+    ASSERT_EQUAL(B.column_indices,  A_copy.column_indices);
+    ASSERT_EQUAL(B.values,          A_copy.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixSwap);
+
+template <class Space>
+void TestSellMatrixView(void)
+{
+    typedef cusp::sell_matrix<int, float, Space> Matrix;
+    typedef typename Matrix::view                 View;
+
+    Matrix M;
+    InitializeSellMatrix(M);
+
+    View V = cusp::make_sell_matrix_view(M);
+
+    ASSERT_EQUAL(V.num_rows,    4);
+    ASSERT_EQUAL(V.num_cols,    3);
+    ASSERT_EQUAL(V.num_entries, 6);
+    ASSERT_EQUAL(V.chunk_size,  2);
+    ASSERT_EQUAL(V.sigma,       1);
+
+    V.values[0] = -1;
+
+    ASSERT_EQUAL(M.values[0], -1);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixView);
+
+template <class Space>
+void TestSellMatrixConvertFromDense(void)
+{
+    cusp::array2d<float, cusp::host_memory> dense;
+    InitializeSellDense(dense);
+
+    cusp::sell_matrix<int, float, Space> A(dense, 2, 1);
+
+    cusp::sell_matrix<int, float, cusp::host_memory> B;
+    InitializeSellMatrix(B);
+
+    ASSERT_EQUAL(A.num_rows,        B.num_rows);
+    ASSERT_EQUAL(A.num_cols,        B.num_cols);
+    ASSERT_EQUAL(A.num_entries,     B.num_entries);
+    ASSERT_EQUAL(A.chunk_size,      B.chunk_size);
+    ASSERT_EQUAL(A.sigma,           B.sigma);
+    ASSERT_EQUAL(A.chunk_offsets,   B.chunk_offsets);
+    ASSERT_EQUAL(A.row_permutation, B.row_permutation);
+    ASSERT_EQUAL(A.column_indices,  B.column_indices);
+    ASSERT_EQUAL(A.values,          B.values);
+
+    // sorting all four rows by length packs the longest rows together
+    cusp::sell_matrix<int, float, Space> C(dense, 2, 4);
+
+    ASSERT_EQUAL(C.sigma,                 4);
+    ASSERT_EQUAL(C.column_indices.size(), 8);
+    ASSERT_EQUAL(C.chunk_offsets[1],      6);
+    ASSERT_EQUAL(C.chunk_offsets[2],      8);
+    ASSERT_EQUAL(C.row_permutation[0],    3);
+    ASSERT_EQUAL(C.row_permutation[1],    0);
+    ASSERT_EQUAL(C.row_permutation[2],    2);
+    ASSERT_EQUAL(C.row_permutation[3],    1);
+
+    // default chunk size is eight
+    cusp::sell_matrix<int, float, Space> D(dense);
+
+    ASSERT_EQUAL(D.chunk_size,            8);
+    ASSERT_EQUAL(D.sigma,                 1);
+    ASSERT_EQUAL(D.num_entries,           6);
+    ASSERT_EQUAL(D.column_indices.size(), 24);
+
+    // convert back to dense
+    cusp::array2d<float, cusp::host_memory> dense_A(A);
+    cusp::array2d<float, cusp::host_memory> dense_C(C);
+    cusp::array2d<float, cusp::host_memory> dense_D(D);
+
+    ASSERT_EQUAL(dense_A == dense, true);
+    ASSERT_EQUAL(dense_C == dense, true);
+    ASSERT_EQUAL(dense_D == dense, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixConvertFromDense);
+
+template <class Space>
+void TestSellMatrixConvertCsr(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    cusp::gallery::poisson5pt(A, 7, 5);
+
+    size_t chunk_sizes[] = {1, 3, 4, 8, 32};
+    size_t sigmas[]      = {1, 4, 64};
+
+    for (size_t n = 0; n < sizeof(chunk_sizes) / sizeof(size_t); n++)
+    {
+        for (size_t m = 0; m < sizeof(sigmas) / sizeof(size_t); m++)
+        {
+            cusp::sell_matrix<int, float, Space> B(A, chunk_sizes[n], sigmas[m]);
+
+            ASSERT_EQUAL(B.chunk_size,  chunk_sizes[n]);
+            ASSERT_EQUAL(B.sigma,       sigmas[m]);
+            ASSERT_EQUAL(B.num_entries, A.num_entries);
+
+            cusp::csr_matrix<int, float, Space> C(B);
+
+            ASSERT_EQUAL(C.num_entries,    A.num_entries);
+            ASSERT_EQUAL(C.row_offsets,    A.row_offsets);
+            ASSERT_EQUAL(C.column_indices, A.column_indices);
+            ASSERT_EQUAL(C.values,         A.values);
+        }
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixConvertCsr);
+
+template <class Space>
+void TestSellMatrixMultiply(void)
+{
+    cusp::coo_matrix<int, float, Space> A;
+    cusp::gallery::random(A, 123, 97, 900);
+
+    cusp::array1d<float, Space> x(A.num_cols);
+    for (size_t i = 0; i < x.size(); i++)
+        x[i] = float((3 * i) % 11) - 5;
+
+    cusp::array1d<float, Space> y_ref(A.num_rows, 0);
+    cusp::multiply(A, x, y_ref);
+
+    // exercises the fixed size kernels and the runtime chunk size path
+    size_t chunk_sizes[] = {1, 2, 3, 4, 8, 16, 32};
+    size_t sigmas[]      = {1, 32, 256};
+
+    for (size_t n = 0; n < sizeof(chunk_sizes) / sizeof(size_t); n++)
+    {
+        for (size_t m = 0; m < sizeof(sigmas) / sizeof(size_t); m++)
+        {
+            cusp::sell_matrix<int, float, Space> B(A, chunk_sizes[n], sigmas[m]);
+
+            cusp::array1d<float, Space> y(A.num_rows, 10);
+            cusp::multiply(B, x, y);
+
+            ASSERT_ALMOST_EQUAL(y, y_ref);
+
+            typename cusp::sell_matrix<int, float, Space>::view B_view(B);
+
+            cusp::array1d<float, Space> y_view(A.num_rows, 10);
+            cusp::multiply(B_view, x, y_view);
+
+            ASSERT_ALMOST_EQUAL(y_view, y_ref);
+        }
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixMultiply);
+
+template <class Space>
+void TestSellMatrixMultiplyArray2d(void)
+{
+    cusp::csr_matrix<int, float, Space> A;
+    cusp::gallery::poisson5pt(A, 4, 6);
+
+    cusp::array2d<float, Space> X(A.num_cols, 3);
+    for (size_t i = 0; i < X.num_rows; i++)
+        for (size_t j = 0; j < X.num_cols; j++)
+            X(i,j) = float((i + 2 * j) % 5) - 2;
+
+    cusp::array2d<float, Space> Y_ref(A.num_rows, 3, 0);
+    cusp::multiply(A, X, Y_ref);
+
+    cusp::sell_matrix<int, float, Space> B(A, 4, 16);
+
+    cusp::array2d<float, Space> Y(A.num_rows, 3, 0);
+    cusp::multiply(B, X, Y);
+
+    ASSERT_EQUAL(Y.values, Y_ref.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSellMatrixMultiplyArray2d);
@@ -0,0 +1,82 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/single_source_shortest_path.h>
+
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/grid.h>
+
+#include <limits>
+
+template <class MemorySpace>
+void TestSingleSourceShortestPath(void)
+{
+    // unit weights on a 2D grid give the Manhattan distance to the source
+    {
+        const int m = 7;
+        const int n = 5;
+
+        cusp::csr_matrix<int, float, MemorySpace> G;
+        cusp::gallery::grid2d(G, m, n);
+
+        cusp::array1d<float, MemorySpace> distances(G.num_rows);
+
+        cusp::graph::single_source_shortest_path(G, 0, distances);
+
+        cusp::array1d<float, cusp::host_memory> h_distances(distances);
+
+        for(int i = 0; i < m * n; i++)
+            ASSERT_EQUAL(h_distances[i], float(i % m + i / m));
+    }
+
+    // a weighted directed graph where the shortest path uses more edges
+    {
+        cusp::coo_matrix<int, float, cusp::host_memory> A(5, 5, 5);
+        A.row_indices[0] = 0; A.column_indices[0] = 1; A.values[0] = 1;
+        A.row_indices[1] = 0; A.column_indices[1] = 2; A.values[1] = 10;
+        A.row_indices[2] = 1; A.column_indices[2] = 3; A.values[2] = 2;
+        A.row_indices[3] = 2; A.column_indices[3] = 0; A.values[3] = 1;
+        A.row_indices[4] = 3; A.column_indices[4] = 2; A.values[4] = 3;
+
+        cusp::csr_matrix<int, float, MemorySpace> G(A);
+        cusp::array1d<float, MemorySpace> distances(5);
+
+        cusp::graph::single_source_shortest_path(G, 0, distances);
+
+        cusp::array1d<float, cusp::host_memory> h_distances(distances);
+
+        ASSERT_EQUAL(h_distances[0], 0.0f);
+        ASSERT_EQUAL(h_distances[1], 1.0f);
+        ASSERT_EQUAL(h_distances[2], 6.0f);
+        ASSERT_EQUAL(h_distances[3], 3.0f);
+        ASSERT_EQUAL(h_distances[4], std::numeric_limits<float>::max());
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSingleSourceShortestPath);
+
+template <typename MatrixType, typename ArrayType>
+void single_source_shortest_path(my_system& system,
+                                 const MatrixType& G,
+                                 const typename MatrixType::index_type src,
+                                 ArrayType& distances)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestSingleSourceShortestPathDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::array1d<float, cusp::device_memory> distances;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::single_source_shortest_path(sys, A, 0, distances);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestSingleSourceShortestPathDispatch);
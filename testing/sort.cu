@@ -2,6 +2,8 @@
 
 #include <cusp/sort.h>
 
+#include <thrust/sort.h>
+
 template <class Array>
 void InitializeSimpleKeySortTest(Array& unsorted_keys, Array& sorted_keys)
 {
@@ -106,3 +108,106 @@ void TestCountingSortByKey(void)
 }
 DECLARE_VECTOR_UNITTEST(TestCountingSortByKey);
 
+
+template <typename ArrayType>
+void TestSortByRowAndColumn(void)
+{
+    typedef typename ArrayType::template rebind<cusp::host_memory>::type HostArray;
+
+    // column indices spanning several radix digits
+    const int N = 1000;
+
+    HostArray unsorted_rows(N);
+    HostArray unsorted_cols(N);
+    HostArray unsorted_vals(N);
+
+    for(int i = 0; i < N; i++)
+    {
+        unsorted_rows[i] = (i * 13) % 37;
+        unsorted_cols[i] = ((i * 29) % N) * 31;
+        unsorted_vals[i] = i;
+    }
+
+    // entries are unique so the sorted order is fully determined
+    cusp::array1d<long, cusp::host_memory> sorted_keys(N);
+    HostArray sorted_vals(unsorted_vals);
+
+    for(int i = 0; i < N; i++)
+        sorted_keys[i] = long(unsorted_rows[i]) * 31 * N + unsorted_cols[i];
+
+    thrust::sort_by_key(sorted_keys.begin(), sorted_keys.end(), sorted_vals.begin());
+
+    ArrayType rows(unsorted_rows);
+    ArrayType cols(unsorted_cols);
+    ArrayType vals(unsorted_vals);
+
+    cusp::sort_by_row_and_column(rows, cols, vals);
+
+    ASSERT_EQUAL(vals, sorted_vals);
+
+    HostArray h_rows(rows);
+    HostArray h_cols(cols);
+
+    for(int i = 0; i < N; i++)
+    {
+        ASSERT_EQUAL(h_rows[i], unsorted_rows[sorted_vals[i]]);
+        ASSERT_EQUAL(h_cols[i], unsorted_cols[sorted_vals[i]]);
+    }
+}
+DECLARE_VECTOR_UNITTEST(TestSortByRowAndColumn);
+
+template <typename ArrayType>
+void TestSortByRowAndColumnOffsetRange(void)
+{
+    typedef typename ArrayType::template rebind<cusp::host_memory>::type HostArray;
+
+    // narrow key ranges far from zero
+    const int N = 1000;
+    const int min_row = 20000, max_row = min_row + 36;
+    const int min_col = 30000, max_col = min_col + 999;
+
+    HostArray unsorted_rows(N);
+    HostArray unsorted_cols(N);
+    HostArray unsorted_vals(N);
+
+    for(int i = 0; i < N; i++)
+    {
+        unsorted_rows[i] = min_row + (i * 13) % 37;
+        unsorted_cols[i] = min_col + (i * 29) % N;
+        unsorted_vals[i] = i;
+    }
+
+    cusp::array1d<long, cusp::host_memory> sorted_keys(N);
+    HostArray sorted_vals(unsorted_vals);
+
+    for(int i = 0; i < N; i++)
+        sorted_keys[i] = long(unsorted_rows[i] - min_row) * N + (unsorted_cols[i] - min_col);
+
+    thrust::sort_by_key(sorted_keys.begin(), sorted_keys.end(), sorted_vals.begin());
+
+    ArrayType rows(unsorted_rows);
+    ArrayType cols(unsorted_cols);
+    ArrayType vals(unsorted_vals);
+
+    cusp::sort_by_row_and_column(rows, cols, vals, min_row, max_row, min_col, max_col);
+
+    ASSERT_EQUAL(vals, sorted_vals);
+
+    // rows only, keeping the column order within each row
+    ArrayType keys(unsorted_rows);
+    ArrayType perm(unsorted_vals);
+
+    cusp::counting_sort_by_key(keys, perm, min_row, max_row);
+
+    HostArray h_keys(keys);
+    HostArray h_perm(perm);
+
+    for(int i = 1; i < N; i++)
+    {
+        ASSERT_EQUAL(h_keys[i - 1] <= h_keys[i], true);
+
+        if(h_keys[i - 1] == h_keys[i])
+            ASSERT_EQUAL(h_perm[i - 1] < h_perm[i], true);
+    }
+}
+DECLARE_VECTOR_UNITTEST(TestSortByRowAndColumnOffsetRange);
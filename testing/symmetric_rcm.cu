@@ -2,9 +2,15 @@
 
 #include <cusp/graph/symmetric_rcm.h>
 
+#include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
+#include <cusp/format_utils.h>
 #include <cusp/permutation_matrix.h>
 
+#include <cusp/gallery/poisson.h>
+
+#include <cstdlib>
+
 template <typename MatrixType, typename PermutationType>
 void symmetric_rcm(my_system& system, const MatrixType& G, PermutationType& P)
 {
@@ -28,3 +34,64 @@ void TestSymmetricRCMDispatch()
 }
 DECLARE_UNITTEST(TestSymmetricRCMDispatch);
 
+
+template <class MemorySpace>
+void TestSymmetricRCM(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> G;
+    cusp::gallery::poisson5pt(G, 30, 10);
+
+    cusp::coo_matrix<int, float, MemorySpace> A(G);
+    size_t bandwidth = cusp::compute_bandwidth(A.row_indices, A.column_indices);
+    size_t profile   = cusp::compute_profile(A.row_indices, A.column_indices);
+
+    cusp::permutation_matrix<int, MemorySpace> P(G.num_rows);
+    cusp::graph::symmetric_rcm(G, P);
+
+    // every vertex is assigned a distinct position
+    cusp::array1d<int, cusp::host_memory> positions(P.permutation);
+    cusp::array1d<int, cusp::host_memory> counts(G.num_rows, 0);
+    for(size_t i = 0; i < positions.size(); i++)
+        counts[positions[i]]++;
+    ASSERT_EQUAL(counts, cusp::array1d<int, cusp::host_memory>(G.num_rows, 1));
+
+    P.symmetric_permute(A);
+
+    ASSERT_EQUAL(cusp::compute_bandwidth(A.row_indices, A.column_indices) < bandwidth, true);
+    ASSERT_EQUAL(cusp::compute_profile(A.row_indices, A.column_indices) < profile, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSymmetricRCM);
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+void TestSymmetricRCMParallel(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> G;
+    cusp::gallery::poisson5pt(G, 30, 10);
+
+    cusp::csr_matrix<int, float, cusp::device_memory> G_d(G);
+
+    // both searches start from the same random vertex
+    cusp::permutation_matrix<int, cusp::host_memory> P(G.num_rows);
+    srand(7);
+    cusp::graph::symmetric_rcm(G, P);
+
+    cusp::permutation_matrix<int, cusp::device_memory> P_d(G.num_rows);
+    srand(7);
+    cusp::graph::symmetric_rcm(G_d, P_d);
+
+    cusp::permutation_matrix<int, cusp::host_memory> P_omp(P_d);
+
+    cusp::coo_matrix<int, float, cusp::host_memory> A(G);
+    cusp::coo_matrix<int, float, cusp::host_memory> A_omp(G);
+
+    P.symmetric_permute(A);
+    P_omp.symmetric_permute(A_omp);
+
+    // the OpenMP Cuthill-McKee order is at least as good as the level order
+    ASSERT_EQUAL(cusp::compute_bandwidth(A_omp.row_indices, A_omp.column_indices) <=
+                 cusp::compute_bandwidth(A.row_indices, A.column_indices), true);
+    ASSERT_EQUAL(cusp::compute_profile(A_omp.row_indices, A_omp.column_indices) <=
+                 cusp::compute_profile(A.row_indices, A.column_indices), true);
+}
+DECLARE_UNITTEST(TestSymmetricRCMParallel);
+#endif
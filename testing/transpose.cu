@@ -9,6 +9,8 @@
 #include <cusp/ell_matrix.h>
 #include <cusp/hyb_matrix.h>
 
+#include <cusp/gallery/random.h>
+
 template <typename MatrixType>
 void initialize_matrix(MatrixType& matrix)
 {
@@ -201,6 +203,39 @@ void TestTranspose(void)
 }
 DECLARE_MATRIX_UNITTEST(TestTranspose);
 
+template <class MemorySpace>
+void TestTransposeSortedRows(void)
+{
+    // enough entries for parallel transposes to split the work
+    cusp::coo_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::random(A, 300, 200, 4000);
+
+    cusp::array2d<float, cusp::host_memory> D(A);
+
+    {
+        cusp::csr_matrix<int, float, MemorySpace> _A(A), _At, _Att;
+        cusp::transpose(_A, _At);
+        cusp::transpose(_At, _Att);
+
+        cusp::csr_matrix<int, float, cusp::host_memory> At(_At);
+        for(size_t i = 0; i < At.num_rows; i++)
+            for(int jj = At.row_offsets[i] + 1; jj < At.row_offsets[i + 1]; jj++)
+                ASSERT_EQUAL(At.column_indices[jj - 1] < At.column_indices[jj], true);
+
+        ASSERT_EQUAL(D == cusp::array2d<float, cusp::host_memory>(_Att), true);
+    }
+
+    {
+        cusp::coo_matrix<int, float, MemorySpace> _A(A), _At, _Att;
+        cusp::transpose(_A, _At);
+        cusp::transpose(_At, _Att);
+
+        ASSERT_EQUAL(_At.is_sorted_by_row_and_column(), true);
+        ASSERT_EQUAL(D == cusp::array2d<float, cusp::host_memory>(_Att), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestTransposeSortedRows);
+
 template <typename MatrixType1, typename MatrixType2>
 void transpose(my_system& system, const MatrixType1& A, MatrixType2& At)
 {
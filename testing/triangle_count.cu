@@ -0,0 +1,71 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/triangle_count.h>
+
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/grid.h>
+#include <cusp/gallery/poisson.h>
+
+template <class MemorySpace>
+void TestTriangleCount(void)
+{
+    // the complete graph on five vertices has ten triangles
+    {
+        cusp::coo_matrix<int, float, cusp::host_memory> A(5, 5, 20);
+
+        int n = 0;
+        for(int i = 0; i < 5; i++)
+            for(int j = 0; j < 5; j++)
+                if(i != j)
+                {
+                    A.row_indices[n] = i; A.column_indices[n] = j; A.values[n] = 1; n++;
+                }
+
+        cusp::csr_matrix<int, float, MemorySpace> G(A);
+
+        ASSERT_EQUAL(cusp::graph::triangle_count(G), size_t(10));
+    }
+
+    // a 2D grid is bipartite and has no triangles
+    {
+        cusp::csr_matrix<int, float, MemorySpace> G;
+        cusp::gallery::grid2d(G, 6, 4);
+
+        ASSERT_EQUAL(cusp::graph::triangle_count(G), size_t(0));
+    }
+
+    // every square of the 9-point stencil holds four triangles, the
+    // diagonal entries are ignored
+    {
+        cusp::coo_matrix<int, float, MemorySpace> G;
+        cusp::gallery::poisson9pt(G, 6, 4);
+
+        ASSERT_EQUAL(cusp::graph::triangle_count(G), size_t(4 * 5 * 3));
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestTriangleCount);
+
+template <typename MatrixType>
+size_t triangle_count(my_system& system,
+                      const MatrixType& G)
+{
+    system.validate_dispatch();
+    return 0;
+}
+
+void TestTriangleCountDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::triangle_count(sys, A);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestTriangleCountDispatch);
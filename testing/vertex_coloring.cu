@@ -2,8 +2,112 @@
 
 #include <cusp/graph/vertex_coloring.h>
 
+#include <cusp/array2d.h>
 #include <cusp/csr_matrix.h>
 
+#include <cusp/gallery/poisson.h>
+
+template <typename MatrixType, typename ArrayType>
+bool is_valid_coloring(const MatrixType& G, const ArrayType& colors, const size_t num_colors)
+{
+    for(size_t i = 0; i < G.num_rows; i++)
+    {
+        if(size_t(colors[i]) >= num_colors)
+            return false;
+
+        for(int jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+        {
+            const size_t j = G.column_indices[jj];
+
+            if(i != j && colors[i] == colors[j])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename ArrayType>
+size_t largest_color_class(const ArrayType& colors, const size_t num_colors)
+{
+    cusp::array1d<size_t, cusp::host_memory> class_sizes(num_colors, 0);
+
+    for(size_t i = 0; i < colors.size(); i++)
+        class_sizes[colors[i]]++;
+
+    return *thrust::max_element(class_sizes.begin(), class_sizes.end());
+}
+
+// symmetric graph with a skewed first-fit coloring (127, 125, 85, 49, 14)
+template <typename MatrixType>
+void unbalanced_graph(MatrixType& A)
+{
+    const int N = 400;
+
+    cusp::array2d<float, cusp::host_memory> D(N, N, 0);
+
+    for(int i = 0; i < N; i++)
+    {
+        D(i, i) = 1;
+
+        for(int k = 1; k <= 3; k++)
+        {
+            const int j = (i * 37 + k * 101 + (i * i) % 97) % N;
+            D(i, j) = D(j, i) = 1;
+        }
+    }
+
+    A = D;
+}
+
+template <class MemorySpace>
+void TestVertexColoring(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson9pt(A, 40, 30);
+
+    cusp::csr_matrix<int, float, MemorySpace> G(A);
+    cusp::array1d<int, MemorySpace> colors(G.num_rows);
+
+    size_t num_colors = cusp::graph::vertex_coloring(G, colors);
+
+    cusp::array1d<int, cusp::host_memory> h_colors(colors);
+    ASSERT_EQUAL(is_valid_coloring(A, h_colors, num_colors), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestVertexColoring);
+
+template <class MemorySpace>
+void TestVertexColoringBalance(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    unbalanced_graph(A);
+
+    cusp::csr_matrix<int, float, MemorySpace> G(A);
+    cusp::array1d<int, MemorySpace> colors(G.num_rows);
+
+    size_t unbalanced_size;
+
+    {
+        size_t num_colors = cusp::graph::vertex_coloring(G, colors);
+
+        cusp::array1d<int, cusp::host_memory> h_colors(colors);
+        ASSERT_EQUAL(is_valid_coloring(A, h_colors, num_colors), true);
+
+        unbalanced_size = largest_color_class(h_colors, num_colors);
+    }
+
+    {
+        size_t num_colors = cusp::graph::vertex_coloring(G, colors, true);
+
+        cusp::array1d<int, cusp::host_memory> h_colors(colors);
+        ASSERT_EQUAL(is_valid_coloring(A, h_colors, num_colors), true);
+
+        size_t balanced_size = largest_color_class(h_colors, num_colors);
+        ASSERT_EQUAL(balanced_size < unbalanced_size, true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestVertexColoringBalance);
+
 template <typename MatrixType, typename ArrayType>
 size_t vertex_coloring(my_system& system, const MatrixType& G, ArrayType& colors)
 {